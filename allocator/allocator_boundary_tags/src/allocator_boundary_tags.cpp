@@ -8,7 +8,7 @@
 
 allocator_boundary_tags::~allocator_boundary_tags()
 {
-    trace_with_guard(get_typename() + "::~allocator_boundary_tags() : called.");
+    trace_with_guard([&]() { return get_typename() + "::~allocator_boundary_tags() : called."; });
     
     logger* logger = get_logger();
     
@@ -25,17 +25,17 @@ allocator_boundary_tags::allocator_boundary_tags(
     allocator_boundary_tags &&other) noexcept:
     _trusted_memory(other._trusted_memory)
 {
-    trace_with_guard(get_typename() + "::allocator_boundary_tags(allocator_boundary_tags &&) : called.");
+    trace_with_guard([&]() { return get_typename() + "::allocator_boundary_tags(allocator_boundary_tags &&) : called."; });
     
     other._trusted_memory = nullptr;
     
-    trace_with_guard(get_typename() + "::allocator_boundary_tags(allocator_boundary_tags &&) : successfuly finished.");
+    trace_with_guard([&]() { return get_typename() + "::allocator_boundary_tags(allocator_boundary_tags &&) : successfuly finished."; });
 }
 
 allocator_boundary_tags &allocator_boundary_tags::operator=(
     allocator_boundary_tags &&other) noexcept
 {
-    trace_with_guard(get_typename() + "::operator=(allocator_boundary_tags &&) : called.");
+    trace_with_guard([&]() { return get_typename() + "::operator=(allocator_boundary_tags &&) : called."; });
     
     if (this != &other)
     {
@@ -46,7 +46,7 @@ allocator_boundary_tags &allocator_boundary_tags::operator=(
         other._trusted_memory = nullptr;
     }
     
-    trace_with_guard(get_typename() + "::operator=(allocator_boundary_tags &&) : successfuly finished.");
+    trace_with_guard([&]() { return get_typename() + "::operator=(allocator_boundary_tags &&) : successfuly finished."; });
     
     return *this;
 }
@@ -110,7 +110,7 @@ allocator_boundary_tags::allocator_boundary_tags(
     
     *reinterpret_cast<block_pointer_t*>(ptr) = nullptr;
     
-    trace_with_guard(get_typename() + "::allocator_boundary_tags(size_t, allocator *, logger *, fit_mode) : successfuly finished.");
+    trace_with_guard([&]() { return get_typename() + "::allocator_boundary_tags(size_t, allocator *, logger *, fit_mode) : successfuly finished."; });
 }
 
 
@@ -120,9 +120,9 @@ allocator_boundary_tags::allocator_boundary_tags(
     size_t values_count)
 {
     std::lock_guard<std::mutex> guard(get_mutex());
-    trace_with_guard(get_typename() + "::allocate(size_t, size_t) : called.")
-        ->debug_with_guard(get_typename() + "::allocate(size_t, size_t) was called (value_size = " +
-            std::to_string(value_size) + ", values_count = " + std::to_string(values_count) + ").");
+    trace_with_guard([&]() { return get_typename() + "::allocate(size_t, size_t) : called."; })
+        ->debug_with_guard([&]() { return get_typename() + "::allocate(size_t, size_t) was called (value_size = " +
+            std::to_string(value_size) + ", values_count = " + std::to_string(values_count) + ")."; });
     
     block_size_t req_size = value_size * values_count;
     block_size_t cmn_size = req_size + get_block_meta_size();
@@ -184,15 +184,15 @@ allocator_boundary_tags::allocator_boundary_tags(
     
     if (target_block == nullptr)
     {
-        error_with_guard(get_typename() + "::allocate(size_t, size_t) : no space to allocate requested " +
-                std::to_string(req_size) + " bytes.");
+        error_with_guard([&]() { return get_typename() + "::allocate(size_t, size_t) : no space to allocate requested " +
+                std::to_string(req_size) + " bytes."; });
         throw std::bad_alloc();
     }
     
     if (target_size - cmn_size < get_block_meta_size())
     {
-        warning_with_guard(get_typename() + "::allocate(size_t, size_t) : request of " + std::to_string(req_size) +
-                " bytes was enlarged to " + std::to_string(target_size - get_block_meta_size()) + " bytes.");
+        warning_with_guard([&]() { return get_typename() + "::allocate(size_t, size_t) : request of " + std::to_string(req_size) +
+                " bytes was enlarged to " + std::to_string(target_size - get_block_meta_size()) + " bytes."; });
         req_size = target_size - get_block_meta_size();
         cmn_size = target_size;
     }
@@ -225,13 +225,13 @@ allocator_boundary_tags::allocator_boundary_tags(
     
     get_allctr_avail_size() -= cmn_size;
     
-    debug_with_guard(get_typename() + "::allocate(size_t, size_t) : allocated " + std::to_string(req_size) +
-            "(+" + std::to_string(get_block_meta_size()) + ") bytes.");
+    debug_with_guard([&]() { return get_typename() + "::allocate(size_t, size_t) : allocated " + std::to_string(req_size) +
+            "(+" + std::to_string(get_block_meta_size()) + ") bytes."; });
     debug_blocks_info(get_typename() + "::allocate(size_t, size_t)");
-    information_with_guard(get_typename() + "::allocate(size_t, size_t) : available size is " +
-            std::to_string(get_allctr_avail_size()) + " bytes.")
-        ->trace_with_guard(get_typename() + "::allocate(size_t, size_t) : successfuly finished.")
-        ->debug_with_guard(get_typename() + "::allocate(size_t, size_t) : successfuly finished.");
+    information_with_guard([&]() { return get_typename() + "::allocate(size_t, size_t) : available size is " +
+            std::to_string(get_allctr_avail_size()) + " bytes."; })
+        ->trace_with_guard([&]() { return get_typename() + "::allocate(size_t, size_t) : successfuly finished."; })
+        ->debug_with_guard([&]() { return get_typename() + "::allocate(size_t, size_t) : successfuly finished."; });
     
     return target_block;
 }
@@ -240,8 +240,8 @@ void allocator_boundary_tags::deallocate(
     void *at)
 {
     std::lock_guard<std::mutex> guard(get_mutex());
-    trace_with_guard(get_typename() + "::deallocate(void *) : called.")
-        ->debug_with_guard(get_typename() + "::deallocate(void *) : called.");
+    trace_with_guard([&]() { return get_typename() + "::deallocate(void *) : called."; })
+        ->debug_with_guard([&]() { return get_typename() + "::deallocate(void *) : called."; });
     
     if (at == nullptr)
     {
@@ -255,7 +255,7 @@ void allocator_boundary_tags::deallocate(
     
     if (at < mem_begin || at >= mem_end || get_block_allctr(at) != this)
     {
-        error_with_guard(get_typename() + "::deallocate(void *) : tried to deallocate non-related memory.");        
+        error_with_guard([&]() { return get_typename() + "::deallocate(void *) : tried to deallocate non-related memory."; });        
         throw std::logic_error("try of deallocation non-related memory");
     }
     
@@ -280,14 +280,14 @@ void allocator_boundary_tags::deallocate(
     
     get_allctr_avail_size() += get_block_meta_size() + size;
     
-    debug_with_guard(get_typename() + "::deallocate(void *) : deallocated " + std::to_string(size)
+    debug_with_guard([&]() { return get_typename() + "::deallocate(void *) : deallocated " + std::to_string(size)
             + "(+" + std::to_string(get_block_meta_size()) + ") bytes" + (!dump.size() ?
-            "" : " with data " + dump) + ".");
+            "" : " with data " + dump) + "."; });
     debug_blocks_info(get_typename() + "::deallocate(void *)");
-    information_with_guard(get_typename() + "::deallocate(void *) : available size is " +
-            std::to_string(get_allctr_avail_size()) + " bytes.")
-        ->trace_with_guard(get_typename() + "::deallocate(void *) : successfuly finished.")
-        ->debug_with_guard(get_typename() + "::deallocate(void *) : successfuly finished.");
+    information_with_guard([&]() { return get_typename() + "::deallocate(void *) : available size is " +
+            std::to_string(get_allctr_avail_size()) + " bytes."; })
+        ->trace_with_guard([&]() { return get_typename() + "::deallocate(void *) : successfuly finished."; })
+        ->debug_with_guard([&]() { return get_typename() + "::deallocate(void *) : successfuly finished."; });
 }
 
 inline void allocator_boundary_tags::set_fit_mode(
@@ -299,11 +299,11 @@ inline void allocator_boundary_tags::set_fit_mode(
 std::vector<allocator_test_utils::block_info> allocator_boundary_tags::get_blocks_info() const noexcept
 {
     std::lock_guard<std::mutex> guard(get_mutex());
-    trace_with_guard(get_typename() + "::get_blocks_info() : called.");
+    trace_with_guard([&]() { return get_typename() + "::get_blocks_info() : called."; });
     
     auto blocks_info = create_blocks_info();
     
-    trace_with_guard(get_typename() + "::get_blocks_info() : successfuly finished.");
+    trace_with_guard([&]() { return get_typename() + "::get_blocks_info() : successfuly finished."; });
     
     return blocks_info;
 }
@@ -312,7 +312,7 @@ std::vector<allocator_test_utils::block_info> allocator_boundary_tags::get_block
 
 std::vector<allocator_test_utils::block_info> allocator_boundary_tags::create_blocks_info() const noexcept
 {
-    trace_with_guard(get_typename() + "::get_blocks_info() : called.");
+    trace_with_guard([&]() { return get_typename() + "::get_blocks_info() : called."; });
     
     std::vector<allocator_test_utils::block_info> blocks_state(0);
     
@@ -377,7 +377,7 @@ void allocator_boundary_tags::debug_blocks_info(std::string call_function_name)
         }
     }
     
-    debug_with_guard(call_function_name + " : memory map: |" + str_stream.str() + ".");
+    debug_with_guard([&]() { return call_function_name + " : memory map: |" + str_stream.str() + "."; });
 }
 
 
@@ -8,12 +8,12 @@ allocator_buddies_system::~allocator_buddies_system()
 {
     if (get_logger() != nullptr)
     {
-        trace_with_guard(get_typename() + "::~allocator_buddies_system() was called");
+        trace_with_guard([&]() { return get_typename() + "::~allocator_buddies_system() was called"; });
     }
     get_mutex().~mutex();
     if (get_logger() != nullptr)
     {
-        trace_with_guard(get_typename() + "::~allocator_buddies_system() finished");
+        trace_with_guard([&]() { return get_typename() + "::~allocator_buddies_system() finished"; });
     }
     deallocate_with_guard(_trusted_memory);
 }
@@ -21,15 +21,15 @@ allocator_buddies_system::~allocator_buddies_system()
 allocator_buddies_system::allocator_buddies_system(
         allocator_buddies_system &&other) noexcept : _trusted_memory(other._trusted_memory)
 {
-    trace_with_guard(get_typename() + "::allocator_buddies_system(allocator_buddies_system &&other) was called");
+    trace_with_guard([&]() { return get_typename() + "::allocator_buddies_system(allocator_buddies_system &&other) was called"; });
     other._trusted_memory = nullptr;
-    trace_with_guard(get_typename() + "::allocator_buddies_system(allocator_buddies_system &&other) finished");
+    trace_with_guard([&]() { return get_typename() + "::allocator_buddies_system(allocator_buddies_system &&other) finished"; });
 }
 
 allocator_buddies_system &allocator_buddies_system::operator=(
         allocator_buddies_system &&other) noexcept
 {
-    trace_with_guard(get_typename() + "operator=(allocator_buddies_system &&other) was called");
+    trace_with_guard([&]() { return get_typename() + "operator=(allocator_buddies_system &&other) was called"; });
     if (this == &other)
     {
         return *this;
@@ -38,7 +38,7 @@ allocator_buddies_system &allocator_buddies_system::operator=(
     deallocate_with_guard(_trusted_memory);
     _trusted_memory = other._trusted_memory;
     other._trusted_memory = nullptr;
-    trace_with_guard(get_typename() + "operator=(allocator_buddies_system &&other) finished");
+    trace_with_guard([&]() { return get_typename() + "operator=(allocator_buddies_system &&other) finished"; });
     return *this;
 }
 
@@ -106,7 +106,7 @@ allocator_buddies_system::allocator_buddies_system(
 
     *reinterpret_cast<block_pointer_t*>(temp_pointer) = nullptr;
 
-    trace_with_guard(get_typename() + "::allocator_buddies_system (size_t space_size, allocator *parent_allocator, logger *logger, allocator_with_fit_mode::fit_mode allocate_fit_mode) finished");
+    trace_with_guard([&]() { return get_typename() + "::allocator_buddies_system (size_t space_size, allocator *parent_allocator, logger *logger, allocator_with_fit_mode::fit_mode allocate_fit_mode) finished"; });
 }
 
 [[nodiscard]] void *allocator_buddies_system::allocate(
@@ -114,7 +114,7 @@ allocator_buddies_system::allocator_buddies_system(
         size_t values_count)
 {
     std::lock_guard<std::mutex> guard(get_mutex());
-    debug_with_guard(get_typename() + "::allocate(size_t value_size, size_t values_count) was called");
+    debug_with_guard([&]() { return get_typename() + "::allocate(size_t value_size, size_t values_count) was called"; });
 
     block_size_t requested_size = value_size * values_count;
     block_size_t block_meta_size = get_available_block_meta_size();
@@ -162,7 +162,7 @@ allocator_buddies_system::allocator_buddies_system(
     }
     if (target_block == nullptr)
     {
-        error_with_guard(get_typename() + "There is no space to allocate memory to allocate" + std::to_string(requested_size) + "bytes");
+        error_with_guard([&]() { return get_typename() + "There is no space to allocate memory to allocate" + std::to_string(requested_size) + "bytes"; });
         throw std::bad_alloc();
     }
     block_pointer_t buddy = nullptr;
@@ -202,9 +202,9 @@ allocator_buddies_system::allocator_buddies_system(
     get_allocator_available_size() -= 1 << target_size;
 
 
-    debug_with_guard(get_typename() + "::allocate(size_t value_size, size_t values_count) allocated: " + std::to_string(1 << target_size) + " bytes.");
+    debug_with_guard([&]() { return get_typename() + "::allocate(size_t value_size, size_t values_count) allocated: " + std::to_string(1 << target_size) + " bytes."; });
 
-    debug_with_guard(get_typename() + "::allocate(size_t value_size, size_t values_count) was finished");
+    debug_with_guard([&]() { return get_typename() + "::allocate(size_t value_size, size_t values_count) was finished"; });
     return reinterpret_cast<unsigned char*>(target_block) + get_occupied_block_meta_size();
 }
 
@@ -212,7 +212,7 @@ allocator_buddies_system::allocator_buddies_system(
 void allocator_buddies_system::deallocate(
         void *at)
 {
-    trace_with_guard(get_typename() + "::deallocate(void *at) was called");
+    trace_with_guard([&]() { return get_typename() + "::deallocate(void *at) was called"; });
     std::lock_guard<std::mutex> guard(get_mutex());
 
     if (at == nullptr)
@@ -224,7 +224,7 @@ void allocator_buddies_system::deallocate(
 
     if (at_allocator != this || !belong_trusted_memory(at))
     {
-        error_with_guard(get_typename() + "::deallocate(void *at) trying to deallocate non-related memory");
+        error_with_guard([&]() { return get_typename() + "::deallocate(void *at) trying to deallocate non-related memory"; });
         throw std::logic_error(get_typename() + "::deallocate(void *at) trying to deallocate non-related memory");
     }
 
@@ -266,8 +266,8 @@ void allocator_buddies_system::deallocate(
         curr_size = get_block_data_size(temp_pointer) + 1;
         set_block_size(temp_pointer) = curr_size;
     }
-    information_with_guard(get_typename() + "::deallocate(void *) : available size is " +
-                           std::to_string(get_allocator_available_size()) + " bytes.");
+    information_with_guard([&]() { return get_typename() + "::deallocate(void *) : available size is " +
+                           std::to_string(get_allocator_available_size()) + " bytes."; });
     get_allocator_available_size() += exempted_size;
     at = reinterpret_cast<unsigned char*>(at) + get_available_block_meta_size();
     std::ostringstream out_stream(exempted_size > 0 ? " with data:" : "", std::ios::ate);
@@ -279,14 +279,14 @@ void allocator_buddies_system::deallocate(
                 *reinterpret_cast<unsigned char*>(at) + i);
     }
 
-    debug_with_guard(get_typename() + "::deallocate(void *) : deallocated " + std::to_string(exempted_size)
-                     + "(+" + std::to_string(get_occupied_block_meta_size()) + ") bytes" + out_stream.str() + ".");
+    debug_with_guard([&]() { return get_typename() + "::deallocate(void *) : deallocated " + std::to_string(exempted_size)
+                     + "(+" + std::to_string(get_occupied_block_meta_size()) + ") bytes" + out_stream.str() + "."; });
     log_blocks_info(get_typename() + "::deallocate(void *)");
-    information_with_guard(get_typename() + "::deallocate(void *) : available size is " +
-                           std::to_string(get_allocator_available_size()) + " bytes.")->
-            trace_with_guard(get_typename() + "::deallocate(void *) : finished.")->
-            debug_with_guard(get_typename() + "::deallocate(void *) : finished.")->
-            trace_with_guard(get_typename() + "::deallocate(void *at) finished");
+    information_with_guard([&]() { return get_typename() + "::deallocate(void *) : available size is " +
+                           std::to_string(get_allocator_available_size()) + " bytes."; })->
+            trace_with_guard([&]() { return get_typename() + "::deallocate(void *) : finished."; })->
+            debug_with_guard([&]() { return get_typename() + "::deallocate(void *) : finished."; })->
+            trace_with_guard([&]() { return get_typename() + "::deallocate(void *at) finished"; });
 }
 
 inline void allocator_buddies_system::set_fit_mode(
@@ -305,9 +305,9 @@ inline allocator *allocator_buddies_system::get_allocator() const
 std::vector<allocator_test_utils::block_info> allocator_buddies_system::get_blocks_info() const noexcept
 {
     std::lock_guard<std::mutex> mutex (get_mutex());
-    trace_with_guard(get_typename() + "::get_blocks_info() was called");
+    trace_with_guard([&]() { return get_typename() + "::get_blocks_info() was called"; });
     std::vector<allocator_test_utils::block_info> blocks_info = create_blocks_info();
-    trace_with_guard(get_typename() + "::get_blocks_info() finished");
+    trace_with_guard([&]() { return get_typename() + "::get_blocks_info() finished"; });
     return blocks_info;
 }
 
@@ -343,7 +343,7 @@ inline allocator::block_size_t allocator_buddies_system::get_allocator_meta_size
 
 std::vector<allocator_test_utils::block_info> allocator_buddies_system::create_blocks_info() const noexcept
 {
-    trace_with_guard(get_typename() + "::create_blocks_info() was called");
+    trace_with_guard([&]() { return get_typename() + "::create_blocks_info() was called"; });
     std::vector<allocator_test_utils::block_info> blocks_info(0);
     block_pointer_t curr_block = reinterpret_cast<unsigned char*>(_trusted_memory) + get_allocator_meta_size();
     bool is_occupied;
@@ -357,7 +357,7 @@ std::vector<allocator_test_utils::block_info> allocator_buddies_system::create_b
         blocks_info.push_back({.block_size = block_size, .is_block_occupied = is_occupied});
         curr_block = reinterpret_cast<unsigned char*>(curr_block) + block_size;
     }
-    trace_with_guard(get_typename() + "::create_blocks_info() finished");
+    trace_with_guard([&]() { return get_typename() + "::create_blocks_info() finished"; });
     return blocks_info;
 
 }
@@ -478,5 +478,5 @@ void allocator_buddies_system::log_blocks_info(const std::string& func_name) con
             out_string << "available " << data.block_size << "|";
         }
     }
-    debug_with_guard(func_name + " memory status: |" + out_string.str());
+    debug_with_guard([&]() { return func_name + " memory status: |" + out_string.str(); });
 }
\ No newline at end of file
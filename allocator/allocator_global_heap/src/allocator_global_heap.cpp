@@ -10,31 +10,31 @@ allocator_global_heap::allocator_global_heap(
     logger *logger):
     _logger(logger)
 {
-    trace_with_guard(get_typename() + "::allocator_global_heap(logger *) : called.");
+    trace_with_guard([&]() { return get_typename() + "::allocator_global_heap(logger *) : called."; });
     
-    trace_with_guard(get_typename() + "::allocator_global_heap(logger *) : successfuly finished.");
+    trace_with_guard([&]() { return get_typename() + "::allocator_global_heap(logger *) : successfuly finished."; });
 }
 
 allocator_global_heap::~allocator_global_heap()
 {
-    trace_with_guard(get_typename() + "::~allocator_global_heap() : called.");
+    trace_with_guard([&]() { return get_typename() + "::~allocator_global_heap() : called."; });
     
-    trace_with_guard(get_typename() + "::~allocator_global_heap() : successfuly finished.");
+    trace_with_guard([&]() { return get_typename() + "::~allocator_global_heap() : successfuly finished."; });
 }
 
 allocator_global_heap::allocator_global_heap(
     allocator_global_heap &&other) noexcept:
     _logger(other._logger)
 {
-    trace_with_guard(get_typename() + "::allocator_global_heap(allocator_global_heap &&) : called.");
+    trace_with_guard([&]() { return get_typename() + "::allocator_global_heap(allocator_global_heap &&) : called."; });
     
-    trace_with_guard(get_typename() + "::allocator_global_heap(allocator_global_heap &&) : successfuly finished.");
+    trace_with_guard([&]() { return get_typename() + "::allocator_global_heap(allocator_global_heap &&) : successfuly finished."; });
 }
 
 allocator_global_heap &allocator_global_heap::operator=(
     allocator_global_heap &&other) noexcept
 {
-    trace_with_guard(get_typename() + "::operator=(allocator_global_heap &&) : called.");
+    trace_with_guard([&]() { return get_typename() + "::operator=(allocator_global_heap &&) : called."; });
     
     if (this != &other)
     {
@@ -42,7 +42,7 @@ allocator_global_heap &allocator_global_heap::operator=(
         other._logger = nullptr;
     }
     
-    trace_with_guard(get_typename() + "::operator=(allocator_global_heap &&) : successfuly finished.");
+    trace_with_guard([&]() { return get_typename() + "::operator=(allocator_global_heap &&) : successfuly finished."; });
     
     return *this;
 }
@@ -51,9 +51,9 @@ allocator_global_heap &allocator_global_heap::operator=(
     size_t value_size,
     size_t values_count)
 {
-    trace_with_guard(get_typename() + "::allocate(size_t, size_t) : called.")
-        ->debug_with_guard(get_typename() + "::allocate(size_t, size_t) : called. (value size = " +
-            std::to_string(value_size) + "; count = " + std::to_string(values_count) + ").");
+    trace_with_guard([&]() { return get_typename() + "::allocate(size_t, size_t) : called."; })
+        ->debug_with_guard([&]() { return get_typename() + "::allocate(size_t, size_t) : called. (value size = " +
+            std::to_string(value_size) + "; count = " + std::to_string(values_count) + ")."; });
     
     unsigned char *ptr = nullptr;
     size_t size = value_size * values_count;
@@ -65,16 +65,16 @@ allocator_global_heap &allocator_global_heap::operator=(
     }
     catch(std::bad_alloc const &)
     {
-        error_with_guard(get_typename() + "::allocate(size_t, size_t) : " +
-                "bad alloc occurred while trying to allocate " + std::to_string(size) + " bytes.");
+        error_with_guard([&]() { return get_typename() + "::allocate(size_t, size_t) : " +
+                "bad alloc occurred while trying to allocate " + std::to_string(size) + " bytes."; });
         throw;
     }
     
     *reinterpret_cast<allocator_global_heap**>(ptr) = this;
     *reinterpret_cast<size_t*>(ptr + sizeof(allocator_global_heap*)) = size;
     
-    trace_with_guard(get_typename() + "::allocate(size_t, size_t) : successfuly finished.")
-        ->debug_with_guard(get_typename() + "::allocate(size_t, size_t) : successfuly finished.");
+    trace_with_guard([&]() { return get_typename() + "::allocate(size_t, size_t) : successfuly finished."; })
+        ->debug_with_guard([&]() { return get_typename() + "::allocate(size_t, size_t) : successfuly finished."; });
     
     return reinterpret_cast<void*>(ptr + sizeof(allocator_global_heap*) + sizeof(size_t));
 }
@@ -82,8 +82,8 @@ allocator_global_heap &allocator_global_heap::operator=(
 void allocator_global_heap::deallocate(
     void *at)
 {
-    trace_with_guard(get_typename() + "::deallocate(void *) : called.")
-        ->debug_with_guard(get_typename() + "::deallocate(void *) : called.");
+    trace_with_guard([&]() { return get_typename() + "::deallocate(void *) : called."; })
+        ->debug_with_guard([&]() { return get_typename() + "::deallocate(void *) : called."; });
     
     auto ptr = reinterpret_cast<unsigned char*>(at);
     
@@ -95,7 +95,7 @@ void allocator_global_heap::deallocate(
     
     if (allctr_ptr != this)
     {
-        error_with_guard(get_typename() + "::deallocate(void *) : tried to deallocate non-related memory.");
+        error_with_guard([&]() { return get_typename() + "::deallocate(void *) : tried to deallocate non-related memory."; });
         throw std::logic_error("try of deallocation non-related memory");
     }
     
@@ -103,10 +103,10 @@ void allocator_global_heap::deallocate(
     
     ::operator delete(ptr);
     
-    debug_with_guard(get_typename() + "::deallocate(void *): deallocated " +
-            std::to_string(size) + " bytes" + (!dump.size() ? "" : " with data " + dump) + ".")
-        ->trace_with_guard(get_typename() + "::deallocate(void *) : successfuly finished.")
-        ->debug_with_guard(get_typename() + "::deallocate(void *) : successfuly finished.");
+    debug_with_guard([&]() { return get_typename() + "::deallocate(void *): deallocated " +
+            std::to_string(size) + " bytes" + (!dump.size() ? "" : " with data " + dump) + "."; })
+        ->trace_with_guard([&]() { return get_typename() + "::deallocate(void *) : successfuly finished."; })
+        ->debug_with_guard([&]() { return get_typename() + "::deallocate(void *) : successfuly finished."; });
 }
 
 inline logger *allocator_global_heap::get_logger() const
@@ -6,12 +6,12 @@ allocator_red_black_tree::~allocator_red_black_tree()
 {
     if (get_logger() != nullptr)
     {
-        trace_with_guard(get_typename() + "::~allocator_buddies_system() was called"); // TODO delete
+        trace_with_guard([&]() { return get_typename() + "::~allocator_buddies_system() was called"; }); // TODO delete
     }
     get_mutex().~mutex();
     if (get_logger() != nullptr)
     {
-        trace_with_guard(get_typename() + "::~allocator_buddies_system() finished"); // TODO delete
+        trace_with_guard([&]() { return get_typename() + "::~allocator_buddies_system() finished"; }); // TODO delete
     }
     deallocate_with_guard(_trusted_memory);
 }
@@ -96,7 +96,7 @@ allocator_red_black_tree::allocator_red_black_tree(
 
     *reinterpret_cast<block_pointer_t*>(temp_pointer) = nullptr; //right;
 
-    trace_with_guard(get_typename() + "::allocator_buddies_system (size_t space_size, allocator *parent_allocator, logger *logger, allocator_with_fit_mode::fit_mode allocate_fit_mode) finished"); // TODO delete
+    trace_with_guard([&]() { return get_typename() + "::allocator_buddies_system (size_t space_size, allocator *parent_allocator, logger *logger, allocator_with_fit_mode::fit_mode allocate_fit_mode) finished"; }); // TODO delete
 }
 
 //allocator_red_black_tree::allocator_red_black_tree(
@@ -807,7 +807,7 @@ void allocator_red_black_tree::deallocate(
 
     if (at < mem_begin || at >= mem_end)
     {
-        error_with_guard(get_typename() + "::deallocate(void *at) trying to deallocate non-related memory");
+        error_with_guard([&]() { return get_typename() + "::deallocate(void *at) trying to deallocate non-related memory"; });
         throw std::logic_error(get_typename() + "::deallocate(void *at) trying to deallocate non-related memory");
     }
     block_pointer_t block = reinterpret_cast<unsigned char*>(at) - get_occupied_block_meta_size();
@@ -6,7 +6,7 @@
 
 allocator_sorted_list::~allocator_sorted_list()
 {
-    trace_with_guard(get_typename() + "::~allocator_sorted_list() called");
+    trace_with_guard([&]() { return get_typename() + "::~allocator_sorted_list() called"; });
 
     logger *logger = get_logger();
     get_mutex().~mutex();
@@ -23,17 +23,17 @@ allocator_sorted_list::allocator_sorted_list(
         allocator_sorted_list &&other) noexcept:
         _trusted_memory(other._trusted_memory)
 {
-    trace_with_guard(get_typename() + "::allocator_sorted_list(allocator_sorted_list &&) called");
+    trace_with_guard([&]() { return get_typename() + "::allocator_sorted_list(allocator_sorted_list &&) called"; });
 
     other._trusted_memory = nullptr;
 
-    trace_with_guard(get_typename() + "::allocator_sorted_list(allocator_sorted_list &&) finished");
+    trace_with_guard([&]() { return get_typename() + "::allocator_sorted_list(allocator_sorted_list &&) finished"; });
 }
 
 allocator_sorted_list &allocator_sorted_list::operator=(
         allocator_sorted_list &&other) noexcept
 {
-    trace_with_guard(get_typename() + "::allocator_sorted_list &operator=(allocator_sorted_list &&) called");
+    trace_with_guard([&]() { return get_typename() + "::allocator_sorted_list &operator=(allocator_sorted_list &&) called"; });
 
     if (this != &other)
     {
@@ -44,7 +44,7 @@ allocator_sorted_list &allocator_sorted_list::operator=(
         other._trusted_memory = nullptr;
     }
 
-    trace_with_guard(get_typename() + "::allocator_sorted_list &operator=(allocator_sorted_list &&) finished");
+    trace_with_guard([&]() { return get_typename() + "::allocator_sorted_list &operator=(allocator_sorted_list &&) finished"; });
 
     return *this;
 }
@@ -126,16 +126,16 @@ allocator_sorted_list::allocator_sorted_list(
 
     *reinterpret_cast<block_pointer_t*>(block_ptr) = nullptr; // next
 
-    trace_with_guard(get_typename() + "::allocator_sorted_list(size_t, allocator *, logger *, fit_mode) finished");
+    trace_with_guard([&]() { return get_typename() + "::allocator_sorted_list(size_t, allocator *, logger *, fit_mode) finished"; });
 }
 
 [[nodiscard]] void *allocator_sorted_list::allocate(
         size_t value_size,
         size_t values_count)
 {
-    trace_with_guard(get_typename() + "::allocate(size_t, size_t) called")->
-            debug_with_guard(get_typename() + "::allocate(size_t, size_t) called (value_size = " +
-                             std::to_string(value_size) + ", value_count = " + std::to_string(values_count) + ")");
+    trace_with_guard([&]() { return get_typename() + "::allocate(size_t, size_t) called"; })->
+            debug_with_guard([&]() { return get_typename() + "::allocate(size_t, size_t) called (value_size = " +
+                             std::to_string(value_size) + ", value_count = " + std::to_string(values_count) + ")"; });
 
     std::lock_guard<std::mutex> lock (get_mutex());
 
@@ -153,7 +153,7 @@ allocator_sorted_list::allocator_sorted_list(
 
     if (cur_block == nullptr)
     {
-        error_with_guard(get_typename() + "::allocate(size_t, size_t): no space");
+        error_with_guard([&]() { return get_typename() + "::allocate(size_t, size_t): no space"; });
 
         throw std::bad_alloc();
     }
@@ -189,8 +189,8 @@ allocator_sorted_list::allocator_sorted_list(
 
     if (target_block == nullptr)
     {
-        error_with_guard(get_typename() + "::allocate(size_t, size_t): no space to allocate requested " +
-                         std::to_string(req_size) + " bytes");
+        error_with_guard([&]() { return get_typename() + "::allocate(size_t, size_t): no space to allocate requested " +
+                         std::to_string(req_size) + " bytes"; });
 
         throw std::bad_alloc();
     }
@@ -201,8 +201,8 @@ allocator_sorted_list::allocator_sorted_list(
 
         block_size = target_size;
 
-        warning_with_guard(get_typename() + "::allocate(size_t, size_t): block size has been increased to " +
-                           std::to_string(block_size) + " bytes");
+        warning_with_guard([&]() { return get_typename() + "::allocate(size_t, size_t): block size has been increased to " +
+                           std::to_string(block_size) + " bytes"; });
     }
     else
     {
@@ -227,13 +227,13 @@ allocator_sorted_list::allocator_sorted_list(
 
     get_free_space() -= block_size;
 
-    debug_with_guard(get_typename() + "::allocate(size_t, size_t) : allocated " + std::to_string(req_size) +
-                     "(+ meta: " + std::to_string(get_block_meta_size()) + ") bytes");
+    debug_with_guard([&]() { return get_typename() + "::allocate(size_t, size_t) : allocated " + std::to_string(req_size) +
+                     "(+ meta: " + std::to_string(get_block_meta_size()) + ") bytes"; });
     debug_blocks_info(get_typename() + "::allocate(size_t, size_t)");
-    information_with_guard(get_typename() + "::allocate(size_t, size_t) free space left: " +
-                           std::to_string(get_free_space()) + " bytes")->
-            trace_with_guard(get_typename() + "::allocate(size_t, size_t) finished")->
-            debug_with_guard(get_typename() + "::allocate(size_t, size_t) finished");
+    information_with_guard([&]() { return get_typename() + "::allocate(size_t, size_t) free space left: " +
+                           std::to_string(get_free_space()) + " bytes"; })->
+            trace_with_guard([&]() { return get_typename() + "::allocate(size_t, size_t) finished"; })->
+            debug_with_guard([&]() { return get_typename() + "::allocate(size_t, size_t) finished"; });
 
     return reinterpret_cast<allocator_sorted_list*>(
             reinterpret_cast<unsigned char *>(target_block) + get_occupied_meta_size());
@@ -242,8 +242,8 @@ allocator_sorted_list::allocator_sorted_list(
 void allocator_sorted_list::deallocate(
         void *at)
 {
-    trace_with_guard(get_typename() + "::deallocate(void *) called")
-            ->debug_with_guard(get_typename() + "::deallocate(void *) called");
+    trace_with_guard([&]() { return get_typename() + "::deallocate(void *) called"; })
+            ->debug_with_guard([&]() { return get_typename() + "::deallocate(void *) called"; });
 
     std::lock_guard<std::mutex> lock (get_mutex());
 
@@ -259,7 +259,7 @@ void allocator_sorted_list::deallocate(
 
     if (at < begin || at >= end || get_block_allocator(at_begin) != this)
     {
-        error_with_guard(get_typename() + "::deallocate(void *) tried to deallocate non-related memory");
+        error_with_guard([&]() { return get_typename() + "::deallocate(void *) tried to deallocate non-related memory"; });
         throw std::logic_error("try of deallocation non-related memory");
     }
 
@@ -313,13 +313,13 @@ void allocator_sorted_list::deallocate(
 
     std::string dump = get_block_dump(at, size);
 
-    debug_with_guard(get_typename() + "::deallocate(void *) deallocated " + std::to_string(size)
-                     + "(+ meta: " + std::to_string(get_block_meta_size()) + ") bytes" + dump);
+    debug_with_guard([&]() { return get_typename() + "::deallocate(void *) deallocated " + std::to_string(size)
+                     + "(+ meta: " + std::to_string(get_block_meta_size()) + ") bytes" + dump; });
     debug_blocks_info(get_typename() + "::deallocate(void *)");
-    information_with_guard(get_typename() + "::deallocate(void *) free space left: " +
-                           std::to_string(get_free_space()) + " bytes.")->
-            trace_with_guard(get_typename() + "::deallocate(void *) finished")->
-            debug_with_guard(get_typename() + "::deallocate(void *) finished");
+    information_with_guard([&]() { return get_typename() + "::deallocate(void *) free space left: " +
+                           std::to_string(get_free_space()) + " bytes."; })->
+            trace_with_guard([&]() { return get_typename() + "::deallocate(void *) finished"; })->
+            debug_with_guard([&]() { return get_typename() + "::deallocate(void *) finished"; });
 }
 
 inline void allocator_sorted_list::set_fit_mode(
@@ -330,13 +330,13 @@ inline void allocator_sorted_list::set_fit_mode(
 
 std::vector<allocator_test_utils::block_info> allocator_sorted_list::get_blocks_info() const noexcept
 {
-    trace_with_guard(get_typename() + "::get_blocks_info() called");
+    trace_with_guard([&]() { return get_typename() + "::get_blocks_info() called"; });
 
     std::lock_guard<std::mutex> lock (get_mutex());
 
     auto blocks = create_blocks_info();
 
-    trace_with_guard(get_typename() + "::get_blocks_info() finished");
+    trace_with_guard([&]() { return get_typename() + "::get_blocks_info() finished"; });
 
     return blocks;
 }
@@ -411,7 +411,7 @@ void allocator_sorted_list::debug_blocks_info(std::string call_function_name) co
         }
     }
 
-    debug_with_guard(call_function_name + " : memory map: |" + str_stream.str());
+    debug_with_guard([&]() { return call_function_name + " : memory map: |" + str_stream.str(); });
 }
 
 inline allocator *allocator_sorted_list::get_allocator() const
@@ -2,6 +2,7 @@
 #define MATH_PRACTICE_AND_OPERATING_SYSTEMS_ASSOCIATIVE_CONTAINER_H
 
 #include <iostream>
+#include <type_traits>
 #include <vector>
 #include <operation_not_supported.h>
 
@@ -11,7 +12,7 @@ template<
 class associative_container
 {
 
-protected:
+public:
 
     class default_key_comparer final
     {
@@ -20,11 +21,19 @@ protected:
         
         int operator()(
             int first,
-            int second);
+            int second) const;
+        
+        // natural order for the rest of arithmetic keys, search trees rely on it for native key search
+        template<
+            typename tarithmetic,
+            typename = std::enable_if_t<std::is_arithmetic_v<tarithmetic>>>
+        int operator()(
+            tarithmetic first,
+            tarithmetic second) const;
         
         int operator()(
             std::string const &first,
-            std::string const &second);
+            std::string const &second) const;
         
     };
 
@@ -47,6 +56,10 @@ public:
         key_value_pair(
             tkey const &key,
             tvalue&& value);
+        
+        key_value_pair(
+            tkey&& key,
+            tvalue&& value);
     
     };
     
@@ -105,9 +118,22 @@ template<
     typename tvalue>
 int associative_container<tkey, tvalue>::default_key_comparer::operator()(
     int first,
-    int second)
+    int second) const
 {
-    return first - second;
+    return (first > second) - (first < second);
+}
+
+template<
+    typename tkey,
+    typename tvalue>
+template<
+    typename tarithmetic,
+    typename>
+int associative_container<tkey, tvalue>::default_key_comparer::operator()(
+    tarithmetic first,
+    tarithmetic second) const
+{
+    return (first > second) - (first < second);
 }
 
 template<
@@ -115,7 +141,7 @@ template<
     typename tvalue>
 int associative_container<tkey, tvalue>::default_key_comparer::operator()(
     std::string const &first,
-    std::string const &second)
+    std::string const &second) const
 {
     if (first > second)
     {
@@ -146,4 +172,13 @@ associative_container<tkey, tvalue>::key_value_pair::key_value_pair(
         key(key), value(std::move(value))
 { }
 
+template<
+    typename tkey,
+    typename tvalue>
+associative_container<tkey, tvalue>::key_value_pair::key_value_pair(
+    tkey&& key,
+    tvalue&& value):
+        key(std::move(key)), value(std::move(value))
+{ }
+
 #endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_ASSOCIATIVE_CONTAINER_H
\ No newline at end of file
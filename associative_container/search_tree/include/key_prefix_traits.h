@@ -0,0 +1,59 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_KEY_PREFIX_TRAITS_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_KEY_PREFIX_TRAITS_H
+
+#include <cstddef>
+#include <cstdint>
+
+class key_prefix final
+{
+
+public:
+
+    using type = uint64_t;
+
+public:
+
+    // first bytes of key packed big-endian and zero-padded: prefixes order like the bytes they are taken from,
+    // equal prefixes decide nothing
+    static type from_bytes(
+        char const *bytes,
+        size_t size) noexcept;
+
+public:
+
+    key_prefix() = delete;
+
+};
+
+inline key_prefix::type key_prefix::from_bytes(
+    char const *bytes,
+    size_t size) noexcept
+{
+    type prefix = 0;
+
+    for (size_t i = 0; i < sizeof(type); ++i)
+    {
+        prefix <<= 8;
+        if (i < size)
+        {
+            prefix |= static_cast<unsigned char>(bytes[i]);
+        }
+    }
+
+    return prefix;
+}
+
+// specializations let search trees keep normalized key prefixes in nodes; they define
+//     static constexpr bool enabled = true;
+//     using comparer = <comparer type ordering keys the way their prefixes are ordered>;
+//     static key_prefix::type make(tkey const &key) noexcept;
+template<
+    typename tkey>
+struct key_prefix_traits
+{
+
+    static constexpr bool enabled = false;
+
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_KEY_PREFIX_TRAITS_H
@@ -0,0 +1,182 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_NODE_KEYS_SEARCH_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_NODE_KEYS_SEARCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE4_2__)
+#include <nmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+class node_keys_search final
+{
+
+public:
+
+    // ranges not longer than this are scanned linearly, longer ones are narrowed by binary search first
+    static constexpr size_t linear_search_threshold = 32;
+
+public:
+
+    // count of keys less than key in sorted keys[0, count), i.e. lower bound position; nonzero capacity is known
+    // to be not less than count, so loops are bounded at compile time and small nodes skip binary narrowing
+    template<
+        size_t capacity = 0,
+        typename tkey>
+    static size_t lower_bound(
+        tkey const *keys,
+        size_t count,
+        tkey const &key) noexcept;
+
+private:
+
+    template<
+        size_t capacity,
+        typename tkey>
+    static size_t count_less(
+        tkey const *keys,
+        size_t count,
+        tkey key) noexcept;
+
+public:
+
+    node_keys_search() = delete;
+
+};
+
+template<
+    size_t capacity,
+    typename tkey>
+size_t node_keys_search::lower_bound(
+    tkey const *keys,
+    size_t count,
+    tkey const &key) noexcept
+{
+    static_assert(std::is_arithmetic_v<tkey>, "node_keys_search requires arithmetic keys");
+
+    // ranges left to linear scan are never longer than that
+    constexpr size_t scanned_capacity = capacity == 0 || capacity > linear_search_threshold
+        ? linear_search_threshold
+        : capacity;
+
+    size_t base = 0;
+
+    if constexpr (scanned_capacity != capacity)
+    {
+        // branchless binary narrowing: the step taken is independent of comparison outcome
+        while (count > linear_search_threshold)
+        {
+            size_t const half = count / 2;
+            base = keys[base + half - 1] < key ? base + half : base;
+            count -= half;
+        }
+    }
+
+    return base + count_less<scanned_capacity>(keys + base, count, key);
+}
+
+template<
+    size_t capacity,
+    typename tkey>
+size_t node_keys_search::count_less(
+    tkey const *keys,
+    size_t count,
+    tkey key) noexcept
+{
+    if (count > capacity)
+    {
+        __builtin_unreachable();
+    }
+
+    size_t result = 0;
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    if constexpr (std::is_integral_v<tkey> && std::is_signed_v<tkey> && sizeof(tkey) == 4)
+    {
+        __m256i const pattern = _mm256_set1_epi32(static_cast<int32_t>(key));
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i const chunk = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(keys + i));
+            result += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(pattern, chunk))));
+        }
+    }
+    else if constexpr (std::is_integral_v<tkey> && std::is_signed_v<tkey> && sizeof(tkey) == 8)
+    {
+        __m256i const pattern = _mm256_set1_epi64x(static_cast<int64_t>(key));
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256i const chunk = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(keys + i));
+            result += __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(pattern, chunk))));
+        }
+    }
+    else if constexpr (std::is_same_v<tkey, float>)
+    {
+        __m256 const pattern = _mm256_set1_ps(key);
+        for (; i + 8 <= count; i += 8)
+        {
+            result += __builtin_popcount(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(keys + i), pattern, _CMP_LT_OQ)));
+        }
+    }
+    else if constexpr (std::is_same_v<tkey, double>)
+    {
+        __m256d const pattern = _mm256_set1_pd(key);
+        for (; i + 4 <= count; i += 4)
+        {
+            result += __builtin_popcount(_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(keys + i), pattern, _CMP_LT_OQ)));
+        }
+    }
+#elif defined(__SSE2__)
+    if constexpr (std::is_integral_v<tkey> && std::is_signed_v<tkey> && sizeof(tkey) == 4)
+    {
+        __m128i const pattern = _mm_set1_epi32(static_cast<int32_t>(key));
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i const chunk = _mm_loadu_si128(reinterpret_cast<__m128i const *>(keys + i));
+            result += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(pattern, chunk))));
+        }
+    }
+#if defined(__SSE4_2__)
+    else if constexpr (std::is_integral_v<tkey> && std::is_signed_v<tkey> && sizeof(tkey) == 8)
+    {
+        __m128i const pattern = _mm_set1_epi64x(static_cast<int64_t>(key));
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128i const chunk = _mm_loadu_si128(reinterpret_cast<__m128i const *>(keys + i));
+            result += __builtin_popcount(_mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(pattern, chunk))));
+        }
+    }
+#endif
+    else if constexpr (std::is_same_v<tkey, float>)
+    {
+        __m128 const pattern = _mm_set1_ps(key);
+        for (; i + 4 <= count; i += 4)
+        {
+            result += __builtin_popcount(_mm_movemask_ps(_mm_cmplt_ps(_mm_loadu_ps(keys + i), pattern)));
+        }
+    }
+    else if constexpr (std::is_same_v<tkey, double>)
+    {
+        __m128d const pattern = _mm_set1_pd(key);
+        for (; i + 2 <= count; i += 2)
+        {
+            result += __builtin_popcount(_mm_movemask_pd(_mm_cmplt_pd(_mm_loadu_pd(keys + i), pattern)));
+        }
+    }
+#endif
+
+    // scalar fallback and vector tail: branchless count over sorted keys
+    for (; i < count; ++i)
+    {
+        result += keys[i] < key ? 1 : 0;
+    }
+
+    return result;
+}
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_NODE_KEYS_SEARCH_H
@@ -0,0 +1,208 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_NODE_PATH_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_NODE_PATH_H
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// root-to-node path kept inline, with std::stack interface: pushing and copying never allocate
+template<
+    typename tentry,
+    size_t capacity = std::numeric_limits<size_t>::digits>
+class node_path final
+{
+
+    static_assert(std::is_trivially_copy_constructible_v<tentry> && std::is_trivially_destructible_v<tentry>,
+        "node_path entries are copied as plain data and never destructed");
+
+public:
+
+    // every level of a tree with t >= 2 at least doubles keys count, so no countable tree is higher
+    static constexpr size_t max_height = capacity;
+
+private:
+
+    alignas(tentry) unsigned char _entries[capacity * sizeof(tentry)];
+
+    size_t _size;
+
+public:
+
+    node_path() noexcept;
+
+    node_path(
+        node_path const &other) noexcept;
+
+    node_path &operator=(
+        node_path const &other) noexcept;
+
+public:
+
+    [[nodiscard]] bool empty() const noexcept;
+
+    [[nodiscard]] size_t size() const noexcept;
+
+    tentry &top() noexcept;
+
+    tentry const &top() const noexcept;
+
+    void push(
+        tentry const &entry);
+
+    template<
+        typename ...targs>
+    tentry &emplace(
+        targs &&...args);
+
+    void pop() noexcept;
+
+    // entries from the bottom of the path to its top
+    tentry *begin() noexcept;
+
+    tentry *end() noexcept;
+
+private:
+
+    tentry *entries() noexcept;
+
+    tentry const *entries() const noexcept;
+
+};
+
+template<
+    typename tentry,
+    size_t capacity>
+node_path<tentry, capacity>::node_path() noexcept:
+    _size(0)
+{
+
+}
+
+template<
+    typename tentry,
+    size_t capacity>
+node_path<tentry, capacity>::node_path(
+    node_path const &other) noexcept:
+        _size(other._size)
+{
+    // only the used part is copied, unused slots are never read
+    std::uninitialized_copy_n(other.entries(), _size, reinterpret_cast<tentry *>(_entries));
+}
+
+template<
+    typename tentry,
+    size_t capacity>
+node_path<tentry, capacity> &node_path<tentry, capacity>::operator=(
+    node_path const &other) noexcept
+{
+    if (this != &other)
+    {
+        _size = other._size;
+        std::uninitialized_copy_n(other.entries(), _size, reinterpret_cast<tentry *>(_entries));
+    }
+
+    return *this;
+}
+
+template<
+    typename tentry,
+    size_t capacity>
+bool node_path<tentry, capacity>::empty() const noexcept
+{
+    return _size == 0;
+}
+
+template<
+    typename tentry,
+    size_t capacity>
+size_t node_path<tentry, capacity>::size() const noexcept
+{
+    return _size;
+}
+
+template<
+    typename tentry,
+    size_t capacity>
+tentry &node_path<tentry, capacity>::top() noexcept
+{
+    return entries()[_size - 1];
+}
+
+template<
+    typename tentry,
+    size_t capacity>
+tentry const &node_path<tentry, capacity>::top() const noexcept
+{
+    return entries()[_size - 1];
+}
+
+template<
+    typename tentry,
+    size_t capacity>
+void node_path<tentry, capacity>::push(
+    tentry const &entry)
+{
+    emplace(entry);
+}
+
+template<
+    typename tentry,
+    size_t capacity>
+template<
+    typename ...targs>
+tentry &node_path<tentry, capacity>::emplace(
+    targs &&...args)
+{
+    if (_size == capacity)
+    {
+        throw std::length_error("node path is higher than any tree may be");
+    }
+
+    return *::new (_entries + _size++ * sizeof(tentry)) tentry(std::forward<targs>(args)...);
+}
+
+template<
+    typename tentry,
+    size_t capacity>
+void node_path<tentry, capacity>::pop() noexcept
+{
+    --_size;
+}
+
+template<
+    typename tentry,
+    size_t capacity>
+tentry *node_path<tentry, capacity>::begin() noexcept
+{
+    return entries();
+}
+
+template<
+    typename tentry,
+    size_t capacity>
+tentry *node_path<tentry, capacity>::end() noexcept
+{
+    return entries() + _size;
+}
+
+template<
+    typename tentry,
+    size_t capacity>
+tentry *node_path<tentry, capacity>::entries() noexcept
+{
+    return std::launder(reinterpret_cast<tentry *>(_entries));
+}
+
+template<
+    typename tentry,
+    size_t capacity>
+tentry const *node_path<tentry, capacity>::entries() const noexcept
+{
+    return std::launder(reinterpret_cast<tentry const *>(_entries));
+}
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_NODE_PATH_H
@@ -0,0 +1,304 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_NODE_SLAB_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_NODE_SLAB_H
+
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+
+#include <allocator.h>
+#include <allocator_guardant.h>
+
+class node_slab final:
+    private allocator_guardant
+{
+
+public:
+
+    static constexpr size_t cache_line_size = 64;
+
+private:
+
+    allocator *_allocator;
+
+    size_t _block_size;
+
+    size_t _blocks_per_chunk;
+
+    // chunks are linked through their first word, free blocks - through theirs
+    void *_chunks;
+
+    void *_free_blocks;
+
+    size_t _live_blocks_count;
+
+    size_t _cached_blocks_count;
+
+public:
+
+    explicit node_slab(
+        size_t block_size = 0,
+        allocator *allocator = nullptr,
+        size_t blocks_per_chunk = 16);
+
+    ~node_slab() noexcept override;
+
+    node_slab(
+        node_slab const &other) = delete;
+
+    node_slab &operator=(
+        node_slab const &other) = delete;
+
+    node_slab(
+        node_slab &&other) noexcept;
+
+    node_slab &operator=(
+        node_slab &&other) noexcept;
+
+public:
+
+    [[nodiscard]] void *allocate_block();
+
+    void deallocate_block(
+        void *block) noexcept;
+
+    // caches blocks until that many of them are handed out without going to the allocator
+    void reserve(
+        size_t blocks_count);
+
+    // takes over chunks of slab with the same blocks, so nodes built on other threads join this slab's nodes
+    void splice(
+        node_slab &&other);
+
+public:
+
+    [[nodiscard]] size_t get_block_size() const noexcept;
+
+    [[nodiscard]] allocator *get_blocks_allocator() const noexcept;
+
+    [[nodiscard]] size_t get_live_blocks_count() const noexcept;
+
+    [[nodiscard]] size_t get_cached_blocks_count() const noexcept;
+
+public:
+
+    static constexpr size_t align_up(
+        size_t value,
+        size_t alignment) noexcept;
+
+private:
+
+    void add_chunk();
+
+    void release() noexcept;
+
+    [[nodiscard]] inline allocator *get_allocator() const override;
+
+};
+
+inline node_slab::node_slab(
+    size_t block_size,
+    allocator *allocator,
+    size_t blocks_per_chunk):
+        _allocator(allocator),
+        _block_size(align_up(block_size, cache_line_size)),
+        _blocks_per_chunk(blocks_per_chunk == 0 ? 1 : blocks_per_chunk),
+        _chunks(nullptr),
+        _free_blocks(nullptr),
+        _live_blocks_count(0),
+        _cached_blocks_count(0)
+{ }
+
+inline node_slab::~node_slab() noexcept
+{
+    release();
+}
+
+inline node_slab::node_slab(
+    node_slab &&other) noexcept:
+        _allocator(other._allocator),
+        _block_size(other._block_size),
+        _blocks_per_chunk(other._blocks_per_chunk),
+        _chunks(other._chunks),
+        _free_blocks(other._free_blocks),
+        _live_blocks_count(other._live_blocks_count),
+        _cached_blocks_count(other._cached_blocks_count)
+{
+    other._chunks = nullptr;
+    other._free_blocks = nullptr;
+    other._live_blocks_count = 0;
+    other._cached_blocks_count = 0;
+}
+
+inline node_slab &node_slab::operator=(
+    node_slab &&other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+
+        _allocator = other._allocator;
+        _block_size = other._block_size;
+        _blocks_per_chunk = other._blocks_per_chunk;
+        _chunks = other._chunks;
+        _free_blocks = other._free_blocks;
+        _live_blocks_count = other._live_blocks_count;
+        _cached_blocks_count = other._cached_blocks_count;
+
+        other._chunks = nullptr;
+        other._free_blocks = nullptr;
+        other._live_blocks_count = 0;
+        other._cached_blocks_count = 0;
+    }
+
+    return *this;
+}
+
+inline void *node_slab::allocate_block()
+{
+    if (_free_blocks == nullptr)
+    {
+        add_chunk();
+    }
+
+    void *block = _free_blocks;
+    _free_blocks = *reinterpret_cast<void **>(block);
+
+    --_cached_blocks_count;
+    ++_live_blocks_count;
+
+    return block;
+}
+
+inline void node_slab::deallocate_block(
+    void *block) noexcept
+{
+    if (block == nullptr)
+    {
+        return;
+    }
+
+    *reinterpret_cast<void **>(block) = _free_blocks;
+    _free_blocks = block;
+
+    --_live_blocks_count;
+    ++_cached_blocks_count;
+}
+
+inline void node_slab::reserve(
+    size_t blocks_count)
+{
+    while (_cached_blocks_count < blocks_count)
+    {
+        add_chunk();
+    }
+}
+
+inline void node_slab::splice(
+    node_slab &&other)
+{
+    if (other._chunks == nullptr || this == &other)
+    {
+        return;
+    }
+
+    if (_chunks == nullptr)
+    {
+        *this = std::move(other);
+        return;
+    }
+
+    if (_block_size != other._block_size || _allocator != other._allocator)
+    {
+        throw std::logic_error("spliced slab must have the same blocks");
+    }
+
+    void **chunks_tail = &other._chunks;
+    while (*chunks_tail != nullptr)
+    {
+        chunks_tail = reinterpret_cast<void **>(*chunks_tail);
+    }
+    *chunks_tail = _chunks;
+    _chunks = other._chunks;
+
+    void **free_blocks_tail = &other._free_blocks;
+    while (*free_blocks_tail != nullptr)
+    {
+        free_blocks_tail = reinterpret_cast<void **>(*free_blocks_tail);
+    }
+    *free_blocks_tail = _free_blocks;
+    _free_blocks = other._free_blocks;
+
+    _live_blocks_count += other._live_blocks_count;
+    _cached_blocks_count += other._cached_blocks_count;
+
+    other._chunks = nullptr;
+    other._free_blocks = nullptr;
+    other._live_blocks_count = 0;
+    other._cached_blocks_count = 0;
+}
+
+inline size_t node_slab::get_block_size() const noexcept
+{
+    return _block_size;
+}
+
+inline allocator *node_slab::get_blocks_allocator() const noexcept
+{
+    return _allocator;
+}
+
+inline size_t node_slab::get_live_blocks_count() const noexcept
+{
+    return _live_blocks_count;
+}
+
+inline size_t node_slab::get_cached_blocks_count() const noexcept
+{
+    return _cached_blocks_count;
+}
+
+constexpr size_t node_slab::align_up(
+    size_t value,
+    size_t alignment) noexcept
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+inline void node_slab::add_chunk()
+{
+    // one trip to the allocator carves a whole chunk; extra cache line covers alignment of the first block
+    void *chunk = allocate_with_guard(1, cache_line_size + _block_size * _blocks_per_chunk + cache_line_size - 1);
+    *reinterpret_cast<void **>(chunk) = _chunks;
+    _chunks = chunk;
+
+    auto first_block = align_up(reinterpret_cast<uintptr_t>(chunk) + sizeof(void *), cache_line_size);
+    for (size_t i = _blocks_per_chunk; i > 0; --i)
+    {
+        void *block = reinterpret_cast<void *>(first_block + (i - 1) * _block_size);
+        *reinterpret_cast<void **>(block) = _free_blocks;
+        _free_blocks = block;
+    }
+
+    _cached_blocks_count += _blocks_per_chunk;
+}
+
+inline void node_slab::release() noexcept
+{
+    while (_chunks != nullptr)
+    {
+        void *next = *reinterpret_cast<void **>(_chunks);
+        deallocate_with_guard(_chunks);
+        _chunks = next;
+    }
+
+    _free_blocks = nullptr;
+    _live_blocks_count = 0;
+    _cached_blocks_count = 0;
+}
+
+[[nodiscard]] inline allocator *node_slab::get_allocator() const
+{
+    return _allocator;
+}
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_NODE_SLAB_H
@@ -0,0 +1,167 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_RELOCATION_TRAITS_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_RELOCATION_TRAITS_H
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// specializations mark types whose objects may be moved to another address by copying their bytes, the source
+// being considered destroyed afterwards (no pointers into the object itself, no registration by address); they define
+//     static constexpr bool trivial = true;
+template<
+    typename t>
+struct relocation_traits
+{
+
+    static constexpr bool trivial = std::is_trivially_copyable_v<t>;
+
+};
+
+// smart pointers own their targets through plain pointers, moving them bytewise skips reference counting
+template<
+    typename t,
+    typename tdeleter>
+struct relocation_traits<std::unique_ptr<t, tdeleter>>
+{
+
+    static constexpr bool trivial = relocation_traits<tdeleter>::trivial;
+
+};
+
+template<
+    typename t>
+struct relocation_traits<std::shared_ptr<t>>
+{
+
+    static constexpr bool trivial = true;
+
+};
+
+template<
+    typename t>
+struct relocation_traits<std::weak_ptr<t>>
+{
+
+    static constexpr bool trivial = true;
+
+};
+
+// moves objects between slots of node arrays: trivially relocatable ones by memmove, others by move construction
+// followed by destruction of the source
+class relocation final
+{
+
+public:
+
+    // destination slots are uninitialized, source slots are left uninitialized; ranges may overlap
+    template<
+        typename t>
+    static void relocate(
+        t *destination,
+        t *source,
+        size_t count);
+
+    // slot at index is left uninitialized, slot at count must be uninitialized
+    template<
+        typename t>
+    static void open_gap(
+        t *items,
+        size_t count,
+        size_t index);
+
+    // slot at index must be uninitialized, slot at count - 1 is left uninitialized
+    template<
+        typename t>
+    static void close_gap(
+        t *items,
+        size_t count,
+        size_t index);
+
+    template<
+        typename t>
+    static void swap(
+        t &first,
+        t &second);
+
+public:
+
+    relocation() = delete;
+
+};
+
+template<
+    typename t>
+void relocation::relocate(
+    t *destination,
+    t *source,
+    size_t count)
+{
+    if (count == 0 || destination == source)
+    {
+        return;
+    }
+
+    if constexpr (relocation_traits<t>::trivial)
+    {
+        std::memmove(static_cast<void *>(destination), static_cast<void const *>(source), sizeof(t) * count);
+    }
+    else
+    {
+        bool const backward = std::less<t *>()(source, destination);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            size_t const offset = backward ? count - 1 - i : i;
+
+            ::new (static_cast<void *>(destination + offset)) t(std::move(source[offset]));
+            source[offset].~t();
+        }
+    }
+}
+
+template<
+    typename t>
+void relocation::open_gap(
+    t *items,
+    size_t count,
+    size_t index)
+{
+    relocate(items + index + 1, items + index, count - index);
+}
+
+template<
+    typename t>
+void relocation::close_gap(
+    t *items,
+    size_t count,
+    size_t index)
+{
+    relocate(items + index, items + index + 1, count - index - 1);
+}
+
+template<
+    typename t>
+void relocation::swap(
+    t &first,
+    t &second)
+{
+    if constexpr (relocation_traits<t>::trivial)
+    {
+        alignas(t) unsigned char buffer[sizeof(t)];
+
+        std::memcpy(buffer, static_cast<void const *>(&first), sizeof(t));
+        std::memcpy(static_cast<void *>(&first), static_cast<void const *>(&second), sizeof(t));
+        std::memcpy(static_cast<void *>(&second), buffer, sizeof(t));
+    }
+    else
+    {
+        using std::swap;
+        swap(first, second);
+    }
+}
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_RELOCATION_TRAITS_H
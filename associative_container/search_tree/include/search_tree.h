@@ -1,9 +1,9 @@
 #ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_SEARCH_TREE_H
 #define MATH_PRACTICE_AND_OPERATING_SYSTEMS_SEARCH_TREE_H
 
+#include <cstring>
 #include <iostream>
 #include <functional>
-#include <stack>
 #include <vector>
 
 #include <typename_holder.h>
@@ -13,10 +13,16 @@
 #include <logger.h>
 #include <logger_guardant.h>
 #include <not_implemented.h>
+#include <node_slab.h>
+#include <node_keys_search.h>
+#include <node_path.h>
+#include <key_prefix_traits.h>
+#include <relocation_traits.h>
 
 template<
     typename tkey,
-    typename tvalue>
+    typename tvalue,
+    typename tcomparer = std::function<int(tkey const &, tkey const &)>>
 class search_tree:
     public associative_container<tkey, tvalue>,
     protected typename_holder,
@@ -31,16 +37,30 @@ public:
     
     public:
         
-        typename associative_container<tkey, tvalue>::key_value_pair *keys_and_values;
+        // keys, values and subtrees are kept in separate arrays, so key search touches key cache lines only
+        tkey *keys;
+        
+        // normalized prefixes of keys, nullptr unless key_prefix_traits<tkey> is enabled
+        key_prefix::type *prefixes;
+        
+        tvalue *values;
         
         common_node **subtrees;
         
         size_t virtual_size;
+        
+        // entries count of subtree rooted at node, kept by trees answering rank queries
+        size_t subtree_size;
+        
+        // parents and snapshots holding node, kept by trees sharing nodes with snapshots
+        size_t references;
     
     public:
     
         explicit common_node(
-            typename associative_container<tkey, tvalue>::key_value_pair *keys_and_values,
+            key_prefix::type *prefixes,
+            tkey *keys,
+            tvalue *values,
             common_node **subtrees,
             size_t t);
         
@@ -128,56 +148,141 @@ public:
     
     #pragma endregion target operations associated exception types
     
+public:
+
+    // comparer type of trees built without explicit comparer parameter, calls through it are not inlined
+    using type_erased_comparer = std::function<int(tkey const &, tkey const &)>;
+
 protected:
     
-    std::function<int(tkey const &, tkey const &)> _keys_comparer;
+    tcomparer _keys_comparer;
+    bool _native_keys_order; // arithmetic keys compared by default comparer are searched without the comparer
+    bool _prefixed_keys_order; // node key prefixes are ordered like keys, so they may decide comparisons
     logger *_logger;
     allocator *_allocator;
     void *_root; // todo make common_node
+    node_slab _nodes_slab;
     
 protected:
 
     #pragma region node operations
 
+    // node header, keys, values and subtrees share one cache-line-aligned slab block
+    common_node *create_node(
+        size_t t);
+
+    // node is carved from given slab, which takes node layout if it holds no nodes yet
     common_node *create_node(
-        size_t t) const;
+        size_t t,
+        node_slab &slab);
     
     void destroy_node(
         common_node *to_destroy);
+
+    void destroy_node(
+        common_node *to_destroy,
+        node_slab &slab);
     
+    // capacity, if known at compile time, bounds node keys count, so scans over arithmetic keys get constant bounds
+    template<
+        size_t capacity = 0>
     int node_find_path(
-        typename search_tree<tkey, tvalue>::common_node const *node,
+        typename search_tree<tkey, tvalue, tcomparer>::common_node const *node,
         tkey const &key,
         size_t left_bound_inclusive,
-        size_t right_bound_inclusive);
+        size_t right_bound_inclusive) const;
     
     void node_insert(
-        typename search_tree<tkey, tvalue>::common_node *node,
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *node,
         typename associative_container<tkey, tvalue>::key_value_pair &&kvp,
         size_t subtree_index,
-        typename search_tree<tkey, tvalue>::common_node *right_subtree);
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *right_subtree);
     
-    std::pair<typename search_tree<tkey, tvalue>::common_node *, typename associative_container<tkey, tvalue>::key_value_pair> node_split(
-        typename search_tree<tkey, tvalue>::common_node *node,
+    std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node *, typename associative_container<tkey, tvalue>::key_value_pair> node_split(
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *node,
         typename associative_container<tkey, tvalue>::key_value_pair &&kvp,
         size_t subtree_index,
-        typename search_tree<tkey, tvalue>::common_node *right_subtree);
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *right_subtree);
     
     void node_merge(
-        typename search_tree<tkey, tvalue>::common_node *parent,
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *parent,
         size_t left_subtree_index);
-    
+
+    void node_construct_entry(
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *node,
+        size_t index,
+        typename associative_container<tkey, tvalue>::key_value_pair &&kvp);
+
+    typename associative_container<tkey, tvalue>::key_value_pair node_extract_entry(
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *node,
+        size_t index);
+
+    void node_destruct_entry(
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *node,
+        size_t index);
+
+    void node_swap_entries(
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *first,
+        size_t first_index,
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *second,
+        size_t second_index);
+
+    // moves entries into uninitialized slots of destination, leaving source slots uninitialized;
+    // ranges may overlap when source and destination are the same node
+    void node_relocate_entries(
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *destination,
+        size_t destination_index,
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *source,
+        size_t source_index,
+        size_t count);
+
+    void node_relocate_subtrees(
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *destination,
+        size_t destination_index,
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *source,
+        size_t source_index,
+        size_t count);
+
     #pragma endregion common node operations
     
 protected:
     
-    std::stack<std::pair<typename search_tree<tkey, tvalue>::common_node**, int>> find_path(
+    template<
+        size_t capacity = 0>
+    node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node**, int>> find_path(
+        tkey const &key);
+
+    // turns path found for a smaller key into path for given one: rises while key is beyond the last key
+    // of the node on top, then descends as find_path does; nodes on path must not have been restructured
+    template<
+        size_t capacity = 0>
+    void resume_path(
+        node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node**, int>> &path,
         tkey const &key);
+
+    // true if keys comparer is (or, being type erased, holds) a comparer of given type
+    template<
+        typename tcomparer_target>
+    static bool is_keys_comparer(
+        tcomparer const &keys_comparer) noexcept;
+
+    static bool is_native_keys_order(
+        tcomparer const &keys_comparer) noexcept;
+
+    static bool is_prefixed_keys_order(
+        tcomparer const &keys_comparer) noexcept;
+
+    // constant for compile-time comparers, so the unused search path is not even instantiated
+    [[nodiscard]] inline bool native_keys_order() const noexcept;
+
+    [[nodiscard]] inline bool prefixed_keys_order() const noexcept;
+
+    static tcomparer default_keys_comparer();
     
 protected:
     
     explicit search_tree(
-        std::function<int(tkey const &, tkey const &)> keys_comparer = typename associative_container<tkey, tvalue>::default_key_comparer(),
+        tcomparer keys_comparer = default_keys_comparer(),
         allocator *allocator = nullptr,
         logger *logger = nullptr);
     
@@ -189,6 +294,12 @@ public:
         bool lower_bound_inclusive,
         bool upper_bound_inclusive) = 0;
 
+public:
+
+    [[nodiscard]] size_t get_live_nodes_count() const noexcept;
+
+    [[nodiscard]] size_t get_cached_nodes_count() const noexcept;
+
 protected:
     
     [[nodiscard]] inline allocator *get_allocator() const final;
@@ -205,14 +316,21 @@ private:
 
 template<
     typename tkey,
-    typename tvalue>
-search_tree<tkey, tvalue>::common_node::common_node(
-    typename associative_container<tkey, tvalue>::key_value_pair *keys_and_values,
+    typename tvalue,
+    typename tcomparer>
+search_tree<tkey, tvalue, tcomparer>::common_node::common_node(
+    key_prefix::type *prefixes,
+    tkey *keys,
+    tvalue *values,
     common_node **subtrees,
     size_t t):
-        keys_and_values(keys_and_values),
+        keys(keys),
+        prefixes(prefixes),
+        values(values),
         subtrees(subtrees),
-        virtual_size(0)
+        virtual_size(0),
+        subtree_size(0),
+        references(1)
 {
     for (size_t i = 0; i < 2*t; ++i)
     {
@@ -222,8 +340,9 @@ search_tree<tkey, tvalue>::common_node::common_node(
 
 template<
     typename tkey,
-    typename tvalue>
-search_tree<tkey, tvalue>::common_node::~common_node() noexcept
+    typename tvalue,
+    typename tcomparer>
+search_tree<tkey, tvalue, tcomparer>::common_node::~common_node() noexcept
 {
     virtual_size = 0;
 }
@@ -234,8 +353,9 @@ search_tree<tkey, tvalue>::common_node::~common_node() noexcept
 
 template<
     typename tkey,
-    typename tvalue>
-search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_exception_exception::insertion_of_existent_key_attempt_exception_exception(
+    typename tvalue,
+    typename tcomparer>
+search_tree<tkey, tvalue, tcomparer>::insertion_of_existent_key_attempt_exception_exception::insertion_of_existent_key_attempt_exception_exception(
     tkey const &key):
         std::logic_error("Attempt to insert already existing key inside the tree."),
         _key(key)
@@ -243,16 +363,18 @@ search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_exception_exception
 
 template<
     typename tkey,
-    typename tvalue>
-tkey const &search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_exception_exception::get_key() const noexcept
+    typename tvalue,
+    typename tcomparer>
+tkey const &search_tree<tkey, tvalue, tcomparer>::insertion_of_existent_key_attempt_exception_exception::get_key() const noexcept
 {
     return _key;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-search_tree<tkey, tvalue>::obtaining_of_nonexistent_key_attempt_exception::obtaining_of_nonexistent_key_attempt_exception(
+    typename tvalue,
+    typename tcomparer>
+search_tree<tkey, tvalue, tcomparer>::obtaining_of_nonexistent_key_attempt_exception::obtaining_of_nonexistent_key_attempt_exception(
     tkey const &key):
         std::logic_error("Attempt to obtain a value by non-existing key from the tree."),
         _key(key)
@@ -260,16 +382,18 @@ search_tree<tkey, tvalue>::obtaining_of_nonexistent_key_attempt_exception::obtai
 
 template<
     typename tkey,
-    typename tvalue>
-tkey const &search_tree<tkey, tvalue>::obtaining_of_nonexistent_key_attempt_exception::get_key() const noexcept
+    typename tvalue,
+    typename tcomparer>
+tkey const &search_tree<tkey, tvalue, tcomparer>::obtaining_of_nonexistent_key_attempt_exception::get_key() const noexcept
 {
     return _key;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-search_tree<tkey, tvalue>::updating_of_nonexistent_key_attempt_exception::updating_of_nonexistent_key_attempt_exception(
+    typename tvalue,
+    typename tcomparer>
+search_tree<tkey, tvalue, tcomparer>::updating_of_nonexistent_key_attempt_exception::updating_of_nonexistent_key_attempt_exception(
     tkey const &key):
         std::logic_error("Attempt to update a value by non-existing key from the tree."),
         _key(key)
@@ -277,16 +401,18 @@ search_tree<tkey, tvalue>::updating_of_nonexistent_key_attempt_exception::updati
 
 template<
     typename tkey,
-    typename tvalue>
-tkey const &search_tree<tkey, tvalue>::updating_of_nonexistent_key_attempt_exception::get_key() const noexcept
+    typename tvalue,
+    typename tcomparer>
+tkey const &search_tree<tkey, tvalue, tcomparer>::updating_of_nonexistent_key_attempt_exception::get_key() const noexcept
 {
     return _key;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_exception::disposal_of_nonexistent_key_attempt_exception(
+    typename tvalue,
+    typename tcomparer>
+search_tree<tkey, tvalue, tcomparer>::disposal_of_nonexistent_key_attempt_exception::disposal_of_nonexistent_key_attempt_exception(
     tkey const &key):
         std::logic_error("Attempt to dispose a value by non-existing key from the tree."),
         _key(key)
@@ -294,8 +420,9 @@ search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_exception::dispos
 
 template<
     typename tkey,
-    typename tvalue>
-tkey const &search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_exception::get_key() const noexcept
+    typename tvalue,
+    typename tcomparer>
+tkey const &search_tree<tkey, tvalue, tcomparer>::disposal_of_nonexistent_key_attempt_exception::get_key() const noexcept
 {
     return _key;
 }
@@ -306,80 +433,143 @@ tkey const &search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_excep
 
 template<
     typename tkey,
-    typename tvalue>
-typename search_tree<tkey, tvalue>::common_node *search_tree<tkey, tvalue>::create_node(
-    size_t t) const
+    typename tvalue,
+    typename tcomparer>
+typename search_tree<tkey, tvalue, tcomparer>::common_node *search_tree<tkey, tvalue, tcomparer>::create_node(
+    size_t t)
 {
-    typename associative_container<tkey, tvalue>::key_value_pair *keys_and_values = nullptr;
-    common_node **subtrees = nullptr;
-    common_node *node = nullptr;
-    
-    try
-    {
-        keys_and_values = reinterpret_cast<typename associative_container<tkey, tvalue>::key_value_pair*>(
-            allocate_with_guard(sizeof(typename associative_container<tkey, tvalue>::key_value_pair), 2 * t - 1));
-            
-        subtrees = reinterpret_cast<common_node**>(
-            allocate_with_guard(sizeof(common_node*), 2 * t));
-            
-        node = reinterpret_cast<common_node*>(
-            allocate_with_guard(sizeof(common_node), 1));
-    }
-    catch (std::bad_alloc const &)
+    return create_node(t, _nodes_slab);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename search_tree<tkey, tvalue, tcomparer>::common_node *search_tree<tkey, tvalue, tcomparer>::create_node(
+    size_t t,
+    node_slab &slab)
+{
+    static_assert(alignof(tkey) <= node_slab::cache_line_size && alignof(tvalue) <= node_slab::cache_line_size,
+        "node entries alignment must not exceed cache line size");
+
+    size_t const prefixes_count = key_prefix_traits<tkey>::enabled ? 2 * t - 1 : 0;
+    size_t const prefixes_offset = node_slab::align_up(sizeof(common_node), alignof(key_prefix::type));
+    size_t const keys_offset = node_slab::align_up(prefixes_offset + sizeof(key_prefix::type) * prefixes_count, alignof(tkey));
+    size_t const values_offset = node_slab::align_up(keys_offset + sizeof(tkey) * (2 * t - 1), alignof(tvalue));
+    size_t const subtrees_offset = node_slab::align_up(values_offset + sizeof(tvalue) * (2 * t - 1), alignof(common_node *));
+    size_t const block_size = subtrees_offset + sizeof(common_node *) * 2 * t;
+
+    if (slab.get_block_size() != node_slab::align_up(block_size, node_slab::cache_line_size) ||
+        slab.get_blocks_allocator() != _allocator)
     {
-        deallocate_with_guard(keys_and_values);
-        deallocate_with_guard(subtrees);
-        deallocate_with_guard(node);
-        throw;
+        if (slab.get_live_blocks_count() != 0)
+        {
+            throw std::logic_error("node layout can't change while nodes are alive");
+        }
+
+        slab = node_slab(block_size, _allocator);
     }
-    
-    allocator::construct(node, keys_and_values, subtrees, t);
-    
+
+    auto *block = reinterpret_cast<unsigned char *>(slab.allocate_block());
+    auto *node = reinterpret_cast<common_node *>(block);
+
+    allocator::construct(node,
+        prefixes_count == 0 ? nullptr : reinterpret_cast<key_prefix::type *>(block + prefixes_offset),
+        reinterpret_cast<tkey *>(block + keys_offset),
+        reinterpret_cast<tvalue *>(block + values_offset),
+        reinterpret_cast<common_node **>(block + subtrees_offset),
+        t);
+
     return node;
 }
-    
+
 template<
     typename tkey,
-    typename tvalue>
-void search_tree<tkey, tvalue>::destroy_node(
+    typename tvalue,
+    typename tcomparer>
+void search_tree<tkey, tvalue, tcomparer>::destroy_node(
     common_node *to_destroy)
+{
+    destroy_node(to_destroy, _nodes_slab);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void search_tree<tkey, tvalue, tcomparer>::destroy_node(
+    common_node *to_destroy,
+    node_slab &slab)
 {
     for (size_t i = 0; i < to_destroy->virtual_size; ++i)
     {
-        allocator::destruct(to_destroy->keys_and_values + i);
+        node_destruct_entry(to_destroy, i);
     }
-    
-    deallocate_with_guard(to_destroy->keys_and_values);
-    deallocate_with_guard(to_destroy->subtrees);
+
     allocator::destruct(to_destroy);
-    deallocate_with_guard(to_destroy);
+    slab.deallocate_block(to_destroy);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-int search_tree<tkey, tvalue>::node_find_path(
-    typename search_tree<tkey, tvalue>::common_node const *node,
+    typename tvalue,
+    typename tcomparer>
+template<
+    size_t capacity>
+int search_tree<tkey, tvalue, tcomparer>::node_find_path(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node const *node,
     tkey const &key,
     size_t left_bound_inclusive,
-    size_t right_bound_inclusive)
+    size_t right_bound_inclusive) const
 {
+    if constexpr (std::is_arithmetic_v<tkey>)
+    {
+        if (native_keys_order())
+        {
+            int const index = static_cast<int>(left_bound_inclusive + node_keys_search::lower_bound<capacity>(
+                node->keys + left_bound_inclusive, right_bound_inclusive - left_bound_inclusive + 1, key));
+
+            return static_cast<size_t>(index) <= right_bound_inclusive && node->keys[index] == key
+                ? index
+                : -(index + 1);
+        }
+    }
+
+    key_prefix::type key_prefix = 0;
+    if constexpr (key_prefix_traits<tkey>::enabled)
+    {
+        if (prefixed_keys_order())
+        {
+            key_prefix = key_prefix_traits<tkey>::make(key);
+        }
+    }
+
     int index;
     while (true)
     {
         index = (left_bound_inclusive + right_bound_inclusive) / 2;
-        auto comparison_result = _keys_comparer(key, node->keys_and_values[index].key);
-        
+
+        int comparison_result;
+        if (prefixed_keys_order() && key_prefix != node->prefixes[index])
+        {
+            // distinct prefixes decide the order without touching the key itself
+            comparison_result = key_prefix < node->prefixes[index] ? -1 : 1;
+        }
+        else
+        {
+            comparison_result = _keys_comparer(key, node->keys[index]);
+        }
+
         if (comparison_result == 0)
         {
             return index;
         }
-        
+
         if (left_bound_inclusive == right_bound_inclusive)
         {
             return -(index + (comparison_result < 0 ? 0 : 1) + 1);
         }
-        
+
         if (comparison_result < 0)
         {
             right_bound_inclusive = index;
@@ -393,129 +583,217 @@ int search_tree<tkey, tvalue>::node_find_path(
 
 template<
     typename tkey,
-    typename tvalue>
-void search_tree<tkey, tvalue>::node_insert(
-    typename search_tree<tkey, tvalue>::common_node *node,
+    typename tvalue,
+    typename tcomparer>
+void search_tree<tkey, tvalue, tcomparer>::node_insert(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *node,
     typename associative_container<tkey, tvalue>::key_value_pair &&kvp,
     size_t subtree_index,
-    typename search_tree<tkey, tvalue>::common_node *right_subtree)
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *right_subtree)
 {
-    allocator::construct(node->keys_and_values + node->virtual_size, std::move(kvp));
-    node->subtrees[node->virtual_size + 1] = right_subtree;
-    
-    for (size_t i = 0; i < node->virtual_size - subtree_index; ++i)
-    {
-        std::swap(node->keys_and_values[node->virtual_size - i], node->keys_and_values[node->virtual_size - (i + 1)]);
-        std::swap(node->subtrees[node->virtual_size + 1 - i], node->subtrees[node->virtual_size - i]);
-    }
-    
+    node_relocate_entries(node, subtree_index + 1, node, subtree_index, node->virtual_size - subtree_index);
+    node_relocate_subtrees(node, subtree_index + 2, node, subtree_index + 1, node->virtual_size - subtree_index);
+
+    node_construct_entry(node, subtree_index, std::move(kvp));
+    node->subtrees[subtree_index + 1] = right_subtree;
+
     ++node->virtual_size;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-std::pair<typename search_tree<tkey, tvalue>::common_node *, typename associative_container<tkey, tvalue>::key_value_pair>
-search_tree<tkey, tvalue>::node_split(
-    typename search_tree<tkey, tvalue>::common_node *node,
+    typename tvalue,
+    typename tcomparer>
+std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node *, typename associative_container<tkey, tvalue>::key_value_pair>
+search_tree<tkey, tvalue, tcomparer>::node_split(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *node,
     typename associative_container<tkey, tvalue>::key_value_pair &&kvp,
     size_t subtree_index,
-    typename search_tree<tkey, tvalue>::common_node *right_subtree)
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *right_subtree)
 {
     size_t const t = (node->virtual_size + 1) / 2;
     size_t const mediant_index = t;
     common_node *new_node = create_node(t); // try create node before structure change
-    
-    if (subtree_index != mediant_index)
+
+    if (subtree_index == mediant_index)
     {
-        // mediant may shift right after "insertion" of kvp, so if subtree_index < mediant_index,
-        // we take left neighbour of pre-insert mediant as post-insert mediant
-        if (subtree_index < mediant_index)
-        {
-            std::swap(node->keys_and_values[mediant_index - 1], kvp);
-            std::swap(node->subtrees[mediant_index], right_subtree);
-            
-            for (size_t i = mediant_index - 1; i > subtree_index; --i)
-            {
-                std::swap(node->keys_and_values[i - 1], node->keys_and_values[i]);
-                std::swap(node->subtrees[i], node->subtrees[i + 1]);
-            }
-        }
-        else
-        {
-            std::swap(node->keys_and_values[mediant_index], kvp);
-            std::swap(node->subtrees[mediant_index + 1], right_subtree);
-            
-            for (size_t i = mediant_index + 1; i < subtree_index; ++i)
-            {
-                std::swap(node->keys_and_values[i], node->keys_and_values[i - 1]);
-                std::swap(node->subtrees[i + 1], node->subtrees[i]);
-            }
-        }
+        // kvp itself is the mediant, right_subtree becomes the leftmost subtree of the new node
+        node_relocate_entries(new_node, 0, node, t, t - 1);
+        node_relocate_subtrees(new_node, 1, node, t + 1, t - 1);
+        new_node->subtrees[0] = right_subtree;
+
+        new_node->virtual_size = t - 1;
+        node->virtual_size = t;
+
+        return std::make_pair(new_node, std::move(kvp));
     }
-    
-    for (size_t i = 0; i < t - 1; ++i)
+
+    // mediant may shift right after "insertion" of kvp, so if subtree_index < mediant_index,
+    // we take left neighbour of pre-insert mediant as post-insert mediant
+    if (subtree_index < mediant_index)
     {
-        allocator::construct(new_node->keys_and_values + i, std::move(node->keys_and_values[t + i]));
-        allocator::destruct(node->keys_and_values + t + i);
-        
-        std::swap(new_node->subtrees[1 + i], node->subtrees[t + 1 + i]);
+        node_relocate_entries(new_node, 0, node, t, t - 1);
+        node_relocate_subtrees(new_node, 0, node, t, t);
+        new_node->virtual_size = t - 1;
+
+        auto mediant = node_extract_entry(node, t - 1);
+        node->virtual_size = t - 1;
+        node_insert(node, std::move(kvp), subtree_index, right_subtree);
+
+        return std::make_pair(new_node, std::move(mediant));
     }
-    
-    new_node->subtrees[0] = right_subtree;
-    
-    new_node->virtual_size = t - 1;
+
+    auto mediant = node_extract_entry(node, t);
+    node_relocate_entries(new_node, 0, node, t + 1, t - 2);
+    node_relocate_subtrees(new_node, 0, node, t + 1, t - 1);
+    new_node->virtual_size = t - 2;
     node->virtual_size = t;
-    
-    return std::make_pair(new_node, std::move(kvp));
+    node_insert(new_node, std::move(kvp), subtree_index - t - 1, right_subtree);
+
+    return std::make_pair(new_node, std::move(mediant));
 }
 
 template<
     typename tkey,
-    typename tvalue>
-void search_tree<tkey, tvalue>::node_merge(
-    typename search_tree<tkey, tvalue>::common_node *parent,
+    typename tvalue,
+    typename tcomparer>
+void search_tree<tkey, tvalue, tcomparer>::node_merge(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *parent,
     size_t parent_index)
 {
     if (parent_index >= parent->virtual_size)
     {
         throw std::logic_error("invalid btree merge");
     }
-    
+
     auto *left_subtree = parent->subtrees[parent_index];
     auto *right_subtree = parent->subtrees[parent_index + 1];
-    
-    allocator::construct(left_subtree->keys_and_values + left_subtree->virtual_size, std::move(parent->keys_and_values[parent_index]));
+
+    node_relocate_entries(left_subtree, left_subtree->virtual_size, parent, parent_index, 1);
     ++left_subtree->virtual_size;
-    
-    for (size_t i = parent_index; i < parent->virtual_size; ++i)
+
+    node_relocate_entries(parent, parent_index, parent, parent_index + 1, parent->virtual_size - parent_index - 1);
+    node_relocate_subtrees(parent, parent_index + 1, parent, parent_index + 2, parent->virtual_size - parent_index - 1);
+    --parent->virtual_size;
+
+    node_relocate_entries(left_subtree, left_subtree->virtual_size, right_subtree, 0, right_subtree->virtual_size);
+    node_relocate_subtrees(left_subtree, left_subtree->virtual_size, right_subtree, 0, right_subtree->virtual_size + 1);
+    left_subtree->virtual_size += right_subtree->virtual_size;
+
+    right_subtree->virtual_size = 0;
+    destroy_node(right_subtree);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void search_tree<tkey, tvalue, tcomparer>::node_construct_entry(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *node,
+    size_t index,
+    typename associative_container<tkey, tvalue>::key_value_pair &&kvp)
+{
+    if constexpr (key_prefix_traits<tkey>::enabled)
     {
-        std::swap(parent->keys_and_values[i], parent->keys_and_values[i+1]);
-        std::swap(parent->subtrees[i+1], parent->subtrees[i+2]);
+        node->prefixes[index] = key_prefix_traits<tkey>::make(kvp.key);
     }
-    
-    --parent->virtual_size;
-    allocator::destruct(parent->keys_and_values + parent->virtual_size);
-    
-    for (size_t i = 0; i < right_subtree->virtual_size; ++i)
+
+    allocator::construct(node->keys + index, std::move(kvp.key));
+    allocator::construct(node->values + index, std::move(kvp.value));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename associative_container<tkey, tvalue>::key_value_pair search_tree<tkey, tvalue, tcomparer>::node_extract_entry(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *node,
+    size_t index)
+{
+    typename associative_container<tkey, tvalue>::key_value_pair kvp(
+        std::move(node->keys[index]), std::move(node->values[index]));
+    node_destruct_entry(node, index);
+
+    return kvp;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void search_tree<tkey, tvalue, tcomparer>::node_destruct_entry(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *node,
+    size_t index)
+{
+    allocator::destruct(node->keys + index);
+    allocator::destruct(node->values + index);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void search_tree<tkey, tvalue, tcomparer>::node_swap_entries(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *first,
+    size_t first_index,
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *second,
+    size_t second_index)
+{
+    if constexpr (key_prefix_traits<tkey>::enabled)
     {
-        allocator::construct(left_subtree->keys_and_values + left_subtree->virtual_size, std::move(right_subtree->keys_and_values[i]));
-        left_subtree->subtrees[left_subtree->virtual_size++] = right_subtree->subtrees[i];
+        std::swap(first->prefixes[first_index], second->prefixes[second_index]);
     }
-    left_subtree->subtrees[left_subtree->virtual_size] = right_subtree->subtrees[right_subtree->virtual_size];
-    
-    destroy_node(right_subtree);
+
+    relocation::swap(first->keys[first_index], second->keys[second_index]);
+    relocation::swap(first->values[first_index], second->values[second_index]);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void search_tree<tkey, tvalue, tcomparer>::node_relocate_entries(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *destination,
+    size_t destination_index,
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *source,
+    size_t source_index,
+    size_t count)
+{
+    if constexpr (key_prefix_traits<tkey>::enabled)
+    {
+        std::memmove(destination->prefixes + destination_index, source->prefixes + source_index, sizeof(key_prefix::type) * count);
+    }
+
+    relocation::relocate(destination->keys + destination_index, source->keys + source_index, count);
+    relocation::relocate(destination->values + destination_index, source->values + source_index, count);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void search_tree<tkey, tvalue, tcomparer>::node_relocate_subtrees(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *destination,
+    size_t destination_index,
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *source,
+    size_t source_index,
+    size_t count)
+{
+    std::memmove(destination->subtrees + destination_index, source->subtrees + source_index, sizeof(common_node *) * count);
 }
 
 #pragma endregion common node operations implementation
 
 template<
     typename tkey,
-    typename tvalue>
-std::stack<std::pair<typename search_tree<tkey, tvalue>::common_node **, int>> search_tree<tkey, tvalue>::find_path(
+    typename tvalue,
+    typename tcomparer>
+template<
+    size_t capacity>
+node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node **, int>> search_tree<tkey, tvalue, tcomparer>::find_path(
     tkey const &key)
 {
-    std::stack<std::pair<common_node**, int>> result;
+    node_path<std::pair<common_node**, int>> result;
     
     int index = -1;
     if (_root == nullptr)
@@ -527,7 +805,7 @@ std::stack<std::pair<typename search_tree<tkey, tvalue>::common_node **, int>> s
     common_node **iterator = reinterpret_cast<common_node**>(&_root);
     while (*iterator != nullptr && index < 0)
     {
-        index = node_find_path(*iterator, key, 0, (*iterator)->virtual_size - 1);
+        index = node_find_path<capacity>(*iterator, key, 0, (*iterator)->virtual_size - 1);
         result.push(std::make_pair(iterator, index));
         
         if (index < 0)
@@ -541,37 +819,213 @@ std::stack<std::pair<typename search_tree<tkey, tvalue>::common_node **, int>> s
 
 template<
     typename tkey,
-    typename tvalue>
-search_tree<tkey, tvalue>::search_tree(
-    std::function<int(tkey const &, tkey const &)> keys_comparer,
+    typename tvalue,
+    typename tcomparer>
+template<
+    size_t capacity>
+void search_tree<tkey, tvalue, tcomparer>::resume_path(
+    node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node**, int>> &path,
+    tkey const &key)
+{
+    if (path.empty())
+    {
+        path = find_path<capacity>(key);
+        return;
+    }
+
+    // greater keys than the last one of a node may still be in its subtree, rising above it is just safe
+    while (path.size() > 1 &&
+        _keys_comparer(key, (*path.top().first)->keys[(*path.top().first)->virtual_size - 1]) > 0)
+    {
+        path.pop();
+    }
+
+    common_node **iterator = path.top().first;
+    path.pop();
+
+    if (*iterator == nullptr)
+    {
+        path.emplace(iterator, -1);
+        return;
+    }
+
+    int index = -1;
+    while (*iterator != nullptr && index < 0)
+    {
+        index = node_find_path<capacity>(*iterator, key, 0, (*iterator)->virtual_size - 1);
+        path.emplace(iterator, index);
+
+        if (index < 0)
+        {
+            iterator = (*iterator)->subtrees - index - 1;
+        }
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+template<
+    typename tcomparer_target>
+bool search_tree<tkey, tvalue, tcomparer>::is_keys_comparer(
+    tcomparer const &keys_comparer) noexcept
+{
+    if constexpr (std::is_same_v<tcomparer, tcomparer_target>)
+    {
+        return true;
+    }
+    else if constexpr (std::is_same_v<tcomparer, type_erased_comparer>)
+    {
+        return keys_comparer.template target<tcomparer_target>() != nullptr;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+bool search_tree<tkey, tvalue, tcomparer>::is_native_keys_order(
+    tcomparer const &keys_comparer) noexcept
+{
+    if constexpr (std::is_arithmetic_v<tkey>)
+    {
+        return is_keys_comparer<typename associative_container<tkey, tvalue>::default_key_comparer>(keys_comparer);
+    }
+
+    return false;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+bool search_tree<tkey, tvalue, tcomparer>::is_prefixed_keys_order(
+    tcomparer const &keys_comparer) noexcept
+{
+    if constexpr (key_prefix_traits<tkey>::enabled)
+    {
+        return is_keys_comparer<typename key_prefix_traits<tkey>::comparer>(keys_comparer);
+    }
+
+    return false;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+[[nodiscard]] inline bool search_tree<tkey, tvalue, tcomparer>::native_keys_order() const noexcept
+{
+    if constexpr (std::is_same_v<tcomparer, type_erased_comparer>)
+    {
+        return _native_keys_order;
+    }
+    else
+    {
+        return std::is_arithmetic_v<tkey> &&
+            std::is_same_v<tcomparer, typename associative_container<tkey, tvalue>::default_key_comparer>;
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+[[nodiscard]] inline bool search_tree<tkey, tvalue, tcomparer>::prefixed_keys_order() const noexcept
+{
+    if constexpr (!key_prefix_traits<tkey>::enabled)
+    {
+        return false;
+    }
+    else if constexpr (std::is_same_v<tcomparer, type_erased_comparer>)
+    {
+        return _prefixed_keys_order;
+    }
+    else
+    {
+        return std::is_same_v<tcomparer, typename key_prefix_traits<tkey>::comparer>;
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+tcomparer search_tree<tkey, tvalue, tcomparer>::default_keys_comparer()
+{
+    if constexpr (std::is_constructible_v<tcomparer, typename associative_container<tkey, tvalue>::default_key_comparer>)
+    {
+        return tcomparer(typename associative_container<tkey, tvalue>::default_key_comparer());
+    }
+    else
+    {
+        return tcomparer();
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+search_tree<tkey, tvalue, tcomparer>::search_tree(
+    tcomparer keys_comparer,
     allocator *allocator,
     logger *logger):
         _keys_comparer(keys_comparer),
+        _native_keys_order(is_native_keys_order(_keys_comparer)),
+        _prefixed_keys_order(is_prefixed_keys_order(_keys_comparer)),
         _allocator(allocator),
         _logger(logger),
-        _root(nullptr)
+        _root(nullptr),
+        _nodes_slab(0, allocator)
 { }
 
 template<
     typename tkey,
-    typename tvalue>
-[[nodiscard]] inline allocator *search_tree<tkey, tvalue>::get_allocator() const
+    typename tvalue,
+    typename tcomparer>
+[[nodiscard]] size_t search_tree<tkey, tvalue, tcomparer>::get_live_nodes_count() const noexcept
+{
+    return _nodes_slab.get_live_blocks_count();
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+[[nodiscard]] size_t search_tree<tkey, tvalue, tcomparer>::get_cached_nodes_count() const noexcept
+{
+    return _nodes_slab.get_cached_blocks_count();
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+[[nodiscard]] inline allocator *search_tree<tkey, tvalue, tcomparer>::get_allocator() const
 {
     return _allocator;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-[[nodiscard]] inline logger *search_tree<tkey, tvalue>::get_logger() const
+    typename tvalue,
+    typename tcomparer>
+[[nodiscard]] inline logger *search_tree<tkey, tvalue, tcomparer>::get_logger() const
 {
     return _logger;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-inline std::string search_tree<tkey, tvalue>::get_typename() const noexcept
+    typename tvalue,
+    typename tcomparer>
+inline std::string search_tree<tkey, tvalue, tcomparer>::get_typename() const noexcept
 {
     return "search_tree<tkey, tvalue>";
 }
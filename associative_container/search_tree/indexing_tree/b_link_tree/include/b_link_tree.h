@@ -0,0 +1,1181 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_TEMPLATE_REPO_B_LINK_TREE_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_TEMPLATE_REPO_B_LINK_TREE_H
+
+#include <search_tree.h>
+
+#include <extra_utility.h>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+
+// Lehman-Yao B-link tree: every node knows the greatest key it may hold (high key) and its right sibling,
+// so a split publishes the new right half before its parent knows about it, and any operation that lands
+// on a node whose high key is below its search key just moves right. Readers latch one node at a time in
+// shared mode, writers latch exclusively only the nodes they change (leaf, then parents while splits
+// propagate). Entries live in leaves only; disposal does not rebalance, emptied nodes stay linked.
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer = std::function<int(tkey const &, tkey const &)>>
+class b_link_tree final : public search_tree<tkey, tvalue, tcomparer> {
+
+private:
+
+    struct b_link_node final
+    {
+
+    public:
+
+        mutable std::shared_mutex latch;
+
+        size_t const level; // 0 for leaves, immutable, so may be read without latch
+
+        size_t virtual_size;
+
+        bool has_high_key; // rightmost node of a level is unbounded
+
+        tkey *keys; // 2t keys, slot 2t is the high key
+
+        tvalue *values; // leaves only
+
+        b_link_node **subtrees; // internal nodes only, 2t + 1 subtrees
+
+        b_link_node *right_link;
+
+    public:
+
+        b_link_node(
+            size_t level,
+            tkey *keys,
+            tvalue *values,
+            b_link_node **subtrees);
+
+    public:
+
+        tkey &high_key() noexcept;
+
+    };
+
+public:
+
+    #pragma region iterators definition
+
+    // walks leaves through right links; not guarded against concurrent modification
+    class infix_iterator final
+    {
+
+        friend class b_link_tree<tkey, tvalue, tcomparer>;
+
+    public:
+
+        bool operator==(
+            infix_iterator const &other) const noexcept;
+
+        bool operator!=(
+            infix_iterator const &other) const noexcept;
+
+        infix_iterator &operator++();
+
+        infix_iterator operator++(
+            int not_used);
+
+        std::tuple<size_t, size_t, tkey const &, tvalue &> operator*() const;
+
+    private:
+
+        infix_iterator(
+            b_link_node *leaf,
+            size_t position,
+            size_t depth);
+
+    private:
+
+        void skip_empty_leaves() noexcept;
+
+    private:
+
+        b_link_node *_leaf;
+
+        size_t _position;
+
+        size_t _depth;
+
+    };
+
+    #pragma endregion iterators definition
+
+public:
+
+    #pragma region CRUD operations
+
+    void insert(
+        tkey const &key,
+        tvalue const &value) override;
+
+    void insert(
+        tkey const &key,
+        tvalue &&value) override;
+
+    void update(
+        tkey const &key,
+        tvalue const &value) override;
+
+    void update(
+        tkey const &key,
+        tvalue &&value) override;
+
+    tvalue &obtain(
+        tkey const &key) override;
+
+    tvalue dispose(
+        tkey const &key) override;
+
+    std::vector<typename associative_container<tkey, tvalue>::key_value_pair> obtain_between(
+        tkey const &lower_bound,
+        tkey const &upper_bound,
+        bool lower_bound_inclusive,
+        bool upper_bound_inclusive) override;
+
+    #pragma endregion CRUD operations
+
+public:
+
+    #pragma region BLinkTree constructors, assignments, destructor
+
+    explicit b_link_tree(
+        size_t t,
+        tcomparer keys_comparer = search_tree<tkey, tvalue, tcomparer>::default_keys_comparer(),
+        allocator *allocator = nullptr,
+        logger *logger = nullptr);
+
+    b_link_tree(
+        b_link_tree<tkey, tvalue, tcomparer> const &other);
+
+    b_link_tree<tkey, tvalue, tcomparer> &operator=(
+        b_link_tree<tkey, tvalue, tcomparer> const &other);
+
+    b_link_tree(
+        b_link_tree<tkey, tvalue, tcomparer> &&other) noexcept;
+
+    b_link_tree<tkey, tvalue, tcomparer> &operator=(
+        b_link_tree<tkey, tvalue, tcomparer> &&other) noexcept;
+
+    ~b_link_tree() noexcept override;
+
+    #pragma endregion BLinkTree constructors, assignments, destructor
+
+public:
+
+    #pragma region iterators requesting
+
+    infix_iterator begin_infix() const noexcept;
+
+    infix_iterator end_infix() const noexcept;
+
+    // emptied leaves are not merged away, so the greatest key is found by a walk over the leaves
+    infix_iterator last_infix() const noexcept;
+
+    #pragma endregion iterators requesting
+
+public:
+
+    size_t get_t() const noexcept;
+
+private:
+
+    size_t _t;
+
+    std::atomic<b_link_node *> _root_node; // nullptr while nothing was inserted
+
+    std::mutex _root_mutex; // serializes root creation and root splits only
+
+private:
+
+    #pragma region node operations
+
+    b_link_node *create_node(
+        size_t level);
+
+    void destroy_node(
+        b_link_node *node) noexcept;
+
+    int compare_keys(
+        tkey const &first,
+        tkey const &second) const;
+
+    bool node_covers(
+        b_link_node const *node,
+        tkey const &key) const;
+
+    size_t node_lower_bound(
+        b_link_node const *node,
+        tkey const &key) const;
+
+    void node_insert_key(
+        b_link_node *node,
+        size_t index,
+        tkey &&key);
+
+    std::pair<b_link_node *, tkey> node_split(
+        b_link_node *node);
+
+    #pragma endregion node operations
+
+private:
+
+    #pragma region descent
+
+    b_link_node *obtain_root();
+
+    b_link_node *find_leaf_shared(
+        tkey const &key,
+        std::shared_lock<std::shared_mutex> &leaf_lock) const;
+
+    b_link_node *find_leaf_exclusive(
+        tkey const &key,
+        std::vector<b_link_node *> &ancestors,
+        std::unique_lock<std::shared_mutex> &leaf_lock);
+
+    b_link_node *find_node_at_level(
+        tkey const &key,
+        size_t level) const;
+
+    template<
+        typename tlock>
+    static b_link_node *move_right(
+        b_link_node *node,
+        tkey const &key,
+        tlock &lock,
+        b_link_tree<tkey, tvalue, tcomparer> const *tree);
+
+    #pragma endregion descent
+
+private:
+
+    void insert_inner(
+        typename associative_container<tkey, tvalue>::key_value_pair &&kvp,
+        bool is_update);
+
+    void insert_into_parents(
+        b_link_node *node,
+        std::vector<b_link_node *> &ancestors,
+        std::unique_lock<std::shared_mutex> &node_lock);
+
+    void copy_from(
+        b_link_tree<tkey, tvalue, tcomparer> const &other);
+
+    void clear() noexcept;
+
+private:
+
+    inline std::string get_typename() const noexcept override;
+
+};
+
+#pragma region b_link node implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+b_link_tree<tkey, tvalue, tcomparer>::b_link_node::b_link_node(
+    size_t level,
+    tkey *keys,
+    tvalue *values,
+    b_link_node **subtrees):
+        level(level),
+        virtual_size(0),
+        has_high_key(false),
+        keys(keys),
+        values(values),
+        subtrees(subtrees),
+        right_link(nullptr)
+{ }
+
+#pragma endregion b_link node implementation
+
+#pragma region infix iterator implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+b_link_tree<tkey, tvalue, tcomparer>::infix_iterator::infix_iterator(
+    b_link_node *leaf,
+    size_t position,
+    size_t depth):
+        _leaf(leaf),
+        _position(position),
+        _depth(depth)
+{
+    skip_empty_leaves();
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+bool b_link_tree<tkey, tvalue, tcomparer>::infix_iterator::operator==(
+    infix_iterator const &other) const noexcept
+{
+    return _leaf == other._leaf && (_leaf == nullptr || _position == other._position);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+bool b_link_tree<tkey, tvalue, tcomparer>::infix_iterator::operator!=(
+    infix_iterator const &other) const noexcept
+{
+    return !(*this == other);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename b_link_tree<tkey, tvalue, tcomparer>::infix_iterator &b_link_tree<tkey, tvalue, tcomparer>::infix_iterator::operator++()
+{
+    if (_leaf != nullptr)
+    {
+        ++_position;
+        skip_empty_leaves();
+    }
+
+    return *this;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename b_link_tree<tkey, tvalue, tcomparer>::infix_iterator b_link_tree<tkey, tvalue, tcomparer>::infix_iterator::operator++(
+    int not_used)
+{
+    auto previous = *this;
+    ++*this;
+    return previous;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+std::tuple<size_t, size_t, tkey const &, tvalue &> b_link_tree<tkey, tvalue, tcomparer>::infix_iterator::operator*() const
+{
+    return std::tuple<size_t, size_t, tkey const &, tvalue &>(_depth, _position, _leaf->keys[_position], _leaf->values[_position]);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void b_link_tree<tkey, tvalue, tcomparer>::infix_iterator::skip_empty_leaves() noexcept
+{
+    while (_leaf != nullptr && _position >= _leaf->virtual_size)
+    {
+        _leaf = _leaf->right_link;
+        _position = 0;
+    }
+}
+
+#pragma endregion infix iterator implementation
+
+#pragma region BLinkTree CRUD implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void b_link_tree<tkey, tvalue, tcomparer>::insert(
+    tkey const &key,
+    tvalue const &value)
+{
+    insert_inner(typename associative_container<tkey, tvalue>::key_value_pair(key, value), false);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void b_link_tree<tkey, tvalue, tcomparer>::insert(
+    tkey const &key,
+    tvalue &&value)
+{
+    insert_inner(typename associative_container<tkey, tvalue>::key_value_pair(key, std::move(value)), false);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void b_link_tree<tkey, tvalue, tcomparer>::update(
+    tkey const &key,
+    tvalue const &value)
+{
+    insert_inner(typename associative_container<tkey, tvalue>::key_value_pair(key, value), true);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void b_link_tree<tkey, tvalue, tcomparer>::update(
+    tkey const &key,
+    tvalue &&value)
+{
+    insert_inner(typename associative_container<tkey, tvalue>::key_value_pair(key, std::move(value)), true);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+tvalue &b_link_tree<tkey, tvalue, tcomparer>::obtain(
+    tkey const &key)
+{
+    std::shared_lock<std::shared_mutex> leaf_lock;
+    b_link_node *leaf = find_leaf_shared(key, leaf_lock);
+
+    if (leaf != nullptr)
+    {
+        size_t const index = node_lower_bound(leaf, key);
+        if (index < leaf->virtual_size && compare_keys(key, leaf->keys[index]) == 0)
+        {
+            return leaf->values[index];
+        }
+    }
+
+    this->error_with_guard([&]() { return get_typename() + "::obtain(tkey const &) : key \"" +
+        extra_utility::make_string(key) + "\" is not present in container."; });
+    throw typename search_tree<tkey, tvalue, tcomparer>::obtaining_of_nonexistent_key_attempt_exception(key);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+tvalue b_link_tree<tkey, tvalue, tcomparer>::dispose(
+    tkey const &key)
+{
+    std::vector<b_link_node *> ancestors;
+    std::unique_lock<std::shared_mutex> leaf_lock;
+    b_link_node *leaf = find_leaf_exclusive(key, ancestors, leaf_lock);
+
+    size_t const index = leaf == nullptr ? 0 : node_lower_bound(leaf, key);
+    if (leaf == nullptr || index >= leaf->virtual_size || compare_keys(key, leaf->keys[index]) != 0)
+    {
+        this->error_with_guard([&]() { return get_typename() + "::dispose(tkey const &) : key \"" +
+            extra_utility::make_string(key) + "\" is not present in container."; });
+        throw typename search_tree<tkey, tvalue, tcomparer>::disposal_of_nonexistent_key_attempt_exception(key);
+    }
+
+    tvalue value = std::move(leaf->values[index]);
+
+    allocator::destruct(leaf->keys + index);
+    allocator::destruct(leaf->values + index);
+    relocation::close_gap(leaf->keys, leaf->virtual_size, index);
+    relocation::close_gap(leaf->values, leaf->virtual_size, index);
+    --leaf->virtual_size;
+
+    return value;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+std::vector<typename associative_container<tkey, tvalue>::key_value_pair> b_link_tree<tkey, tvalue, tcomparer>::obtain_between(
+    tkey const &lower_bound,
+    tkey const &upper_bound,
+    bool lower_bound_inclusive,
+    bool upper_bound_inclusive)
+{
+    std::vector<typename associative_container<tkey, tvalue>::key_value_pair> range;
+
+    std::shared_lock<std::shared_mutex> leaf_lock;
+    b_link_node *leaf = find_leaf_shared(lower_bound, leaf_lock);
+    size_t index = leaf == nullptr ? 0 : node_lower_bound(leaf, lower_bound);
+
+    // leaves are latched left to right, the next one before the current one is released
+    while (leaf != nullptr)
+    {
+        for (; index < leaf->virtual_size; ++index)
+        {
+            if (!lower_bound_inclusive && compare_keys(leaf->keys[index], lower_bound) == 0)
+            {
+                continue;
+            }
+
+            if (compare_keys(leaf->keys[index], upper_bound) >= (upper_bound_inclusive ? 1 : 0))
+            {
+                return range;
+            }
+
+            range.emplace_back(leaf->keys[index], leaf->values[index]);
+        }
+
+        b_link_node *right = leaf->right_link;
+        if (right == nullptr)
+        {
+            break;
+        }
+
+        std::shared_lock<std::shared_mutex> right_lock(right->latch);
+        leaf_lock.swap(right_lock);
+        leaf = right;
+        index = 0;
+    }
+
+    return range;
+}
+
+#pragma endregion BLinkTree CRUD implementation
+
+#pragma region BLinkTree construction, assignment, destruction implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+b_link_tree<tkey, tvalue, tcomparer>::b_link_tree(
+    size_t t,
+    tcomparer keys_comparer,
+    allocator *allocator,
+    logger *logger):
+        search_tree<tkey, tvalue, tcomparer>(keys_comparer, allocator, logger),
+        _t(t),
+        _root_node(nullptr)
+{
+    if (t < 2)
+    {
+        throw std::logic_error("parameter t must be not less than 2");
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+b_link_tree<tkey, tvalue, tcomparer>::b_link_tree(
+    b_link_tree<tkey, tvalue, tcomparer> const &other):
+        search_tree<tkey, tvalue, tcomparer>(other._keys_comparer, other._allocator, other._logger),
+        _t(other._t),
+        _root_node(nullptr)
+{
+    try
+    {
+        copy_from(other);
+    }
+    catch (...)
+    {
+        clear();
+        throw;
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+b_link_tree<tkey, tvalue, tcomparer> &b_link_tree<tkey, tvalue, tcomparer>::operator=(
+    b_link_tree<tkey, tvalue, tcomparer> const &other)
+{
+    if (this != &other)
+    {
+        clear();
+
+        this->_keys_comparer = other._keys_comparer;
+        this->_native_keys_order = other._native_keys_order;
+        this->_prefixed_keys_order = other._prefixed_keys_order;
+        this->_allocator = other._allocator;
+        this->_logger = other._logger;
+        _t = other._t;
+
+        copy_from(other);
+    }
+
+    return *this;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+b_link_tree<tkey, tvalue, tcomparer>::b_link_tree(
+    b_link_tree<tkey, tvalue, tcomparer> &&other) noexcept:
+        search_tree<tkey, tvalue, tcomparer>(other._keys_comparer, other._allocator, other._logger),
+        _t(other._t),
+        _root_node(other._root_node.exchange(nullptr))
+{ }
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+b_link_tree<tkey, tvalue, tcomparer> &b_link_tree<tkey, tvalue, tcomparer>::operator=(
+    b_link_tree<tkey, tvalue, tcomparer> &&other) noexcept
+{
+    if (this != &other)
+    {
+        clear();
+
+        this->_keys_comparer = std::move(other._keys_comparer);
+        this->_native_keys_order = other._native_keys_order;
+        this->_prefixed_keys_order = other._prefixed_keys_order;
+        this->_allocator = other._allocator;
+        this->_logger = other._logger;
+        _t = other._t;
+        _root_node.store(other._root_node.exchange(nullptr));
+    }
+
+    return *this;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+b_link_tree<tkey, tvalue, tcomparer>::~b_link_tree() noexcept
+{
+    clear();
+}
+
+#pragma endregion BLinkTree construction, assignment, destruction implementation
+
+#pragma region iterators requesting implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename b_link_tree<tkey, tvalue, tcomparer>::infix_iterator b_link_tree<tkey, tvalue, tcomparer>::begin_infix() const noexcept
+{
+    b_link_node *node = _root_node.load(std::memory_order_acquire);
+    if (node == nullptr)
+    {
+        return end_infix();
+    }
+
+    size_t const depth = node->level;
+    while (node->level != 0)
+    {
+        node = node->subtrees[0];
+    }
+
+    return infix_iterator(node, 0, depth);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename b_link_tree<tkey, tvalue, tcomparer>::infix_iterator b_link_tree<tkey, tvalue, tcomparer>::end_infix() const noexcept
+{
+    return infix_iterator(nullptr, 0, 0);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename b_link_tree<tkey, tvalue, tcomparer>::infix_iterator b_link_tree<tkey, tvalue, tcomparer>::last_infix() const noexcept
+{
+    auto last = end_infix();
+
+    for (auto iter = begin_infix(); iter != end_infix(); ++iter)
+    {
+        last = iter;
+    }
+
+    return last;
+}
+
+#pragma endregion iterators requesting implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+size_t b_link_tree<tkey, tvalue, tcomparer>::get_t() const noexcept
+{
+    return _t;
+}
+
+#pragma region node operations implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+tkey &b_link_tree<tkey, tvalue, tcomparer>::b_link_node::high_key() noexcept
+{
+    return keys[-1];
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename b_link_tree<tkey, tvalue, tcomparer>::b_link_node *b_link_tree<tkey, tvalue, tcomparer>::create_node(
+    size_t level)
+{
+    // high key slot goes right before keys, so keys[-1] addresses it
+    size_t const high_key_offset = node_slab::align_up(sizeof(b_link_node), alignof(tkey));
+    size_t const keys_offset = high_key_offset + sizeof(tkey);
+    size_t const values_offset = node_slab::align_up(keys_offset + sizeof(tkey) * 2 * _t, alignof(tvalue));
+    size_t const subtrees_offset = node_slab::align_up(
+        values_offset + (level == 0 ? sizeof(tvalue) * 2 * _t : 0), alignof(b_link_node *));
+    size_t const block_size = subtrees_offset + (level == 0 ? 0 : sizeof(b_link_node *) * (2 * _t + 1));
+
+    auto *block = reinterpret_cast<unsigned char *>(this->allocate_with_guard(1, block_size));
+    auto *node = reinterpret_cast<b_link_node *>(block);
+
+    allocator::construct(node, level,
+        reinterpret_cast<tkey *>(block + keys_offset),
+        level == 0 ? reinterpret_cast<tvalue *>(block + values_offset) : nullptr,
+        level == 0 ? nullptr : reinterpret_cast<b_link_node **>(block + subtrees_offset));
+
+    return node;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void b_link_tree<tkey, tvalue, tcomparer>::destroy_node(
+    b_link_node *node) noexcept
+{
+    for (size_t i = 0; i < node->virtual_size; ++i)
+    {
+        allocator::destruct(node->keys + i);
+        if (node->level == 0)
+        {
+            allocator::destruct(node->values + i);
+        }
+    }
+
+    if (node->has_high_key)
+    {
+        allocator::destruct(&node->high_key());
+    }
+
+    allocator::destruct(node);
+    this->deallocate_with_guard(node);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+int b_link_tree<tkey, tvalue, tcomparer>::compare_keys(
+    tkey const &first,
+    tkey const &second) const
+{
+    return this->_keys_comparer(first, second);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+bool b_link_tree<tkey, tvalue, tcomparer>::node_covers(
+    b_link_node const *node,
+    tkey const &key) const
+{
+    return !node->has_high_key || compare_keys(key, node->keys[-1]) <= 0;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+size_t b_link_tree<tkey, tvalue, tcomparer>::node_lower_bound(
+    b_link_node const *node,
+    tkey const &key) const
+{
+    if constexpr (std::is_arithmetic_v<tkey>)
+    {
+        if (this->native_keys_order())
+        {
+            return node_keys_search::lower_bound(node->keys, node->virtual_size, key);
+        }
+    }
+
+    size_t left = 0;
+    size_t right = node->virtual_size;
+    while (left < right)
+    {
+        size_t const middle = (left + right) / 2;
+        if (compare_keys(node->keys[middle], key) < 0)
+        {
+            left = middle + 1;
+        }
+        else
+        {
+            right = middle;
+        }
+    }
+
+    return left;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void b_link_tree<tkey, tvalue, tcomparer>::node_insert_key(
+    b_link_node *node,
+    size_t index,
+    tkey &&key)
+{
+    relocation::open_gap(node->keys, node->virtual_size, index);
+    allocator::construct(node->keys + index, std::move(key));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+std::pair<typename b_link_tree<tkey, tvalue, tcomparer>::b_link_node *, tkey> b_link_tree<tkey, tvalue, tcomparer>::node_split(
+    b_link_node *node)
+{
+    b_link_node *right = create_node(node->level);
+
+    // leaf keeps [0, t) and gives its last key as separator copy;
+    // internal node keeps [0, t - 1) with t subtrees and hands key t - 1 up
+    size_t const left_size = node->level == 0 ? _t : _t - 1;
+    size_t const right_begin = _t;
+
+    relocation::relocate(right->keys, node->keys + right_begin, node->virtual_size - right_begin);
+    if (node->level == 0)
+    {
+        relocation::relocate(right->values, node->values + right_begin, node->virtual_size - right_begin);
+    }
+
+    if (node->level != 0)
+    {
+        for (size_t i = right_begin; i <= node->virtual_size; ++i)
+        {
+            right->subtrees[i - right_begin] = node->subtrees[i];
+        }
+    }
+
+    right->virtual_size = node->virtual_size - right_begin;
+
+    if (node->has_high_key)
+    {
+        allocator::construct(&right->high_key(), std::move(node->high_key()));
+        right->has_high_key = true;
+        allocator::destruct(&node->high_key());
+    }
+
+    tkey separator = node->keys[_t - 1];
+    if (node->level != 0)
+    {
+        allocator::destruct(node->keys + _t - 1);
+    }
+
+    allocator::construct(&node->high_key(), separator);
+    node->has_high_key = true;
+    node->virtual_size = left_size;
+
+    right->right_link = node->right_link;
+    node->right_link = right;
+
+    return std::make_pair(right, std::move(separator));
+}
+
+#pragma endregion node operations implementation
+
+#pragma region descent implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename b_link_tree<tkey, tvalue, tcomparer>::b_link_node *b_link_tree<tkey, tvalue, tcomparer>::obtain_root()
+{
+    b_link_node *root = _root_node.load(std::memory_order_acquire);
+    if (root != nullptr)
+    {
+        return root;
+    }
+
+    std::lock_guard<std::mutex> root_lock(_root_mutex);
+
+    root = _root_node.load(std::memory_order_acquire);
+    if (root == nullptr)
+    {
+        root = create_node(0);
+        _root_node.store(root, std::memory_order_release);
+    }
+
+    return root;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+template<
+    typename tlock>
+typename b_link_tree<tkey, tvalue, tcomparer>::b_link_node *b_link_tree<tkey, tvalue, tcomparer>::move_right(
+    b_link_node *node,
+    tkey const &key,
+    tlock &lock,
+    b_link_tree<tkey, tvalue, tcomparer> const *tree)
+{
+    while (!tree->node_covers(node, key))
+    {
+        b_link_node *right = node->right_link;
+        tlock right_lock(right->latch);
+        lock.swap(right_lock);
+        node = right;
+    }
+
+    return node;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename b_link_tree<tkey, tvalue, tcomparer>::b_link_node *b_link_tree<tkey, tvalue, tcomparer>::find_leaf_shared(
+    tkey const &key,
+    std::shared_lock<std::shared_mutex> &leaf_lock) const
+{
+    b_link_node *node = _root_node.load(std::memory_order_acquire);
+    if (node == nullptr)
+    {
+        return nullptr;
+    }
+
+    leaf_lock = std::shared_lock<std::shared_mutex>(node->latch);
+
+    while (true)
+    {
+        node = move_right(node, key, leaf_lock, this);
+        if (node->level == 0)
+        {
+            return node;
+        }
+
+        // parent is released before child is latched: writers latch bottom-up, coupling here would deadlock
+        // with a split waiting for this parent, and a child split meanwhile is caught by moving right
+        b_link_node *child = node->subtrees[node_lower_bound(node, key)];
+        leaf_lock.unlock();
+        leaf_lock = std::shared_lock<std::shared_mutex>(child->latch);
+        node = child;
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename b_link_tree<tkey, tvalue, tcomparer>::b_link_node *b_link_tree<tkey, tvalue, tcomparer>::find_leaf_exclusive(
+    tkey const &key,
+    std::vector<b_link_node *> &ancestors,
+    std::unique_lock<std::shared_mutex> &leaf_lock)
+{
+    b_link_node *node = obtain_root();
+
+    // internal nodes are only read on the way down; the node seen at each level is remembered
+    // as a starting point for separator insertion, moving right from it is always safe
+    while (node->level != 0)
+    {
+        b_link_node *child;
+        {
+            std::shared_lock<std::shared_mutex> node_lock(node->latch);
+            node = move_right(node, key, node_lock, this);
+            child = node->subtrees[node_lower_bound(node, key)];
+        }
+
+        ancestors.push_back(node);
+        node = child;
+    }
+
+    leaf_lock = std::unique_lock<std::shared_mutex>(node->latch);
+
+    return move_right(node, key, leaf_lock, this);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename b_link_tree<tkey, tvalue, tcomparer>::b_link_node *b_link_tree<tkey, tvalue, tcomparer>::find_node_at_level(
+    tkey const &key,
+    size_t level) const
+{
+    b_link_node *node = _root_node.load(std::memory_order_acquire);
+
+    while (node->level > level)
+    {
+        std::shared_lock<std::shared_mutex> node_lock(node->latch);
+        node = move_right(node, key, node_lock, this);
+        node = node->subtrees[node_lower_bound(node, key)];
+    }
+
+    return node;
+}
+
+#pragma endregion descent implementation
+
+#pragma region BLinkTree modification implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void b_link_tree<tkey, tvalue, tcomparer>::insert_inner(
+    typename associative_container<tkey, tvalue>::key_value_pair &&kvp,
+    bool is_update)
+{
+    std::vector<b_link_node *> ancestors;
+    std::unique_lock<std::shared_mutex> leaf_lock;
+    b_link_node *leaf = find_leaf_exclusive(kvp.key, ancestors, leaf_lock);
+
+    size_t const index = node_lower_bound(leaf, kvp.key);
+    bool const key_exists = index < leaf->virtual_size && compare_keys(kvp.key, leaf->keys[index]) == 0;
+
+    if (is_update)
+    {
+        if (!key_exists)
+        {
+            this->error_with_guard([&]() { return get_typename() + "::update(tkey const &, tvalue &&) : key \"" +
+                extra_utility::make_string(kvp.key) + "\" is not present in container."; });
+            throw typename search_tree<tkey, tvalue, tcomparer>::updating_of_nonexistent_key_attempt_exception(kvp.key);
+        }
+
+        leaf->values[index] = std::move(kvp.value);
+        return;
+    }
+
+    if (key_exists)
+    {
+        this->error_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue &&) : key \"" +
+            extra_utility::make_string(kvp.key) + "\" is already present in container."; });
+        throw typename search_tree<tkey, tvalue, tcomparer>::insertion_of_existent_key_attempt_exception_exception(kvp.key);
+    }
+
+    relocation::open_gap(leaf->values, leaf->virtual_size, index);
+    allocator::construct(leaf->values + index, std::move(kvp.value));
+    node_insert_key(leaf, index, std::move(kvp.key));
+    ++leaf->virtual_size;
+
+    if (leaf->virtual_size == 2 * _t)
+    {
+        insert_into_parents(leaf, ancestors, leaf_lock);
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void b_link_tree<tkey, tvalue, tcomparer>::insert_into_parents(
+    b_link_node *node,
+    std::vector<b_link_node *> &ancestors,
+    std::unique_lock<std::shared_mutex> &node_lock)
+{
+    while (node->virtual_size == 2 * _t)
+    {
+        auto [right, separator] = node_split(node);
+
+        b_link_node *parent = nullptr;
+        if (!ancestors.empty())
+        {
+            parent = ancestors.back();
+            ancestors.pop_back();
+        }
+        else
+        {
+            {
+                std::lock_guard<std::mutex> root_lock(_root_mutex);
+
+                if (_root_node.load(std::memory_order_acquire) == node)
+                {
+                    b_link_node *new_root = create_node(node->level + 1);
+                    allocator::construct(new_root->keys, std::move(separator));
+                    new_root->subtrees[0] = node;
+                    new_root->subtrees[1] = right;
+                    new_root->virtual_size = 1;
+
+                    _root_node.store(new_root, std::memory_order_release);
+                    return;
+                }
+            }
+
+            // the root was split by someone else after this node was reached, its parent level exists now
+            parent = find_node_at_level(separator, node->level + 1);
+        }
+
+        std::unique_lock<std::shared_mutex> parent_lock(parent->latch);
+        parent = move_right(parent, separator, parent_lock, this);
+        node_lock = std::move(parent_lock);
+
+        size_t const index = node_lower_bound(parent, separator);
+        node_insert_key(parent, index, std::move(separator));
+        for (size_t i = parent->virtual_size + 1; i > index + 1; --i)
+        {
+            parent->subtrees[i] = parent->subtrees[i - 1];
+        }
+        parent->subtrees[index + 1] = right;
+        ++parent->virtual_size;
+
+        node = parent;
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void b_link_tree<tkey, tvalue, tcomparer>::copy_from(
+    b_link_tree<tkey, tvalue, tcomparer> const &other)
+{
+    for (auto iter = other.begin_infix(); iter != other.end_infix(); ++iter)
+    {
+        insert(std::get<2>(*iter), std::get<3>(*iter));
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void b_link_tree<tkey, tvalue, tcomparer>::clear() noexcept
+{
+    b_link_node *level_head = _root_node.exchange(nullptr);
+
+    // every node is reachable through right links from the leftmost node of its level
+    while (level_head != nullptr)
+    {
+        b_link_node *next_level_head = level_head->level == 0 ? nullptr : level_head->subtrees[0];
+
+        while (level_head != nullptr)
+        {
+            b_link_node *right = level_head->right_link;
+            destroy_node(level_head);
+            level_head = right;
+        }
+
+        level_head = next_level_head;
+    }
+}
+
+#pragma endregion BLinkTree modification implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+inline std::string b_link_tree<tkey, tvalue, tcomparer>::get_typename() const noexcept
+{
+    return "b_link_tree<tkey, tvalue>";
+}
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_TEMPLATE_REPO_B_LINK_TREE_H
@@ -0,0 +1,289 @@
+#include <gtest/gtest.h>
+
+#include <b_link_tree.h>
+
+#include <atomic>
+#include <iterator>
+#include <map>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+    using tree_type = b_link_tree<int, int>;
+
+    // walks leaves through right links: every entry is met once in keys order, all of them at the same depth
+    void expect_same(
+        tree_type const &tree,
+        std::map<int, int> const &expected)
+    {
+        auto forward = expected.begin();
+
+        for (auto iter = tree.begin_infix(); iter != tree.end_infix(); ++iter, ++forward)
+        {
+            ASSERT_NE(forward, expected.end());
+            ASSERT_EQ(std::get<2>(*iter), forward->first);
+            ASSERT_EQ(std::get<3>(*iter), forward->second);
+            ASSERT_EQ(std::get<0>(*iter), std::get<0>(*tree.begin_infix()));
+        }
+        EXPECT_EQ(forward, expected.end());
+
+        if (expected.empty())
+        {
+            EXPECT_EQ(tree.last_infix(), tree.end_infix());
+            return;
+        }
+
+        ASSERT_NE(tree.last_infix(), tree.end_infix());
+        EXPECT_EQ(std::get<2>(*tree.last_infix()), expected.rbegin()->first);
+    }
+
+}
+
+TEST(b_link_tree, random_operations_match_map)
+{
+    for (size_t t : { 2, 3, 8 })
+    {
+        std::map<int, int> expected;
+        std::mt19937 random(static_cast<unsigned>(t));
+        tree_type tree(t);
+
+        for (int i = 0; i < 20000; ++i)
+        {
+            int const key = static_cast<int>(random() % 3000);
+
+            switch (random() % 4)
+            {
+            case 0:
+            case 1:
+                if (expected.emplace(key, i).second)
+                {
+                    tree.insert(key, int(i));
+                }
+                else
+                {
+                    EXPECT_THROW(tree.insert(key, int(i)), tree_type::insertion_of_existent_key_attempt_exception_exception);
+                }
+                break;
+            case 2:
+                if (expected.count(key) != 0)
+                {
+                    tree.update(key, int(i));
+                    expected[key] = i;
+                }
+                else
+                {
+                    EXPECT_THROW(tree.update(key, int(i)), tree_type::updating_of_nonexistent_key_attempt_exception);
+                }
+                break;
+            default:
+                if (expected.count(key) != 0)
+                {
+                    ASSERT_EQ(tree.dispose(key), expected[key]);
+                    expected.erase(key);
+                }
+                else
+                {
+                    EXPECT_THROW(tree.dispose(key), tree_type::disposal_of_nonexistent_key_attempt_exception);
+                }
+                break;
+            }
+        }
+
+        expect_same(tree, expected);
+
+        for (int key = 0; key < 3000; key += 7)
+        {
+            auto found = expected.find(key);
+
+            if (found == expected.end())
+            {
+                EXPECT_THROW(tree.obtain(key), tree_type::obtaining_of_nonexistent_key_attempt_exception);
+                continue;
+            }
+
+            EXPECT_EQ(tree.obtain(key), found->second);
+        }
+    }
+}
+
+TEST(b_link_tree, emptied_leaves_are_skipped)
+{
+    std::map<int, int> expected;
+    tree_type tree(2);
+
+    for (int i = 0; i < 3000; ++i)
+    {
+        tree.insert(i, int(i));
+        expected.emplace(i, i);
+    }
+
+    // whole leaves at both ends and in the middle are emptied, but stay linked
+    for (int i = 0; i < 3000; ++i)
+    {
+        if (i < 500 || (i >= 1200 && i < 2000) || i >= 2600)
+        {
+            ASSERT_EQ(tree.dispose(i), i);
+            expected.erase(i);
+        }
+    }
+
+    expect_same(tree, expected);
+
+    for (auto [lower_bound, upper_bound] : { std::pair(0, 700), std::pair(1100, 2100), std::pair(2500, 3000) })
+    {
+        auto const entries = tree.obtain_between(lower_bound, upper_bound, true, false);
+        auto first = expected.lower_bound(lower_bound);
+        auto const last = expected.lower_bound(upper_bound);
+
+        ASSERT_EQ(entries.size(), static_cast<size_t>(std::distance(first, last)));
+        for (auto const &entry : entries)
+        {
+            EXPECT_EQ(entry.key, first->first);
+            ++first;
+        }
+    }
+
+    for (int i = 0; i < 3000; ++i)
+    {
+        if (expected.count(i) != 0)
+        {
+            tree.dispose(i);
+        }
+    }
+    expected.clear();
+    expect_same(tree, expected);
+
+    tree.insert(1500, 1);
+    expected.emplace(1500, 1);
+    expect_same(tree, expected);
+}
+
+TEST(b_link_tree, concurrent_insertions_lose_nothing)
+{
+    size_t constexpr writers_count = 8;
+    int constexpr keys_per_writer = 5000;
+    tree_type tree(3);
+    std::vector<std::thread> writers;
+
+    // keys of writers interleave, so they split the same leaves
+    for (size_t writer = 0; writer < writers_count; ++writer)
+    {
+        writers.emplace_back([&tree, writer]()
+        {
+            for (int i = 0; i < keys_per_writer; ++i)
+            {
+                int const key = i * static_cast<int>(writers_count) + static_cast<int>(writer);
+                tree.insert(key, -key);
+            }
+        });
+    }
+
+    for (auto &writer : writers)
+    {
+        writer.join();
+    }
+
+    std::map<int, int> expected;
+    for (int key = 0; key < keys_per_writer * static_cast<int>(writers_count); ++key)
+    {
+        expected.emplace(key, -key);
+    }
+
+    expect_same(tree, expected);
+}
+
+TEST(b_link_tree, readers_see_present_keys_during_splits)
+{
+    int constexpr present_keys_count = 2000;
+    tree_type tree(2);
+
+    for (int key = 0; key < present_keys_count; ++key)
+    {
+        tree.insert(key * 2, key);
+    }
+
+    std::atomic<bool> is_writing(true);
+    std::atomic<size_t> misses_count(0);
+    std::vector<std::thread> readers;
+
+    for (int reader = 0; reader < 4; ++reader)
+    {
+        readers.emplace_back([&, reader]()
+        {
+            std::mt19937 random(static_cast<unsigned>(reader));
+
+            while (is_writing.load())
+            {
+                int const key = static_cast<int>(random() % present_keys_count);
+
+                // value is behind reference, which obtain gives without latch, so only presence is checked here
+                try
+                {
+                    tree.obtain(key * 2);
+                }
+                catch (tree_type::obtaining_of_nonexistent_key_attempt_exception const &)
+                {
+                    ++misses_count;
+                }
+            }
+        });
+    }
+
+    // odd keys go between present ones, so their leaves and parents keep splitting under readers
+    for (int key = 0; key < present_keys_count; ++key)
+    {
+        tree.insert(key * 2 + 1, key);
+    }
+    is_writing.store(false);
+
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(misses_count.load(), 0u);
+
+    std::map<int, int> expected;
+    for (int key = 0; key < present_keys_count * 2; ++key)
+    {
+        expected.emplace(key, key / 2);
+    }
+
+    expect_same(tree, expected);
+}
+
+TEST(b_link_tree, copy_and_move_keep_entries)
+{
+    std::map<int, int> expected;
+    tree_type tree(3);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        tree.insert(i, int(i));
+        expected.emplace(i, i);
+    }
+
+    tree_type copied(tree);
+    copied.dispose(0);
+    expect_same(tree, expected);
+
+    tree_type moved(std::move(copied));
+    expected.erase(0);
+    expect_same(moved, expected);
+
+    tree = moved;
+    expect_same(tree, expected);
+
+    tree_type assigned(2);
+    assigned = std::move(moved);
+    expect_same(assigned, expected);
+}
+
+TEST(b_link_tree, order_less_than_two_is_rejected)
+{
+    EXPECT_THROW(tree_type tree(1), std::logic_error);
+}
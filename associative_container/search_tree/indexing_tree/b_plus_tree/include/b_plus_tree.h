@@ -0,0 +1,1432 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_TEMPLATE_REPO_B_PLUS_TREE_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_TEMPLATE_REPO_B_PLUS_TREE_H
+
+#include <search_tree.h>
+
+#include <extra_utility.h>
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
+
+// B+ tree: entries live in leaves only, internal nodes hold separators (the least key of the right subtree
+// at the time it was split off) and subtrees, so they take no values and branch wider than leaves of the same
+// size. Leaves are linked both ways, scans and min/max/next walk them without a path. Leaves hold [t - 1, 2t - 1]
+// entries, internal nodes - [t' - 1, 2t' - 1] keys with t' >= t chosen to match leaf size; disposal rebalances.
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer = std::function<int(tkey const &, tkey const &)>>
+class b_plus_tree final : public search_tree<tkey, tvalue, tcomparer> {
+
+private:
+
+    struct b_plus_node final
+    {
+
+    public:
+
+        size_t const level; // 0 for leaves
+
+        size_t virtual_size;
+
+        tkey *keys; // one spare slot for the key that overflows node right before its split
+
+        tvalue *values; // leaves only
+
+        b_plus_node **subtrees; // internal nodes only
+
+        b_plus_node *previous_leaf;
+
+        b_plus_node *next_leaf;
+
+    public:
+
+        b_plus_node(
+            size_t level,
+            tkey *keys,
+            tvalue *values,
+            b_plus_node **subtrees);
+
+    };
+
+public:
+
+    #pragma region iterators definition
+
+    // walks leaves through their links both ways, end is not decrementable
+    class infix_iterator final
+    {
+
+        friend class b_plus_tree<tkey, tvalue, tcomparer>;
+
+    public:
+
+        bool operator==(
+            infix_iterator const &other) const noexcept;
+
+        bool operator!=(
+            infix_iterator const &other) const noexcept;
+
+        infix_iterator &operator++();
+
+        infix_iterator operator++(
+            int not_used);
+
+        infix_iterator &operator--();
+
+        infix_iterator operator--(
+            int not_used);
+
+        std::tuple<size_t, size_t, tkey const &, tvalue &> operator*() const;
+
+    private:
+
+        infix_iterator(
+            b_plus_node *leaf,
+            size_t position,
+            size_t depth);
+
+    private:
+
+        b_plus_node *_leaf;
+
+        size_t _position;
+
+        size_t _depth;
+
+    };
+
+    #pragma endregion iterators definition
+
+public:
+
+    #pragma region CRUD operations
+
+    void insert(
+        tkey const &key,
+        tvalue const &value) override;
+
+    void insert(
+        tkey const &key,
+        tvalue &&value) override;
+
+    void update(
+        tkey const &key,
+        tvalue const &value) override;
+
+    void update(
+        tkey const &key,
+        tvalue &&value) override;
+
+    tvalue &obtain(
+        tkey const &key) override;
+
+    tvalue dispose(
+        tkey const &key) override;
+
+    std::vector<typename associative_container<tkey, tvalue>::key_value_pair> obtain_between(
+        tkey const &lower_bound,
+        tkey const &upper_bound,
+        bool lower_bound_inclusive,
+        bool upper_bound_inclusive) override;
+
+    #pragma endregion CRUD operations
+
+public:
+
+    #pragma region BPlusTree constructors, assignments, destructor
+
+    explicit b_plus_tree(
+        size_t t,
+        tcomparer keys_comparer = search_tree<tkey, tvalue, tcomparer>::default_keys_comparer(),
+        allocator *allocator = nullptr,
+        logger *logger = nullptr);
+
+    b_plus_tree(
+        b_plus_tree<tkey, tvalue, tcomparer> const &other);
+
+    b_plus_tree<tkey, tvalue, tcomparer> &operator=(
+        b_plus_tree<tkey, tvalue, tcomparer> const &other);
+
+    b_plus_tree(
+        b_plus_tree<tkey, tvalue, tcomparer> &&other) noexcept;
+
+    b_plus_tree<tkey, tvalue, tcomparer> &operator=(
+        b_plus_tree<tkey, tvalue, tcomparer> &&other) noexcept;
+
+    ~b_plus_tree() noexcept override;
+
+    #pragma endregion BPlusTree constructors, assignments, destructor
+
+public:
+
+    #pragma region iterators requesting
+
+    infix_iterator begin_infix() const noexcept;
+
+    infix_iterator end_infix() const noexcept;
+
+    infix_iterator last_infix() const noexcept;
+
+    // positioned on first key not less than key, end if there is none
+    infix_iterator lower_bound(
+        tkey const &key) const;
+
+    // positioned on first key greater than key, end if there is none
+    infix_iterator upper_bound(
+        tkey const &key) const;
+
+    // positioned on key, end if there is none
+    infix_iterator find(
+        tkey const &key) const;
+
+    #pragma endregion iterators requesting
+
+public:
+
+    size_t get_t() const noexcept;
+
+    size_t get_internal_t() const noexcept;
+
+private:
+
+    size_t _t;
+
+    size_t _internal_t;
+
+    b_plus_node *_root_node;
+
+    b_plus_node *_first_leaf;
+
+    b_plus_node *_last_leaf;
+
+    // obtain and obtain_between share the tree, modifying operations own it exclusively
+    mutable std::shared_mutex _mutex;
+
+private:
+
+    #pragma region node operations
+
+    b_plus_node *create_node(
+        size_t level);
+
+    void destroy_node(
+        b_plus_node *node) noexcept;
+
+    size_t node_t(
+        b_plus_node const *node) const noexcept;
+
+    int compare_keys(
+        tkey const &first,
+        tkey const &second) const;
+
+    size_t node_lower_bound(
+        b_plus_node const *node,
+        tkey const &key) const;
+
+    // index of subtree key belongs to: count of separators not greater than key
+    size_t node_subtree_index(
+        b_plus_node const *node,
+        tkey const &key) const;
+
+    // places item at index of items[0, count), moving the tail one slot right; slot count must be raw
+    template<
+        typename titem,
+        typename targ>
+    static void insert_item(
+        titem *items,
+        size_t count,
+        size_t index,
+        targ &&item);
+
+    // removes item at index of items[0, count), moving the tail one slot left; slot count - 1 becomes raw
+    template<
+        typename titem>
+    static void erase_item(
+        titem *items,
+        size_t count,
+        size_t index);
+
+    // moves items into raw destination slots, leaving source slots raw
+    template<
+        typename titem>
+    static void relocate_items(
+        titem *destination,
+        titem *source,
+        size_t count);
+
+    std::pair<b_plus_node *, tkey> split_leaf(
+        b_plus_node *leaf);
+
+    std::pair<b_plus_node *, tkey> split_internal(
+        b_plus_node *node);
+
+    void borrow_from_left(
+        b_plus_node *parent,
+        size_t subtree_index);
+
+    void borrow_from_right(
+        b_plus_node *parent,
+        size_t subtree_index);
+
+    // right subtree is merged into the left one and destroyed, their separator is dropped from parent
+    void merge(
+        b_plus_node *parent,
+        size_t left_subtree_index);
+
+    #pragma endregion node operations
+
+private:
+
+    // internal nodes from root down to the leaf, paired with index of the subtree descended into
+    using descent_path = node_path<std::pair<b_plus_node *, size_t>>;
+
+    b_plus_node *find_leaf(
+        tkey const &key,
+        descent_path &path) const;
+
+    void insert_inner(
+        typename associative_container<tkey, tvalue>::key_value_pair &&kvp,
+        bool is_update);
+
+    void rebalance(
+        b_plus_node *node,
+        descent_path &path);
+
+    b_plus_node *copy_subtree(
+        b_plus_node const *node,
+        b_plus_node *&previous_leaf);
+
+    void clear_subtree(
+        b_plus_node *node) noexcept;
+
+    void copy_from(
+        b_plus_tree<tkey, tvalue, tcomparer> const &other);
+
+    void clear() noexcept;
+
+private:
+
+    inline std::string get_typename() const noexcept override;
+
+};
+
+#pragma region b_plus node implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+b_plus_tree<tkey, tvalue, tcomparer>::b_plus_node::b_plus_node(
+    size_t level,
+    tkey *keys,
+    tvalue *values,
+    b_plus_node **subtrees):
+        level(level),
+        virtual_size(0),
+        keys(keys),
+        values(values),
+        subtrees(subtrees),
+        previous_leaf(nullptr),
+        next_leaf(nullptr)
+{ }
+
+#pragma endregion b_plus node implementation
+
+#pragma region infix iterator implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+b_plus_tree<tkey, tvalue, tcomparer>::infix_iterator::infix_iterator(
+    b_plus_node *leaf,
+    size_t position,
+    size_t depth):
+        _leaf(leaf),
+        _position(position),
+        _depth(depth)
+{
+    // only the root leaf may be empty, and then it is the only one
+    if (_leaf != nullptr && _position >= _leaf->virtual_size)
+    {
+        _leaf = _leaf->next_leaf;
+        _position = 0;
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+bool b_plus_tree<tkey, tvalue, tcomparer>::infix_iterator::operator==(
+    infix_iterator const &other) const noexcept
+{
+    return _leaf == other._leaf && (_leaf == nullptr || _position == other._position);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+bool b_plus_tree<tkey, tvalue, tcomparer>::infix_iterator::operator!=(
+    infix_iterator const &other) const noexcept
+{
+    return !(*this == other);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename b_plus_tree<tkey, tvalue, tcomparer>::infix_iterator &b_plus_tree<tkey, tvalue, tcomparer>::infix_iterator::operator++()
+{
+    if (_leaf != nullptr && ++_position == _leaf->virtual_size)
+    {
+        _leaf = _leaf->next_leaf;
+        _position = 0;
+    }
+
+    return *this;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename b_plus_tree<tkey, tvalue, tcomparer>::infix_iterator b_plus_tree<tkey, tvalue, tcomparer>::infix_iterator::operator++(
+    int not_used)
+{
+    auto previous = *this;
+    ++*this;
+    return previous;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename b_plus_tree<tkey, tvalue, tcomparer>::infix_iterator &b_plus_tree<tkey, tvalue, tcomparer>::infix_iterator::operator--()
+{
+    if (_leaf == nullptr)
+    {
+        return *this; // UB
+    }
+
+    if (_position != 0)
+    {
+        --_position;
+        return *this;
+    }
+
+    _leaf = _leaf->previous_leaf;
+    _position = _leaf == nullptr
+        ? 0
+        : _leaf->virtual_size - 1;
+
+    return *this;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename b_plus_tree<tkey, tvalue, tcomparer>::infix_iterator b_plus_tree<tkey, tvalue, tcomparer>::infix_iterator::operator--(
+    int not_used)
+{
+    auto next = *this;
+    --*this;
+    return next;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+std::tuple<size_t, size_t, tkey const &, tvalue &> b_plus_tree<tkey, tvalue, tcomparer>::infix_iterator::operator*() const
+{
+    if (_leaf == nullptr)
+    {
+        throw std::logic_error("attempt to dereference invalid or end iterator");
+    }
+
+    return std::tuple<size_t, size_t, tkey const &, tvalue &>(_depth, _position, _leaf->keys[_position], _leaf->values[_position]);
+}
+
+#pragma endregion infix iterator implementation
+
+#pragma region BPlusTree CRUD implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void b_plus_tree<tkey, tvalue, tcomparer>::insert(
+    tkey const &key,
+    tvalue const &value)
+{
+    insert_inner(typename associative_container<tkey, tvalue>::key_value_pair(key, value), false);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void b_plus_tree<tkey, tvalue, tcomparer>::insert(
+    tkey const &key,
+    tvalue &&value)
+{
+    insert_inner(typename associative_container<tkey, tvalue>::key_value_pair(key, std::move(value)), false);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void b_plus_tree<tkey, tvalue, tcomparer>::update(
+    tkey const &key,
+    tvalue const &value)
+{
+    insert_inner(typename associative_container<tkey, tvalue>::key_value_pair(key, value), true);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void b_plus_tree<tkey, tvalue, tcomparer>::update(
+    tkey const &key,
+    tvalue &&value)
+{
+    insert_inner(typename associative_container<tkey, tvalue>::key_value_pair(key, std::move(value)), true);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+tvalue &b_plus_tree<tkey, tvalue, tcomparer>::obtain(
+    tkey const &key)
+{
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+
+    descent_path path;
+    b_plus_node *leaf = find_leaf(key, path);
+
+    if (leaf != nullptr)
+    {
+        size_t const index = node_lower_bound(leaf, key);
+        if (index < leaf->virtual_size && compare_keys(key, leaf->keys[index]) == 0)
+        {
+            return leaf->values[index];
+        }
+    }
+
+    this->error_with_guard([&]() { return get_typename() + "::obtain(tkey const &) : key \"" +
+        extra_utility::make_string(key) + "\" is not present in container."; });
+    throw typename search_tree<tkey, tvalue, tcomparer>::obtaining_of_nonexistent_key_attempt_exception(key);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+tvalue b_plus_tree<tkey, tvalue, tcomparer>::dispose(
+    tkey const &key)
+{
+    std::lock_guard<std::shared_mutex> lock(_mutex);
+
+    descent_path path;
+    b_plus_node *leaf = find_leaf(key, path);
+
+    size_t const index = leaf == nullptr ? 0 : node_lower_bound(leaf, key);
+    if (leaf == nullptr || index >= leaf->virtual_size || compare_keys(key, leaf->keys[index]) != 0)
+    {
+        this->error_with_guard([&]() { return get_typename() + "::dispose(tkey const &) : key \"" +
+            extra_utility::make_string(key) + "\" is not present in container."; });
+        throw typename search_tree<tkey, tvalue, tcomparer>::disposal_of_nonexistent_key_attempt_exception(key);
+    }
+
+    tvalue value = std::move(leaf->values[index]);
+
+    erase_item(leaf->keys, leaf->virtual_size, index);
+    erase_item(leaf->values, leaf->virtual_size, index);
+    --leaf->virtual_size;
+
+    rebalance(leaf, path);
+
+    return value;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+std::vector<typename associative_container<tkey, tvalue>::key_value_pair> b_plus_tree<tkey, tvalue, tcomparer>::obtain_between(
+    tkey const &lower_bound,
+    tkey const &upper_bound,
+    bool lower_bound_inclusive,
+    bool upper_bound_inclusive)
+{
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+
+    std::vector<typename associative_container<tkey, tvalue>::key_value_pair> range;
+
+    descent_path path;
+    b_plus_node *leaf = find_leaf(lower_bound, path);
+    size_t index = leaf == nullptr ? 0 : node_lower_bound(leaf, lower_bound);
+
+    for (; leaf != nullptr; leaf = leaf->next_leaf, index = 0)
+    {
+        for (; index < leaf->virtual_size; ++index)
+        {
+            if (!lower_bound_inclusive && compare_keys(leaf->keys[index], lower_bound) == 0)
+            {
+                continue;
+            }
+
+            if (compare_keys(leaf->keys[index], upper_bound) >= (upper_bound_inclusive ? 1 : 0))
+            {
+                return range;
+            }
+
+            range.emplace_back(leaf->keys[index], leaf->values[index]);
+        }
+    }
+
+    return range;
+}
+
+#pragma endregion BPlusTree CRUD implementation
+
+#pragma region BPlusTree construction, assignment, destruction implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+b_plus_tree<tkey, tvalue, tcomparer>::b_plus_tree(
+    size_t t,
+    tcomparer keys_comparer,
+    allocator *allocator,
+    logger *logger):
+        search_tree<tkey, tvalue, tcomparer>(keys_comparer, allocator, logger),
+        _t(t),
+        _internal_t(std::max(t, t * (sizeof(tkey) + sizeof(tvalue)) / (sizeof(tkey) + sizeof(b_plus_node *)))),
+        _root_node(nullptr),
+        _first_leaf(nullptr),
+        _last_leaf(nullptr)
+{
+    if (t < 2)
+    {
+        throw std::logic_error("parameter t must be not less than 2");
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+b_plus_tree<tkey, tvalue, tcomparer>::b_plus_tree(
+    b_plus_tree<tkey, tvalue, tcomparer> const &other):
+        search_tree<tkey, tvalue, tcomparer>(other._keys_comparer, other._allocator, other._logger),
+        _t(other._t),
+        _internal_t(other._internal_t),
+        _root_node(nullptr),
+        _first_leaf(nullptr),
+        _last_leaf(nullptr)
+{
+    std::shared_lock<std::shared_mutex> lock(other._mutex);
+
+    copy_from(other);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+b_plus_tree<tkey, tvalue, tcomparer> &b_plus_tree<tkey, tvalue, tcomparer>::operator=(
+    b_plus_tree<tkey, tvalue, tcomparer> const &other)
+{
+    if (this != &other)
+    {
+        std::unique_lock<std::shared_mutex> lock_1(_mutex, std::defer_lock);
+        std::shared_lock<std::shared_mutex> lock_2(other._mutex, std::defer_lock);
+        std::lock(lock_1, lock_2);
+
+        clear();
+
+        this->_keys_comparer = other._keys_comparer;
+        this->_native_keys_order = other._native_keys_order;
+        this->_prefixed_keys_order = other._prefixed_keys_order;
+        this->_allocator = other._allocator;
+        this->_logger = other._logger;
+        _t = other._t;
+        _internal_t = other._internal_t;
+
+        copy_from(other);
+    }
+
+    return *this;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+b_plus_tree<tkey, tvalue, tcomparer>::b_plus_tree(
+    b_plus_tree<tkey, tvalue, tcomparer> &&other) noexcept:
+        search_tree<tkey, tvalue, tcomparer>(other._keys_comparer, other._allocator, other._logger),
+        _t(other._t),
+        _internal_t(other._internal_t)
+{
+    std::lock_guard<std::shared_mutex> lock(other._mutex);
+
+    _root_node = std::exchange(other._root_node, nullptr);
+    _first_leaf = std::exchange(other._first_leaf, nullptr);
+    _last_leaf = std::exchange(other._last_leaf, nullptr);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+b_plus_tree<tkey, tvalue, tcomparer> &b_plus_tree<tkey, tvalue, tcomparer>::operator=(
+    b_plus_tree<tkey, tvalue, tcomparer> &&other) noexcept
+{
+    if (this != &other)
+    {
+        std::lock(_mutex, other._mutex);
+        std::lock_guard<std::shared_mutex> lock_1(_mutex, std::adopt_lock);
+        std::lock_guard<std::shared_mutex> lock_2(other._mutex, std::adopt_lock);
+
+        clear();
+
+        this->_keys_comparer = std::move(other._keys_comparer);
+        this->_native_keys_order = other._native_keys_order;
+        this->_prefixed_keys_order = other._prefixed_keys_order;
+        this->_allocator = other._allocator;
+        this->_logger = other._logger;
+        _t = other._t;
+        _internal_t = other._internal_t;
+        _root_node = std::exchange(other._root_node, nullptr);
+        _first_leaf = std::exchange(other._first_leaf, nullptr);
+        _last_leaf = std::exchange(other._last_leaf, nullptr);
+    }
+
+    return *this;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+b_plus_tree<tkey, tvalue, tcomparer>::~b_plus_tree() noexcept
+{
+    clear();
+}
+
+#pragma endregion BPlusTree construction, assignment, destruction implementation
+
+#pragma region iterators requesting implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename b_plus_tree<tkey, tvalue, tcomparer>::infix_iterator b_plus_tree<tkey, tvalue, tcomparer>::begin_infix() const noexcept
+{
+    return _root_node == nullptr
+        ? end_infix()
+        : infix_iterator(_first_leaf, 0, _root_node->level);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename b_plus_tree<tkey, tvalue, tcomparer>::infix_iterator b_plus_tree<tkey, tvalue, tcomparer>::end_infix() const noexcept
+{
+    return infix_iterator(nullptr, 0, 0);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename b_plus_tree<tkey, tvalue, tcomparer>::infix_iterator b_plus_tree<tkey, tvalue, tcomparer>::last_infix() const noexcept
+{
+    return _root_node == nullptr
+        ? end_infix()
+        : infix_iterator(_last_leaf, _last_leaf->virtual_size - 1, _root_node->level);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename b_plus_tree<tkey, tvalue, tcomparer>::infix_iterator b_plus_tree<tkey, tvalue, tcomparer>::lower_bound(
+    tkey const &key) const
+{
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+
+    descent_path path;
+    b_plus_node *leaf = find_leaf(key, path);
+
+    return leaf == nullptr
+        ? end_infix()
+        : infix_iterator(leaf, node_lower_bound(leaf, key), _root_node->level);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename b_plus_tree<tkey, tvalue, tcomparer>::infix_iterator b_plus_tree<tkey, tvalue, tcomparer>::upper_bound(
+    tkey const &key) const
+{
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+
+    descent_path path;
+    b_plus_node *leaf = find_leaf(key, path);
+
+    return leaf == nullptr
+        ? end_infix()
+        : infix_iterator(leaf, node_subtree_index(leaf, key), _root_node->level);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename b_plus_tree<tkey, tvalue, tcomparer>::infix_iterator b_plus_tree<tkey, tvalue, tcomparer>::find(
+    tkey const &key) const
+{
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+
+    descent_path path;
+    b_plus_node *leaf = find_leaf(key, path);
+
+    if (leaf == nullptr)
+    {
+        return end_infix();
+    }
+
+    size_t const index = node_lower_bound(leaf, key);
+
+    return index < leaf->virtual_size && compare_keys(key, leaf->keys[index]) == 0
+        ? infix_iterator(leaf, index, _root_node->level)
+        : end_infix();
+}
+
+#pragma endregion iterators requesting implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+size_t b_plus_tree<tkey, tvalue, tcomparer>::get_t() const noexcept
+{
+    return _t;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+size_t b_plus_tree<tkey, tvalue, tcomparer>::get_internal_t() const noexcept
+{
+    return _internal_t;
+}
+
+#pragma region node operations implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename b_plus_tree<tkey, tvalue, tcomparer>::b_plus_node *b_plus_tree<tkey, tvalue, tcomparer>::create_node(
+    size_t level)
+{
+    size_t const t = level == 0 ? _t : _internal_t;
+    size_t const keys_offset = node_slab::align_up(sizeof(b_plus_node), alignof(tkey));
+    size_t const values_offset = node_slab::align_up(keys_offset + sizeof(tkey) * 2 * t, alignof(tvalue));
+    size_t const subtrees_offset = node_slab::align_up(
+        values_offset + (level == 0 ? sizeof(tvalue) * 2 * t : 0), alignof(b_plus_node *));
+    size_t const block_size = subtrees_offset + (level == 0 ? 0 : sizeof(b_plus_node *) * (2 * t + 1));
+
+    auto *block = reinterpret_cast<unsigned char *>(this->allocate_with_guard(1, block_size));
+    auto *node = reinterpret_cast<b_plus_node *>(block);
+
+    allocator::construct(node, level,
+        reinterpret_cast<tkey *>(block + keys_offset),
+        level == 0 ? reinterpret_cast<tvalue *>(block + values_offset) : nullptr,
+        level == 0 ? nullptr : reinterpret_cast<b_plus_node **>(block + subtrees_offset));
+
+    return node;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void b_plus_tree<tkey, tvalue, tcomparer>::destroy_node(
+    b_plus_node *node) noexcept
+{
+    for (size_t i = 0; i < node->virtual_size; ++i)
+    {
+        allocator::destruct(node->keys + i);
+        if (node->level == 0)
+        {
+            allocator::destruct(node->values + i);
+        }
+    }
+
+    allocator::destruct(node);
+    this->deallocate_with_guard(node);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+size_t b_plus_tree<tkey, tvalue, tcomparer>::node_t(
+    b_plus_node const *node) const noexcept
+{
+    return node->level == 0 ? _t : _internal_t;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+int b_plus_tree<tkey, tvalue, tcomparer>::compare_keys(
+    tkey const &first,
+    tkey const &second) const
+{
+    return this->_keys_comparer(first, second);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+size_t b_plus_tree<tkey, tvalue, tcomparer>::node_lower_bound(
+    b_plus_node const *node,
+    tkey const &key) const
+{
+    if constexpr (std::is_arithmetic_v<tkey>)
+    {
+        if (this->native_keys_order())
+        {
+            return node_keys_search::lower_bound(node->keys, node->virtual_size, key);
+        }
+    }
+
+    size_t left = 0;
+    size_t right = node->virtual_size;
+    while (left < right)
+    {
+        size_t const middle = (left + right) / 2;
+        if (compare_keys(node->keys[middle], key) < 0)
+        {
+            left = middle + 1;
+        }
+        else
+        {
+            right = middle;
+        }
+    }
+
+    return left;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+size_t b_plus_tree<tkey, tvalue, tcomparer>::node_subtree_index(
+    b_plus_node const *node,
+    tkey const &key) const
+{
+    size_t const index = node_lower_bound(node, key);
+
+    return index < node->virtual_size && compare_keys(key, node->keys[index]) == 0
+        ? index + 1
+        : index;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+template<
+    typename titem,
+    typename targ>
+void b_plus_tree<tkey, tvalue, tcomparer>::insert_item(
+    titem *items,
+    size_t count,
+    size_t index,
+    targ &&item)
+{
+    relocation::open_gap(items, count, index);
+    allocator::construct(items + index, std::forward<targ>(item));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+template<
+    typename titem>
+void b_plus_tree<tkey, tvalue, tcomparer>::erase_item(
+    titem *items,
+    size_t count,
+    size_t index)
+{
+    allocator::destruct(items + index);
+    relocation::close_gap(items, count, index);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+template<
+    typename titem>
+void b_plus_tree<tkey, tvalue, tcomparer>::relocate_items(
+    titem *destination,
+    titem *source,
+    size_t count)
+{
+    relocation::relocate(destination, source, count);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+std::pair<typename b_plus_tree<tkey, tvalue, tcomparer>::b_plus_node *, tkey> b_plus_tree<tkey, tvalue, tcomparer>::split_leaf(
+    b_plus_node *leaf)
+{
+    b_plus_node *right = create_node(0);
+
+    // 2t entries are halved, the right half's least key is copied up as separator
+    relocate_items(right->keys, leaf->keys + _t, _t);
+    relocate_items(right->values, leaf->values + _t, _t);
+    right->virtual_size = _t;
+    leaf->virtual_size = _t;
+
+    right->previous_leaf = leaf;
+    right->next_leaf = leaf->next_leaf;
+    (leaf->next_leaf == nullptr ? _last_leaf : leaf->next_leaf->previous_leaf) = right;
+    leaf->next_leaf = right;
+
+    return std::make_pair(right, right->keys[0]);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+std::pair<typename b_plus_tree<tkey, tvalue, tcomparer>::b_plus_node *, tkey> b_plus_tree<tkey, tvalue, tcomparer>::split_internal(
+    b_plus_node *node)
+{
+    b_plus_node *right = create_node(node->level);
+
+    // 2t' keys: t' stay with t' + 1 subtrees, key t' moves up, t' - 1 go right with t' subtrees
+    relocate_items(right->keys, node->keys + _internal_t + 1, _internal_t - 1);
+    std::copy(node->subtrees + _internal_t + 1, node->subtrees + 2 * _internal_t + 1, right->subtrees);
+    right->virtual_size = _internal_t - 1;
+
+    tkey separator = std::move(node->keys[_internal_t]);
+    allocator::destruct(node->keys + _internal_t);
+    node->virtual_size = _internal_t;
+
+    return std::make_pair(right, std::move(separator));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void b_plus_tree<tkey, tvalue, tcomparer>::borrow_from_left(
+    b_plus_node *parent,
+    size_t subtree_index)
+{
+    b_plus_node *node = parent->subtrees[subtree_index];
+    b_plus_node *left = parent->subtrees[subtree_index - 1];
+    size_t const last = left->virtual_size - 1;
+
+    if (node->level == 0)
+    {
+        insert_item(node->keys, node->virtual_size, 0, std::move(left->keys[last]));
+        insert_item(node->values, node->virtual_size, 0, std::move(left->values[last]));
+        allocator::destruct(left->values + last);
+        parent->keys[subtree_index - 1] = node->keys[0];
+    }
+    else
+    {
+        insert_item(node->keys, node->virtual_size, 0, std::move(parent->keys[subtree_index - 1]));
+        insert_item(node->subtrees, node->virtual_size + 1, 0, left->subtrees[last + 1]);
+        parent->keys[subtree_index - 1] = std::move(left->keys[last]);
+    }
+
+    allocator::destruct(left->keys + last);
+    --left->virtual_size;
+    ++node->virtual_size;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void b_plus_tree<tkey, tvalue, tcomparer>::borrow_from_right(
+    b_plus_node *parent,
+    size_t subtree_index)
+{
+    b_plus_node *node = parent->subtrees[subtree_index];
+    b_plus_node *right = parent->subtrees[subtree_index + 1];
+
+    if (node->level == 0)
+    {
+        allocator::construct(node->keys + node->virtual_size, std::move(right->keys[0]));
+        allocator::construct(node->values + node->virtual_size, std::move(right->values[0]));
+        erase_item(right->keys, right->virtual_size, 0);
+        erase_item(right->values, right->virtual_size, 0);
+        parent->keys[subtree_index] = right->keys[0];
+    }
+    else
+    {
+        allocator::construct(node->keys + node->virtual_size, std::move(parent->keys[subtree_index]));
+        node->subtrees[node->virtual_size + 1] = right->subtrees[0];
+        parent->keys[subtree_index] = std::move(right->keys[0]);
+        erase_item(right->keys, right->virtual_size, 0);
+        erase_item(right->subtrees, right->virtual_size + 1, 0);
+    }
+
+    --right->virtual_size;
+    ++node->virtual_size;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void b_plus_tree<tkey, tvalue, tcomparer>::merge(
+    b_plus_node *parent,
+    size_t left_subtree_index)
+{
+    b_plus_node *left = parent->subtrees[left_subtree_index];
+    b_plus_node *right = parent->subtrees[left_subtree_index + 1];
+
+    if (left->level == 0)
+    {
+        relocate_items(left->keys + left->virtual_size, right->keys, right->virtual_size);
+        relocate_items(left->values + left->virtual_size, right->values, right->virtual_size);
+        left->virtual_size += right->virtual_size;
+
+        left->next_leaf = right->next_leaf;
+        (right->next_leaf == nullptr ? _last_leaf : right->next_leaf->previous_leaf) = left;
+    }
+    else
+    {
+        // separator comes down between the merged halves
+        allocator::construct(left->keys + left->virtual_size, std::move(parent->keys[left_subtree_index]));
+        relocate_items(left->keys + left->virtual_size + 1, right->keys, right->virtual_size);
+        std::copy(right->subtrees, right->subtrees + right->virtual_size + 1, left->subtrees + left->virtual_size + 1);
+        left->virtual_size += right->virtual_size + 1;
+    }
+
+    right->virtual_size = 0;
+    destroy_node(right);
+
+    erase_item(parent->keys, parent->virtual_size, left_subtree_index);
+    erase_item(parent->subtrees, parent->virtual_size + 1, left_subtree_index + 1);
+    --parent->virtual_size;
+}
+
+#pragma endregion node operations implementation
+
+#pragma region BPlusTree modification implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename b_plus_tree<tkey, tvalue, tcomparer>::b_plus_node *b_plus_tree<tkey, tvalue, tcomparer>::find_leaf(
+    tkey const &key,
+    descent_path &path) const
+{
+    b_plus_node *node = _root_node;
+    if (node == nullptr)
+    {
+        return nullptr;
+    }
+
+    while (node->level != 0)
+    {
+        size_t const index = node_subtree_index(node, key);
+        path.emplace(node, index);
+        node = node->subtrees[index];
+    }
+
+    return node;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void b_plus_tree<tkey, tvalue, tcomparer>::insert_inner(
+    typename associative_container<tkey, tvalue>::key_value_pair &&kvp,
+    bool is_update)
+{
+    std::lock_guard<std::shared_mutex> lock(_mutex);
+
+    descent_path path;
+    b_plus_node *leaf = find_leaf(kvp.key, path);
+
+    size_t const index = leaf == nullptr ? 0 : node_lower_bound(leaf, kvp.key);
+    bool const key_exists = leaf != nullptr && index < leaf->virtual_size && compare_keys(kvp.key, leaf->keys[index]) == 0;
+
+    if (is_update)
+    {
+        if (!key_exists)
+        {
+            this->error_with_guard([&]() { return get_typename() + "::update(tkey const &, tvalue &&) : key \"" +
+                extra_utility::make_string(kvp.key) + "\" is not present in container."; });
+            throw typename search_tree<tkey, tvalue, tcomparer>::updating_of_nonexistent_key_attempt_exception(kvp.key);
+        }
+
+        leaf->values[index] = std::move(kvp.value);
+        return;
+    }
+
+    if (key_exists)
+    {
+        this->error_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue &&) : key \"" +
+            extra_utility::make_string(kvp.key) + "\" is already present in container."; });
+        throw typename search_tree<tkey, tvalue, tcomparer>::insertion_of_existent_key_attempt_exception_exception(kvp.key);
+    }
+
+    if (leaf == nullptr)
+    {
+        leaf = _root_node = _first_leaf = _last_leaf = create_node(0);
+    }
+
+    insert_item(leaf->values, leaf->virtual_size, index, std::move(kvp.value));
+    insert_item(leaf->keys, leaf->virtual_size, index, std::move(kvp.key));
+    ++leaf->virtual_size;
+
+    b_plus_node *node = leaf;
+    while (node->virtual_size == 2 * node_t(node))
+    {
+        auto [right, separator] = node->level == 0
+            ? split_leaf(node)
+            : split_internal(node);
+
+        if (path.empty())
+        {
+            b_plus_node *new_root = create_node(node->level + 1);
+            allocator::construct(new_root->keys, std::move(separator));
+            new_root->subtrees[0] = node;
+            new_root->subtrees[1] = right;
+            new_root->virtual_size = 1;
+            _root_node = new_root;
+
+            return;
+        }
+
+        auto [parent, subtree_index] = path.top();
+        path.pop();
+
+        insert_item(parent->keys, parent->virtual_size, subtree_index, std::move(separator));
+        insert_item(parent->subtrees, parent->virtual_size + 1, subtree_index + 1, right);
+        ++parent->virtual_size;
+
+        node = parent;
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void b_plus_tree<tkey, tvalue, tcomparer>::rebalance(
+    b_plus_node *node,
+    descent_path &path)
+{
+    while (!path.empty())
+    {
+        if (node->virtual_size >= node_t(node) - 1)
+        {
+            return;
+        }
+
+        auto [parent, subtree_index] = path.top();
+        path.pop();
+
+        b_plus_node *left = subtree_index == 0 ? nullptr : parent->subtrees[subtree_index - 1];
+        b_plus_node *right = subtree_index == parent->virtual_size ? nullptr : parent->subtrees[subtree_index + 1];
+
+        if (left != nullptr && left->virtual_size > node_t(left) - 1)
+        {
+            borrow_from_left(parent, subtree_index);
+            return;
+        }
+
+        if (right != nullptr && right->virtual_size > node_t(right) - 1)
+        {
+            borrow_from_right(parent, subtree_index);
+            return;
+        }
+
+        merge(parent, left == nullptr ? subtree_index : subtree_index - 1);
+        node = parent;
+    }
+
+    // root is emptied either by its last entry disposal or by merge of its last two subtrees
+    if (node->virtual_size == 0)
+    {
+        _root_node = node->level == 0 ? nullptr : node->subtrees[0];
+        if (_root_node == nullptr)
+        {
+            _first_leaf = _last_leaf = nullptr;
+        }
+
+        destroy_node(node);
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+typename b_plus_tree<tkey, tvalue, tcomparer>::b_plus_node *b_plus_tree<tkey, tvalue, tcomparer>::copy_subtree(
+    b_plus_node const *node,
+    b_plus_node *&previous_leaf)
+{
+    b_plus_node *copy = create_node(node->level);
+    size_t subtrees_count = 0;
+
+    try
+    {
+        for (; copy->virtual_size < node->virtual_size; ++copy->virtual_size)
+        {
+            allocator::construct(copy->keys + copy->virtual_size, node->keys[copy->virtual_size]);
+
+            if (node->level == 0)
+            {
+                try
+                {
+                    allocator::construct(copy->values + copy->virtual_size, node->values[copy->virtual_size]);
+                }
+                catch (...)
+                {
+                    allocator::destruct(copy->keys + copy->virtual_size);
+                    throw;
+                }
+            }
+        }
+
+        if (node->level != 0)
+        {
+            for (; subtrees_count <= node->virtual_size; ++subtrees_count)
+            {
+                copy->subtrees[subtrees_count] = copy_subtree(node->subtrees[subtrees_count], previous_leaf);
+            }
+
+            return copy;
+        }
+    }
+    catch (...)
+    {
+        for (size_t i = 0; i < subtrees_count; ++i)
+        {
+            clear_subtree(copy->subtrees[i]);
+        }
+
+        destroy_node(copy);
+        throw;
+    }
+
+    // leaves are copied left to right, so each one is linked after the previously copied one
+    copy->previous_leaf = previous_leaf;
+    (previous_leaf == nullptr ? _first_leaf : previous_leaf->next_leaf) = copy;
+    previous_leaf = copy;
+
+    return copy;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void b_plus_tree<tkey, tvalue, tcomparer>::clear_subtree(
+    b_plus_node *node) noexcept
+{
+    if (node->level != 0)
+    {
+        for (size_t i = 0; i <= node->virtual_size; ++i)
+        {
+            clear_subtree(node->subtrees[i]);
+        }
+    }
+
+    destroy_node(node);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void b_plus_tree<tkey, tvalue, tcomparer>::copy_from(
+    b_plus_tree<tkey, tvalue, tcomparer> const &other)
+{
+    if (other._root_node == nullptr)
+    {
+        return;
+    }
+
+    b_plus_node *previous_leaf = nullptr;
+
+    try
+    {
+        _root_node = copy_subtree(other._root_node, previous_leaf);
+    }
+    catch (...)
+    {
+        _first_leaf = nullptr;
+        throw;
+    }
+
+    _last_leaf = previous_leaf;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+void b_plus_tree<tkey, tvalue, tcomparer>::clear() noexcept
+{
+    if (_root_node != nullptr)
+    {
+        clear_subtree(_root_node);
+    }
+
+    _root_node = _first_leaf = _last_leaf = nullptr;
+}
+
+#pragma endregion BPlusTree modification implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer>
+inline std::string b_plus_tree<tkey, tvalue, tcomparer>::get_typename() const noexcept
+{
+    return "b_plus_tree<tkey, tvalue>";
+}
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_TEMPLATE_REPO_B_PLUS_TREE_H
@@ -0,0 +1,256 @@
+#include <gtest/gtest.h>
+
+#include <b_plus_tree.h>
+
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+
+namespace
+{
+
+    using tree_type = b_plus_tree<int, std::string>;
+
+    // walks leaves both ways: every entry is met once in keys order, all of them at the same depth
+    void expect_same(
+        tree_type const &tree,
+        std::map<int, std::string> const &expected)
+    {
+        auto forward = expected.begin();
+        size_t depth = 0;
+
+        for (auto iter = tree.begin_infix(); iter != tree.end_infix(); ++iter, ++forward)
+        {
+            ASSERT_NE(forward, expected.end());
+            ASSERT_EQ(std::get<2>(*iter), forward->first);
+            ASSERT_EQ(std::get<3>(*iter), forward->second);
+
+            if (forward == expected.begin())
+            {
+                depth = std::get<0>(*iter);
+            }
+            ASSERT_EQ(std::get<0>(*iter), depth) << forward->first;
+        }
+        EXPECT_EQ(forward, expected.end());
+
+        if (expected.empty())
+        {
+            EXPECT_EQ(tree.begin_infix(), tree.end_infix());
+            EXPECT_EQ(tree.last_infix(), tree.end_infix());
+            return;
+        }
+
+        auto backward = expected.rbegin();
+        for (auto iter = tree.last_infix(); ; --iter, ++backward)
+        {
+            ASSERT_NE(backward, expected.rend());
+            ASSERT_EQ(std::get<2>(*iter), backward->first);
+
+            if (std::next(backward) == expected.rend())
+            {
+                EXPECT_EQ(iter, tree.begin_infix());
+                break;
+            }
+        }
+    }
+
+    void expect_seek(
+        tree_type const &tree,
+        std::map<int, std::string> const &expected,
+        int key)
+    {
+        auto const lower = expected.lower_bound(key);
+        auto const upper = expected.upper_bound(key);
+        auto const found = expected.find(key);
+
+        auto const lower_iter = tree.lower_bound(key);
+        auto const upper_iter = tree.upper_bound(key);
+        auto const found_iter = tree.find(key);
+
+        ASSERT_EQ(lower_iter == tree.end_infix(), lower == expected.end()) << key;
+        ASSERT_EQ(upper_iter == tree.end_infix(), upper == expected.end()) << key;
+        ASSERT_EQ(found_iter == tree.end_infix(), found == expected.end()) << key;
+
+        if (lower != expected.end())
+        {
+            EXPECT_EQ(std::get<2>(*lower_iter), lower->first);
+        }
+
+        if (upper != expected.end())
+        {
+            EXPECT_EQ(std::get<2>(*upper_iter), upper->first);
+        }
+
+        if (found != expected.end())
+        {
+            EXPECT_EQ(std::get<3>(*found_iter), found->second);
+        }
+    }
+
+}
+
+TEST(b_plus_tree, random_operations_match_map)
+{
+    for (size_t t : { 2, 3, 8 })
+    {
+        std::map<int, std::string> expected;
+        std::mt19937 random(static_cast<unsigned>(t));
+        tree_type tree(t);
+
+        EXPECT_GE(tree.get_internal_t(), tree.get_t());
+
+        for (int i = 0; i < 20000; ++i)
+        {
+            int const key = static_cast<int>(random() % 3000);
+            std::string const value = std::to_string(i);
+
+            switch (random() % 4)
+            {
+            case 0:
+            case 1:
+                if (expected.emplace(key, value).second)
+                {
+                    tree.insert(key, value);
+                }
+                else
+                {
+                    EXPECT_THROW(tree.insert(key, value), tree_type::insertion_of_existent_key_attempt_exception_exception);
+                }
+                break;
+            case 2:
+                if (expected.count(key) != 0)
+                {
+                    tree.update(key, value);
+                    expected[key] = value;
+                }
+                else
+                {
+                    EXPECT_THROW(tree.update(key, value), tree_type::updating_of_nonexistent_key_attempt_exception);
+                }
+                break;
+            default:
+                if (expected.count(key) != 0)
+                {
+                    ASSERT_EQ(tree.dispose(key), expected[key]);
+                    expected.erase(key);
+                }
+                else
+                {
+                    EXPECT_THROW(tree.dispose(key), tree_type::disposal_of_nonexistent_key_attempt_exception);
+                }
+                break;
+            }
+        }
+
+        expect_same(tree, expected);
+
+        for (int key = -1; key <= 3001; key += 5)
+        {
+            expect_seek(tree, expected, key);
+        }
+    }
+}
+
+TEST(b_plus_tree, ascending_and_descending_fill_and_drain)
+{
+    for (bool is_ascending : { true, false })
+    {
+        std::map<int, std::string> expected;
+        tree_type tree(2);
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            int const key = is_ascending ? i : 2000 - i;
+            tree.insert(key, std::to_string(key));
+            expected.emplace(key, std::to_string(key));
+        }
+
+        expect_same(tree, expected);
+
+        // disposal from the middle out takes entries from both siblings and merges leaves and internal nodes
+        for (int offset = 0; offset <= 1000; ++offset)
+        {
+            for (int key : { 1000 - offset, 1000 + offset })
+            {
+                if (expected.erase(key) != 0)
+                {
+                    ASSERT_EQ(tree.dispose(key), std::to_string(key));
+                }
+            }
+
+            if (offset % 100 == 0)
+            {
+                expect_same(tree, expected);
+            }
+        }
+
+        expect_same(tree, expected);
+        EXPECT_THROW(tree.obtain(0), tree_type::obtaining_of_nonexistent_key_attempt_exception);
+
+        tree.insert(7, "7");
+        EXPECT_EQ(tree.obtain(7), "7");
+    }
+}
+
+TEST(b_plus_tree, obtain_between_walks_leaf_links)
+{
+    std::map<int, std::string> expected;
+    tree_type tree(2);
+
+    for (int i = 0; i < 500; ++i)
+    {
+        tree.insert(i * 2, std::to_string(i));
+        expected.emplace(i * 2, std::to_string(i));
+    }
+
+    for (auto [lower_bound, upper_bound] : { std::pair(-5, 5), std::pair(10, 20), std::pair(301, 733), std::pair(990, 2000) })
+    {
+        for (bool inclusive : { true, false })
+        {
+            auto const entries = tree.obtain_between(lower_bound, upper_bound, inclusive, inclusive);
+            auto first = inclusive ? expected.lower_bound(lower_bound) : expected.upper_bound(lower_bound);
+            auto last = inclusive ? expected.upper_bound(upper_bound) : expected.lower_bound(upper_bound);
+
+            ASSERT_EQ(entries.size(), static_cast<size_t>(std::distance(first, last)));
+            for (auto const &entry : entries)
+            {
+                EXPECT_EQ(entry.key, first->first);
+                EXPECT_EQ(entry.value, first->second);
+                ++first;
+            }
+        }
+    }
+}
+
+TEST(b_plus_tree, copy_and_move_keep_entries)
+{
+    std::map<int, std::string> expected;
+    tree_type tree(3);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        tree.insert(i, std::to_string(i));
+        expected.emplace(i, std::to_string(i));
+    }
+
+    tree_type copied(tree);
+    copied.dispose(0);
+    expect_same(tree, expected);
+
+    tree_type moved(std::move(copied));
+    expected.erase(0);
+    expect_same(moved, expected);
+
+    tree = moved;
+    expect_same(tree, expected);
+
+    tree_type assigned(2);
+    assigned = std::move(moved);
+    expect_same(assigned, expected);
+}
+
+TEST(b_plus_tree, order_less_than_two_is_rejected)
+{
+    EXPECT_THROW(tree_type tree(1), std::logic_error);
+}
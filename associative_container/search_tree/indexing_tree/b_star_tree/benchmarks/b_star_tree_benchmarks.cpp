@@ -0,0 +1,121 @@
+#include <b_star_tree.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <new>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+    size_t const keys_count = 1 << 20;
+
+    std::vector<size_t> const orders = { 2, 4, 8, 16, 32, 64, 128 };
+
+    // global heap allocator keeping count of bytes held, so node chunks of both trees are measured alike
+    class counting_allocator final : public allocator
+    {
+
+    private:
+
+        size_t _allocated_bytes = 0;
+
+    public:
+
+        [[nodiscard]] void *allocate(
+            size_t value_size,
+            size_t values_count) override
+        {
+            size_t const size = value_size * values_count;
+            auto *block = reinterpret_cast<size_t *>(::operator new(sizeof(size_t) + size));
+            *block = size;
+            _allocated_bytes += size;
+
+            return block + 1;
+        }
+
+        void deallocate(
+            void *at) override
+        {
+            if (at == nullptr)
+            {
+                return;
+            }
+
+            auto *block = reinterpret_cast<size_t *>(at) - 1;
+            _allocated_bytes -= *block;
+            ::operator delete(block);
+        }
+
+        [[nodiscard]] size_t get_allocated_bytes() const noexcept
+        {
+            return _allocated_bytes;
+        }
+
+    };
+
+    template<
+        typename ttree>
+    void measure_footprint(
+        char const *tree_name,
+        size_t t,
+        std::vector<int> const &keys)
+    {
+        counting_allocator allocator;
+        std::function<int(int const &, int const &)> comparer = [](int const &first, int const &second)
+        {
+            return (first > second) - (first < second);
+        };
+
+        {
+            ttree tree(t, comparer, &allocator);
+
+            auto const started = std::chrono::steady_clock::now();
+            for (auto key : keys)
+            {
+                tree.insert(key, key);
+            }
+            auto const elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started);
+
+            size_t const nodes_count = tree.get_live_nodes_count();
+            double const fill = static_cast<double>(keys.size()) / static_cast<double>(nodes_count * (2 * t - 1));
+
+            std::printf("%6zu %12s %12zu %8.2f %14.2f %12.2f\n", t, tree_name, nodes_count, fill,
+                static_cast<double>(allocator.get_allocated_bytes()) / (1 << 20), elapsed.count());
+        }
+    }
+
+    // nodes count and memory held after inserting the same keys one by one in given order
+    void footprint_benchmark(
+        char const *order_name,
+        std::vector<int> const &keys)
+    {
+        std::printf("\nfootprint after %zu %s insertions\n", keys.size(), order_name);
+        std::printf("%6s %12s %12s %8s %14s %12s\n", "t", "tree", "nodes", "fill", "memory MiB", "insert ms");
+
+        for (auto t : orders)
+        {
+            measure_footprint<b_tree<int, int>>("b_tree", t, keys);
+            measure_footprint<b_star_tree<int, int>>("b_star_tree", t, keys);
+        }
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    std::vector<int> keys(keys_count);
+    std::iota(keys.begin(), keys.end(), 0);
+    footprint_benchmark("sequential", keys);
+
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(1));
+    footprint_benchmark("random", keys);
+
+    return 0;
+}
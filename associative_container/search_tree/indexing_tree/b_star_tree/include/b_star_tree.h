@@ -0,0 +1,332 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_TEMPLATE_REPO_B_STAR_TREE_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_TEMPLATE_REPO_B_STAR_TREE_H
+
+#include <b_tree.h>
+
+#include <vector>
+
+// b_tree which, before splitting full node, shares its entries with sibling having free slots, and when both
+// neighbouring siblings are full, splits two full nodes into three: nodes built by insertions are at least 2/3 full
+// (except root and, right after root split, its children); disposal follows b_tree rules
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer = std::function<int(tkey const &, tkey const &)>,
+    size_t torder = 0>
+class b_star_tree final : public b_tree<tkey, tvalue, tcomparer, torder> {
+
+private:
+
+    // entries and subtrees of two siblings and their separator being redistributed, reserved for two full nodes,
+    // separator and pending entry, so redistribution never allocates
+    std::vector<typename associative_container<tkey, tvalue>::key_value_pair> _overflow_entries;
+
+    std::vector<typename search_tree<tkey, tvalue, tcomparer>::common_node *> _overflow_subtrees;
+
+public:
+
+    #pragma region BStarTree constructors, assignments, destructor
+
+    explicit b_star_tree(
+        size_t t,
+        tcomparer keys_comparer = search_tree<tkey, tvalue, tcomparer>::default_keys_comparer(),
+        allocator *allocator = nullptr,
+        logger *logger = nullptr);
+
+    b_star_tree(
+        b_star_tree<tkey, tvalue, tcomparer, torder> const &other);
+
+    b_star_tree<tkey, tvalue, tcomparer, torder> &operator=(
+        b_star_tree<tkey, tvalue, tcomparer, torder> const &other);
+
+    b_star_tree(
+        b_star_tree<tkey, tvalue, tcomparer, torder> &&other) noexcept;
+
+    b_star_tree<tkey, tvalue, tcomparer, torder> &operator=(
+        b_star_tree<tkey, tvalue, tcomparer, torder> &&other) noexcept;
+
+    ~b_star_tree() noexcept override = default;
+
+    #pragma endregion BStarTree constructors, assignments, destructor
+
+protected:
+
+    bool resolve_overflow(
+        node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node **, int>> &path,
+        typename associative_container<tkey, tvalue>::key_value_pair &kvp,
+        size_t &subtree_index,
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *&right_subtree) override;
+
+private:
+
+    #pragma region utility functions
+
+    void reserve_overflow_buffers();
+
+    // moves node entries and subtrees to overflow buffers, with pending entry put in place if node holds it
+    void gather(
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *node,
+        typename associative_container<tkey, tvalue>::key_value_pair *pending,
+        size_t subtree_index,
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *right_subtree);
+
+    // fills node with count buffered entries starting at index and with subtrees around them
+    void scatter(
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *node,
+        size_t index,
+        size_t count);
+
+    #pragma endregion utility functions
+
+    inline std::string get_typename() const noexcept override;
+
+};
+
+#pragma region BStarTree construction, assignment, destruction implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+b_star_tree<tkey, tvalue, tcomparer, torder>::b_star_tree(
+    size_t t,
+    tcomparer keys_comparer,
+    allocator *allocator,
+    logger *logger):
+        b_tree<tkey, tvalue, tcomparer, torder>(t, keys_comparer, allocator, logger)
+{
+    reserve_overflow_buffers();
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+b_star_tree<tkey, tvalue, tcomparer, torder>::b_star_tree(
+    b_star_tree<tkey, tvalue, tcomparer, torder> const &other):
+        b_tree<tkey, tvalue, tcomparer, torder>(other)
+{
+    reserve_overflow_buffers();
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+b_star_tree<tkey, tvalue, tcomparer, torder> &b_star_tree<tkey, tvalue, tcomparer, torder>::operator=(
+    b_star_tree<tkey, tvalue, tcomparer, torder> const &other)
+{
+    if (this != &other)
+    {
+        b_tree<tkey, tvalue, tcomparer, torder>::operator=(other);
+        reserve_overflow_buffers();
+    }
+
+    return *this;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+b_star_tree<tkey, tvalue, tcomparer, torder>::b_star_tree(
+    b_star_tree<tkey, tvalue, tcomparer, torder> &&other) noexcept:
+        b_tree<tkey, tvalue, tcomparer, torder>(std::move(other)),
+        _overflow_entries(std::move(other._overflow_entries)),
+        _overflow_subtrees(std::move(other._overflow_subtrees))
+{ }
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+b_star_tree<tkey, tvalue, tcomparer, torder> &b_star_tree<tkey, tvalue, tcomparer, torder>::operator=(
+    b_star_tree<tkey, tvalue, tcomparer, torder> &&other) noexcept
+{
+    if (this != &other)
+    {
+        b_tree<tkey, tvalue, tcomparer, torder>::operator=(std::move(other));
+        _overflow_entries = std::move(other._overflow_entries);
+        _overflow_subtrees = std::move(other._overflow_subtrees);
+    }
+
+    return *this;
+}
+
+#pragma endregion BStarTree construction, assignment, destruction implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+bool b_star_tree<tkey, tvalue, tcomparer, torder>::resolve_overflow(
+    node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node **, int>> &path,
+    typename associative_container<tkey, tvalue>::key_value_pair &kvp,
+    size_t &subtree_index,
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *&right_subtree)
+{
+    size_t const max_keys_count = 2 * this->get_t() - 1;
+
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *node = *path.top().first;
+    path.pop();
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *parent = *path.top().first;
+    size_t const node_index = -path.top().second - 1;
+
+    // sibling with free slot is preferred, left one first; with both full, node is paired with any of them
+    bool const has_left = node_index > 0;
+    bool const has_right = node_index < parent->virtual_size;
+    size_t left_index;
+    if (has_left && parent->subtrees[node_index - 1]->virtual_size < max_keys_count)
+    {
+        left_index = node_index - 1;
+    }
+    else if (has_right && parent->subtrees[node_index + 1]->virtual_size < max_keys_count)
+    {
+        left_index = node_index;
+    }
+    else
+    {
+        left_index = has_right ? node_index : node_index - 1;
+    }
+
+    auto *left = this->unshare(parent->subtrees[left_index]);
+    auto *right = this->unshare(parent->subtrees[left_index + 1]);
+    size_t const entries_count = left->virtual_size + right->virtual_size + 2;
+    bool const is_split = entries_count - 1 > 2 * max_keys_count;
+
+    // try create node before structure change
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *middle = is_split
+        ? this->create_node(this->get_t())
+        : nullptr;
+
+    gather(left, left == node ? &kvp : nullptr, subtree_index, right_subtree);
+    _overflow_entries.emplace_back(this->node_extract_entry(parent, left_index));
+    gather(right, right == node ? &kvp : nullptr, subtree_index, right_subtree);
+
+    if (!is_split)
+    {
+        // siblings share entries evenly, parent keeps its size
+        size_t const left_count = entries_count / 2;
+        scatter(left, 0, left_count);
+        this->node_construct_entry(parent, left_index, std::move(_overflow_entries[left_count]));
+        scatter(right, left_count + 1, entries_count - left_count - 1);
+
+        _overflow_entries.clear();
+        _overflow_subtrees.clear();
+
+        return false;
+    }
+
+    // two full siblings, separator and pending entry become three nodes and two separators, second one goes up
+    size_t const nodes_entries_count = entries_count - 2;
+    size_t const left_count = (nodes_entries_count + 2) / 3;
+    size_t const middle_count = (nodes_entries_count + 1) / 3;
+    scatter(left, 0, left_count);
+    this->node_construct_entry(parent, left_index, std::move(_overflow_entries[left_count]));
+    scatter(middle, left_count + 1, middle_count);
+    kvp = std::move(_overflow_entries[left_count + middle_count + 1]);
+    scatter(right, left_count + middle_count + 2, nodes_entries_count - left_count - middle_count);
+
+    _overflow_entries.clear();
+    _overflow_subtrees.clear();
+
+    parent->subtrees[left_index + 1] = middle;
+    subtree_index = left_index + 1;
+    right_subtree = right;
+
+    return true;
+}
+
+#pragma region utility functions implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+void b_star_tree<tkey, tvalue, tcomparer, torder>::reserve_overflow_buffers()
+{
+    size_t const max_keys_count = 2 * this->get_t() - 1;
+
+    _overflow_entries.reserve(2 * max_keys_count + 2);
+    _overflow_subtrees.reserve(2 * max_keys_count + 3);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+void b_star_tree<tkey, tvalue, tcomparer, torder>::gather(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *node,
+    typename associative_container<tkey, tvalue>::key_value_pair *pending,
+    size_t subtree_index,
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *right_subtree)
+{
+    for (size_t i = 0; i < node->virtual_size; ++i)
+    {
+        if (pending != nullptr && i == subtree_index)
+        {
+            _overflow_entries.emplace_back(std::move(*pending));
+        }
+
+        _overflow_entries.emplace_back(this->node_extract_entry(node, i));
+    }
+
+    if (pending != nullptr && subtree_index == node->virtual_size)
+    {
+        _overflow_entries.emplace_back(std::move(*pending));
+    }
+
+    for (size_t i = 0; i <= node->virtual_size; ++i)
+    {
+        _overflow_subtrees.push_back(node->subtrees[i]);
+
+        if (pending != nullptr && i == subtree_index)
+        {
+            _overflow_subtrees.push_back(right_subtree);
+        }
+    }
+
+    node->virtual_size = 0;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+void b_star_tree<tkey, tvalue, tcomparer, torder>::scatter(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *node,
+    size_t index,
+    size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        this->node_construct_entry(node, i, std::move(_overflow_entries[index + i]));
+    }
+
+    std::copy_n(_overflow_subtrees.begin() + index, count + 1, node->subtrees);
+    node->virtual_size = count;
+    this->refresh_subtree_size(node);
+}
+
+#pragma endregion utility functions implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+inline std::string b_star_tree<tkey, tvalue, tcomparer, torder>::get_typename() const noexcept
+{
+    return "b_star_tree<tkey, tvalue>";
+}
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_TEMPLATE_REPO_B_STAR_TREE_H
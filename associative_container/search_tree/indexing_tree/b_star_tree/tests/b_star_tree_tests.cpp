@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+
+#include <b_star_tree.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <new>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+    using tree_type = b_star_tree<int, int>;
+
+    // allocator refusing allocations once given count of them is spent
+    class limited_allocator final:
+        public allocator
+    {
+
+    private:
+
+        size_t _allocations_left;
+
+    public:
+
+        explicit limited_allocator(
+            size_t allocations_count):
+                _allocations_left(allocations_count)
+        {
+
+        }
+
+    public:
+
+        [[nodiscard]] void *allocate(
+            size_t value_size,
+            size_t values_count) override
+        {
+            if (_allocations_left == 0)
+            {
+                throw std::bad_alloc();
+            }
+
+            --_allocations_left;
+            return ::operator new(value_size * values_count);
+        }
+
+        void deallocate(
+            void *at) override
+        {
+            ::operator delete(at);
+        }
+
+    public:
+
+        void set_allocations_left(
+            size_t allocations_count) noexcept
+        {
+            _allocations_left = allocations_count;
+        }
+
+    };
+
+    // iteration, rank and select all agree with the model
+    void expect_same(
+        tree_type const &tree,
+        std::map<int, int> const &expected)
+    {
+        auto iter = tree.cbegin_infix();
+        size_t k = 0;
+
+        for (auto const &[key, value] : expected)
+        {
+            ASSERT_NE(iter, tree.cend_infix());
+            ASSERT_EQ(std::get<2>(*iter), key);
+            ASSERT_EQ(std::get<3>(*iter), value);
+            ASSERT_EQ(tree.rank(key), k);
+            ASSERT_EQ(std::get<2>(*tree.select(k)), key);
+
+            ++iter;
+            ++k;
+        }
+
+        EXPECT_EQ(iter, tree.cend_infix());
+        EXPECT_EQ(tree.count_between(std::numeric_limits<int>::min(), std::numeric_limits<int>::max(), true, true),
+            expected.size());
+    }
+
+}
+
+TEST(b_star_tree, insertions_fill_nodes_at_least_two_thirds)
+{
+    for (size_t t : { 3, 5, 16 })
+    {
+        for (int order = 0; order < 3; ++order)
+        {
+            size_t constexpr keys_count = 30000;
+            std::vector<int> keys(keys_count);
+            std::map<int, int> expected;
+            tree_type tree(t);
+            b_tree<int, int> plain(t);
+
+            for (size_t i = 0; i < keys_count; ++i)
+            {
+                keys[i] = static_cast<int>(order == 2 ? keys_count - i : i);
+            }
+
+            if (order == 0)
+            {
+                std::shuffle(keys.begin(), keys.end(), std::mt19937(static_cast<unsigned>(t)));
+            }
+
+            for (int key : keys)
+            {
+                tree.insert(key, key * 3);
+                plain.insert(key, key);
+                expected.emplace(key, key * 3);
+            }
+
+            expect_same(tree, expected);
+
+            // root and children of the last root split may be less full, they are few
+            double const fill = static_cast<double>(keys_count) / (tree.get_live_nodes_count() * (2 * t - 1));
+            EXPECT_GE(fill, 0.6) << t << ' ' << order;
+            EXPECT_LT(tree.get_live_nodes_count(), plain.get_live_nodes_count()) << t << ' ' << order;
+        }
+    }
+}
+
+TEST(b_star_tree, random_operations_match_map)
+{
+    for (size_t t : { 2, 3, 4, 8 })
+    {
+        std::map<int, int> expected;
+        std::mt19937 random(static_cast<unsigned>(t * 7));
+        tree_type tree(t);
+
+        for (int i = 0; i < 40000; ++i)
+        {
+            int const key = static_cast<int>(random() % 5000);
+
+            if (random() % 3 != 0)
+            {
+                if (expected.emplace(key, i).second)
+                {
+                    tree.insert(key, int(i));
+                }
+                else
+                {
+                    EXPECT_THROW(tree.insert(key, int(i)), tree_type::insertion_of_existent_key_attempt_exception_exception);
+                }
+
+                continue;
+            }
+
+            auto found = expected.find(key);
+            if (found == expected.end())
+            {
+                EXPECT_THROW(tree.dispose(key), tree_type::disposal_of_nonexistent_key_attempt_exception);
+                continue;
+            }
+
+            ASSERT_EQ(tree.dispose(key), found->second);
+            expected.erase(found);
+        }
+
+        expect_same(tree, expected);
+
+        // batch and base class insertions go through redistribution too
+        std::vector<tree_type::key_value_pair> batch;
+        for (int key = 5000; key < 9000; key += 3)
+        {
+            batch.emplace_back(key, key);
+            expected.emplace(key, key);
+        }
+        tree.insert_batch(std::move(batch));
+
+        b_tree<int, int> &base = tree;
+        base.insert(-5, 1);
+        expected.emplace(-5, 1);
+
+        expect_same(tree, expected);
+
+        tree_type copied(tree);
+        copied.insert(-6, 1);
+        expect_same(tree, expected);
+    }
+}
+
+TEST(b_star_tree, failed_insertion_leaves_subtree_sizes)
+{
+    std::map<int, int> expected;
+    limited_allocator allocator(1);
+    tree_type tree(2, associative_container<int, int>::default_key_comparer(), &allocator);
+
+    int key = 0;
+    size_t failures_count = 0;
+
+    while (failures_count < 20)
+    {
+        try
+        {
+            tree.insert(key, int(key));
+            expected.emplace(key, key);
+            key += 2;
+        }
+        catch (std::bad_alloc const &)
+        {
+            // nodes for splits are reserved before tree is changed
+            ++failures_count;
+            expect_same(tree, expected);
+            allocator.set_allocations_left(1);
+        }
+    }
+
+    EXPECT_GT(expected.size(), 200u);
+    expect_same(tree, expected);
+}
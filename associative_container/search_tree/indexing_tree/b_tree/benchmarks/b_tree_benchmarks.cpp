@@ -0,0 +1,807 @@
+#include <b_tree.h>
+#include <client_logger_builder.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <cstdio>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+    size_t const keys_count = 1 << 20;
+    size_t const lookups_count = 1 << 22;
+
+    size_t const tree_keys_count = 1 << 18;
+
+    std::vector<size_t> const orders = { 2, 4, 8, 16, 32, 64, 128, 256, 512 };
+
+    template<
+        typename tsearch>
+    double nanoseconds_per_search(
+        size_t nodes_count,
+        size_t node_keys_count,
+        std::vector<size_t> const &lookups,
+        tsearch search)
+    {
+        size_t checksum = 0;
+        auto const started = std::chrono::steady_clock::now();
+
+        for (auto lookup : lookups)
+        {
+            checksum += search(lookup % nodes_count * node_keys_count, lookup % node_keys_count);
+        }
+
+        auto const elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started);
+        if (checksum == 42)
+        {
+            std::printf(" ");
+        }
+
+        return elapsed.count() / static_cast<double>(lookups.size());
+    }
+
+    // searches full nodes of 2t - 1 keys the way node_find_path does: through the comparer, and natively
+    template<
+        typename tkey>
+    void node_search_benchmark(
+        char const *key_type_name)
+    {
+        std::vector<size_t> lookups(lookups_count);
+        std::mt19937_64 rng(1);
+        for (auto &lookup : lookups)
+        {
+            lookup = rng();
+        }
+
+        std::function<int(tkey const &, tkey const &)> comparer = [](tkey const &first, tkey const &second)
+        {
+            return (first > second) - (first < second);
+        };
+
+        std::printf("\nintra-node search, %s keys, %zu random searches over full nodes\n", key_type_name, lookups_count);
+        std::printf("%6s %18s %18s %18s %9s\n", "t", "comparer ns/op", "std::lower_bound", "node_keys_search", "speedup");
+
+        for (auto t : orders)
+        {
+            size_t const node_keys_count = 2 * t - 1;
+            size_t const nodes_count = std::max<size_t>(1, keys_count / node_keys_count);
+            std::vector<tkey> keys(nodes_count * node_keys_count);
+            for (size_t i = 0; i < keys.size(); ++i)
+            {
+                keys[i] = static_cast<tkey>(i % node_keys_count * 2);
+            }
+
+            double const generic = nanoseconds_per_search(nodes_count, node_keys_count, lookups,
+                [&](size_t node, size_t probe)
+                {
+                    tkey const key = static_cast<tkey>(probe * 2);
+                    size_t left = 0, right = node_keys_count - 1;
+                    while (left < right)
+                    {
+                        size_t const middle = (left + right) / 2;
+                        if (comparer(key, keys[node + middle]) > 0)
+                        {
+                            left = middle + 1;
+                        }
+                        else
+                        {
+                            right = middle;
+                        }
+                    }
+
+                    return left;
+                });
+
+            double const binary = nanoseconds_per_search(nodes_count, node_keys_count, lookups,
+                [&](size_t node, size_t probe)
+                {
+                    return static_cast<size_t>(std::lower_bound(keys.data() + node, keys.data() + node + node_keys_count,
+                        static_cast<tkey>(probe * 2)) - (keys.data() + node));
+                });
+
+            double const native = nanoseconds_per_search(nodes_count, node_keys_count, lookups,
+                [&](size_t node, size_t probe)
+                {
+                    return node_keys_search::lower_bound(keys.data() + node, node_keys_count, static_cast<tkey>(probe * 2));
+                });
+
+            std::printf("%6zu %18.1f %18.1f %18.1f %8.2fx\n", t, generic, binary, native, generic / native);
+        }
+    }
+
+    template<
+        typename tkey>
+    tkey make_key(
+        size_t index);
+
+    template<>
+    int make_key<int>(
+        size_t index)
+    {
+        return static_cast<int>(index);
+    }
+
+    template<>
+    std::string make_key<std::string>(
+        size_t index)
+    {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "login_%08zu", index);
+        return buffer;
+    }
+
+    // nanoseconds per insert and per obtain of shuffled keys
+    template<
+        typename ttree,
+        typename tkey>
+    std::pair<double, double> tree_operations_timings(
+        ttree &&tree,
+        std::vector<tkey> const &keys)
+    {
+        auto const started = std::chrono::steady_clock::now();
+        for (auto const &key : keys)
+        {
+            tree.insert(key, 1);
+        }
+
+        auto const inserted = std::chrono::steady_clock::now();
+        int checksum = 0;
+        for (auto const &key : keys)
+        {
+            checksum += tree.obtain(key);
+        }
+
+        auto const obtained = std::chrono::steady_clock::now();
+        if (checksum == 42)
+        {
+            std::printf(" ");
+        }
+
+        return std::make_pair(
+            std::chrono::duration<double, std::nano>(inserted - started).count() / static_cast<double>(keys.size()),
+            std::chrono::duration<double, std::nano>(obtained - inserted).count() / static_cast<double>(keys.size()));
+    }
+
+    // b_tree with type-erased comparer against b_tree with default comparer as template argument
+    template<
+        typename tkey>
+    void comparer_benchmark(
+        char const *key_type_name)
+    {
+        using default_comparer = typename associative_container<tkey, int>::default_key_comparer;
+
+        std::vector<tkey> keys;
+        keys.reserve(tree_keys_count);
+        for (size_t i = 0; i < tree_keys_count; ++i)
+        {
+            keys.push_back(make_key<tkey>(i));
+        }
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(3));
+
+        std::printf("\nkeys comparer, %s keys, %zu inserts and obtains\n", key_type_name, tree_keys_count);
+        std::printf("%6s %20s %20s %20s %20s\n", "t", "std::function insert", "template insert", "std::function obtain", "template obtain");
+
+        for (auto t : { 2, 8, 32, 128 })
+        {
+            auto const type_erased = tree_operations_timings(b_tree<tkey, int>(t), keys);
+            auto const compile_time = tree_operations_timings(b_tree<tkey, int, default_comparer>(t), keys);
+
+            std::printf("%6d %20.1f %20.1f %20.1f %20.1f\n", t,
+                type_erased.first, compile_time.first, type_erased.second, compile_time.second);
+        }
+    }
+
+    // building tree of sorted keys by bulk load against inserting them one by one
+    void bulk_load_benchmark()
+    {
+        size_t const loaded_keys_count = 1 << 21;
+        using tree_type = b_tree<int, int, associative_container<int, int>::default_key_comparer>;
+
+        std::vector<associative_container<int, int>::key_value_pair> entries;
+        entries.reserve(loaded_keys_count);
+        for (size_t i = 0; i < loaded_keys_count; ++i)
+        {
+            entries.emplace_back(static_cast<int>(i), 1);
+        }
+
+        std::printf("\nbulk load, %zu sorted keys\n", loaded_keys_count);
+        std::printf("%6s %16s %16s %16s\n", "t", "insert ms", "bulk load ms", "bulk load 0.7 ms");
+
+        for (size_t t : { 2, 8, 32, 128 })
+        {
+            auto const timing = [t](auto build)
+            {
+                tree_type tree(t);
+                auto const started = std::chrono::steady_clock::now();
+                build(tree);
+                return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+            };
+
+            double const inserted = timing([&entries](tree_type &tree)
+            {
+                for (auto const &entry : entries)
+                {
+                    tree.insert(entry.key, entry.value);
+                }
+            });
+            double const loaded = timing([&entries](tree_type &tree)
+            {
+                tree.bulk_load(entries.begin(), entries.end());
+            });
+            double const loaded_sparse = timing([&entries](tree_type &tree)
+            {
+                tree.bulk_load(entries.begin(), entries.end(), 0.7);
+            });
+
+            std::printf("%6zu %16.1f %16.1f %16.1f\n", t, inserted, loaded, loaded_sparse);
+        }
+    }
+
+    // random keys inserted and obtained one by one against batches of them
+    void batch_benchmark()
+    {
+        size_t const batched_keys_count = 1 << 20;
+        using tree_type = b_tree<int, int, associative_container<int, int>::default_key_comparer>;
+
+        std::vector<int> keys(batched_keys_count);
+        std::mt19937 rng(5);
+        for (auto &key : keys)
+        {
+            key = static_cast<int>(rng());
+        }
+
+        auto const milliseconds = [](auto operation)
+        {
+            auto const started = std::chrono::steady_clock::now();
+            operation();
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+        };
+
+        std::printf("\nbatched operations, %zu random keys, t = 32\n", batched_keys_count);
+        std::printf("%10s %16s %16s %16s %16s\n", "batch", "insert ms", "insert_batch ms", "obtain ms", "obtain_batch ms");
+
+        for (size_t batch_size : { 16, 256, 4096, 65536 })
+        {
+            tree_type single(32);
+            tree_type batched(32);
+
+            double const inserted = milliseconds([&]()
+            {
+                for (auto key : keys)
+                {
+                    try
+                    {
+                        single.insert(key, 1);
+                    }
+                    catch (search_tree<int, int, associative_container<int, int>::default_key_comparer>::insertion_of_existent_key_attempt_exception_exception const &)
+                    {
+                    }
+                }
+            });
+            double const inserted_batched = milliseconds([&]()
+            {
+                for (size_t i = 0; i < keys.size(); i += batch_size)
+                {
+                    std::vector<associative_container<int, int>::key_value_pair> entries;
+                    for (size_t j = i; j < std::min(keys.size(), i + batch_size); ++j)
+                    {
+                        entries.emplace_back(keys[j], 1);
+                    }
+                    batched.insert_batch(std::move(entries));
+                }
+            });
+            double const obtained = milliseconds([&]()
+            {
+                for (auto key : keys)
+                {
+                    single.obtain(key);
+                }
+            });
+            double const obtained_batched = milliseconds([&]()
+            {
+                for (size_t i = 0; i < keys.size(); i += batch_size)
+                {
+                    batched.obtain_batch(std::vector<int>(keys.begin() + i, keys.begin() + std::min(keys.size(), i + batch_size)));
+                }
+            });
+
+            std::printf("%10zu %16.1f %16.1f %16.1f %16.1f\n", batch_size, inserted, inserted_batched, obtained, obtained_batched);
+        }
+    }
+
+    // next key found by walking from the least one against seeking it
+    void seek_benchmark()
+    {
+        size_t const seeks_count = 256;
+        using tree_type = b_tree<int, int, associative_container<int, int>::default_key_comparer>;
+
+        auto const microseconds = [](auto operation)
+        {
+            auto const started = std::chrono::steady_clock::now();
+            operation();
+            return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count() / seeks_count;
+        };
+
+        std::printf("\nnext key seek, t = 32\n");
+        std::printf("%10s %16s %16s\n", "keys", "walk us", "find us");
+
+        for (size_t tree_size : { 1 << 10, 1 << 14, 1 << 18 })
+        {
+            tree_type tree(32);
+            std::vector<associative_container<int, int>::key_value_pair> entries;
+            entries.reserve(tree_size);
+            for (size_t i = 0; i < tree_size; ++i)
+            {
+                entries.emplace_back(static_cast<int>(i), 1);
+            }
+            tree.bulk_load(entries.begin(), entries.end());
+
+            std::mt19937 rng(6);
+            std::vector<int> sought(seeks_count);
+            for (auto &key : sought)
+            {
+                key = static_cast<int>(rng() % (tree_size - 1));
+            }
+
+            size_t checksum = 0;
+            double const walked = microseconds([&]()
+            {
+                for (auto key : sought)
+                {
+                    auto iter = tree.cbegin_infix();
+                    while (std::get<2>(*iter) != key)
+                    {
+                        ++iter;
+                    }
+                    checksum += std::get<2>(*++iter);
+                }
+            });
+            double const found = microseconds([&]()
+            {
+                for (auto key : sought)
+                {
+                    auto iter = tree.find(key);
+                    checksum -= std::get<2>(*++iter);
+                }
+            });
+
+            std::printf("%10zu %16.2f %16.2f%s\n", tree_size, walked, found, checksum == 0 ? "" : " (mismatch)");
+        }
+    }
+
+    // range counts and median split keys: obtained ranges and scans against subtree sizes
+    void order_statistics_benchmark()
+    {
+        size_t const queries_count = 64;
+        using tree_type = b_tree<int, int, associative_container<int, int>::default_key_comparer>;
+
+        auto const microseconds = [](auto operation)
+        {
+            auto const started = std::chrono::steady_clock::now();
+            operation();
+            return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count() / queries_count;
+        };
+
+        std::printf("\nrange count and median key, t = 32\n");
+        std::printf("%10s %18s %18s %16s %16s\n", "keys", "obtain_between us", "count_between us", "scan median us", "select us");
+
+        for (size_t tree_size : { 1 << 10, 1 << 14, 1 << 18 })
+        {
+            tree_type tree(32);
+            std::vector<associative_container<int, int>::key_value_pair> entries;
+            entries.reserve(tree_size);
+            for (size_t i = 0; i < tree_size; ++i)
+            {
+                entries.emplace_back(static_cast<int>(i), 1);
+            }
+            tree.bulk_load(entries.begin(), entries.end());
+
+            std::mt19937 rng(7);
+            std::vector<std::pair<int, int>> ranges(queries_count);
+            for (auto &range : ranges)
+            {
+                range.first = static_cast<int>(rng() % tree_size);
+                range.second = static_cast<int>(rng() % tree_size);
+                if (range.first > range.second)
+                {
+                    std::swap(range.first, range.second);
+                }
+            }
+
+            size_t checksum = 0;
+            double const obtained = microseconds([&]()
+            {
+                for (auto const &range : ranges)
+                {
+                    checksum += tree.obtain_between(range.first, range.second, true, true).size();
+                }
+            });
+            double const counted = microseconds([&]()
+            {
+                for (auto const &range : ranges)
+                {
+                    checksum -= tree.count_between(range.first, range.second, true, true);
+                }
+            });
+            double const scanned = microseconds([&]()
+            {
+                for (size_t i = 0; i < queries_count; ++i)
+                {
+                    auto iter = tree.cbegin_infix();
+                    for (size_t skipped = 0; skipped < tree_size / 2; ++skipped)
+                    {
+                        ++iter;
+                    }
+                    checksum += std::get<2>(*iter);
+                }
+            });
+            double const selected = microseconds([&]()
+            {
+                for (size_t i = 0; i < queries_count; ++i)
+                {
+                    checksum -= std::get<2>(*tree.select(tree_size / 2));
+                }
+            });
+
+            std::printf("%10zu %18.2f %18.2f %16.2f %16.2f%s\n", tree_size, obtained, counted, scanned, selected,
+                checksum == 0 ? "" : " (mismatch)");
+        }
+    }
+
+    // inserts and obtains with no logger against logger dropping trace and debug records, as in production
+    void logging_benchmark()
+    {
+        size_t const operations_count = 1 << 18;
+        using tree_type = b_tree<int, int, associative_container<int, int>::default_key_comparer>;
+
+        std::vector<int> keys(operations_count);
+        std::iota(keys.begin(), keys.end(), 0);
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(8));
+
+        client_logger_builder builder("%d %t [%s] %m");
+        logger *production_logger = builder.add_console_stream(logger::severity::error)->build();
+
+        std::printf("\ninsert and obtain, t = 32, %zu keys\n", operations_count);
+        std::printf("%16s %16s %16s\n", "logger", "insert ns/op", "obtain ns/op");
+
+        for (auto *attached_logger : { static_cast<logger *>(nullptr), production_logger })
+        {
+            tree_type tree(32, associative_container<int, int>::default_key_comparer(), nullptr, attached_logger);
+
+            auto started = std::chrono::steady_clock::now();
+            for (auto key : keys)
+            {
+                tree.insert(key, key);
+            }
+            auto const inserted = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started);
+
+            size_t checksum = 0;
+            started = std::chrono::steady_clock::now();
+            for (auto key : keys)
+            {
+                checksum += tree.obtain(key);
+            }
+            auto const obtained = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started);
+
+            std::printf("%16s %16.1f %16.1f%s\n", attached_logger == nullptr ? "none" : "error only",
+                inserted.count() / operations_count, obtained.count() / operations_count,
+                checksum == 0 ? " (mismatch)" : "");
+        }
+
+        delete production_logger;
+    }
+
+    // frozen view for a long scan: deep copy against snapshot, and writes paying for copying shared nodes
+    void snapshot_benchmark()
+    {
+        using tree_type = b_tree<int, int, associative_container<int, int>::default_key_comparer>;
+
+        std::vector<associative_container<int, int>::key_value_pair> entries;
+        entries.reserve(tree_keys_count);
+        for (size_t i = 0; i < tree_keys_count; ++i)
+        {
+            entries.emplace_back(static_cast<int>(2 * i), 1);
+        }
+
+        // odd keys land between loaded ones, spread over the whole tree
+        std::vector<int> keys(tree_keys_count);
+        for (size_t i = 0; i < tree_keys_count; ++i)
+        {
+            keys[i] = static_cast<int>(2 * i + 1);
+        }
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(10));
+        keys.resize(tree_keys_count / 16);
+
+        std::printf("\nfrozen view of %zu keys, t = 32, then %zu inserts\n", entries.size(), keys.size());
+        std::printf("%10s %14s %16s\n", "view", "take us", "insert ns/op");
+
+        for (bool is_snapshot : { false, true })
+        {
+            tree_type tree(32);
+            tree.bulk_load(entries.begin(), entries.end());
+
+            auto started = std::chrono::steady_clock::now();
+            std::optional<tree_type> copy;
+            std::optional<tree_type::snapshot> snapshot;
+            if (is_snapshot)
+            {
+                snapshot.emplace(tree.take_snapshot());
+            }
+            else
+            {
+                copy.emplace(tree);
+            }
+            auto const taken = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started);
+
+            started = std::chrono::steady_clock::now();
+            for (auto key : keys)
+            {
+                tree.insert(key, 1);
+            }
+            auto const inserted = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started);
+
+            std::printf("%10s %14.1f %16.1f\n", is_snapshot ? "snapshot" : "copy", taken.count(),
+                inserted.count() / keys.size());
+        }
+    }
+
+    // shared_ptr with no relocation_traits specialization, so node shifts move and destroy it slot by slot
+    struct boxed_pointer
+    {
+
+        std::shared_ptr<int> pointer;
+
+    };
+
+    template<
+        typename tvalue,
+        typename tmake>
+    void measure_relocation(
+        char const *value_name,
+        std::vector<int> const &keys,
+        tmake make)
+    {
+        using tree_type = b_tree<int, tvalue, associative_container<int, int>::default_key_comparer>;
+
+        for (size_t t : { 8, 64, 256 })
+        {
+            tree_type tree(t);
+
+            auto started = std::chrono::steady_clock::now();
+            for (auto key : keys)
+            {
+                tree.insert(key, make(key));
+            }
+            auto const inserted = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started);
+
+            started = std::chrono::steady_clock::now();
+            for (auto key : keys)
+            {
+                tree.dispose(key);
+            }
+            auto const disposed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started);
+
+            std::printf("%6zu %20s %16.1f %16.1f\n", t, value_name,
+                inserted.count() / keys.size(), disposed.count() / keys.size());
+        }
+    }
+
+    // entries shifted by memmove against move construction per slot, for values holding reference counts
+    template<
+        typename ttree>
+    double nanoseconds_per_lookup(
+        ttree &tree,
+        std::vector<int> const &keys,
+        std::vector<associative_container<int, int>::key_value_pair> const &entries)
+    {
+        tree.bulk_load(entries.begin(), entries.end());
+
+        int checksum = 0;
+        auto const started = std::chrono::steady_clock::now();
+        for (auto key : keys)
+        {
+            checksum += tree.obtain(key);
+        }
+        auto const elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started);
+
+        return checksum == static_cast<int>(keys.size())
+            ? elapsed.count() / keys.size()
+            : -1;
+    }
+
+    template<
+        size_t order>
+    void measure_fixed_order(
+        std::vector<int> const &keys,
+        std::vector<associative_container<int, int>::key_value_pair> const &entries)
+    {
+        using comparer = associative_container<int, int>::default_key_comparer;
+
+        b_tree<int, int, comparer> runtime_order_tree(order);
+        b_tree<int, int, comparer, order> compile_time_order_tree(order);
+
+        std::printf("%6zu %16.1f %16.1f\n", order, nanoseconds_per_lookup(runtime_order_tree, keys, entries),
+            nanoseconds_per_lookup(compile_time_order_tree, keys, entries));
+    }
+
+    // same tree with node order given to constructor and as template argument
+    void fixed_order_benchmark()
+    {
+        std::vector<associative_container<int, int>::key_value_pair> entries;
+        entries.reserve(tree_keys_count);
+        for (size_t i = 0; i < tree_keys_count; ++i)
+        {
+            entries.emplace_back(static_cast<int>(i), 1);
+        }
+
+        std::vector<int> keys(lookups_count / 4);
+        std::mt19937 rng(11);
+        for (auto &key : keys)
+        {
+            key = static_cast<int>(rng() % tree_keys_count);
+        }
+
+        std::printf("\nlookups in %zu int keys, runtime vs compile-time node order\n", tree_keys_count);
+        std::printf("%6s %16s %16s\n", "t", "runtime ns/op", "fixed ns/op");
+
+        measure_fixed_order<4>(keys, entries);
+        measure_fixed_order<8>(keys, entries);
+        measure_fixed_order<16>(keys, entries);
+        measure_fixed_order<32>(keys, entries);
+        measure_fixed_order<64>(keys, entries);
+    }
+
+    // trees below parallel threshold are copied and destroyed by calling thread, larger ones by worker pool
+    void copy_teardown_benchmark()
+    {
+        using tree_type = b_tree<int, std::string, associative_container<int, std::string>::default_key_comparer>;
+
+        std::printf("\ncopy and teardown, t = 32, %zu-key parallel threshold, %u hardware threads\n",
+            tree_type::parallel_threshold, std::thread::hardware_concurrency());
+        std::printf("%10s %12s %14s %12s %14s\n", "keys", "copy ms", "copy ns/key", "clear ms", "clear ns/key");
+
+        for (size_t count : { tree_type::parallel_threshold / 4, tree_type::parallel_threshold * 16 })
+        {
+            std::vector<associative_container<int, std::string>::key_value_pair> entries;
+            entries.reserve(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                entries.emplace_back(static_cast<int>(i), "value of key " + std::to_string(i));
+            }
+
+            tree_type tree(32);
+            tree.bulk_load(entries.begin(), entries.end());
+
+            auto started = std::chrono::steady_clock::now();
+            auto copy = std::make_unique<tree_type>(tree);
+            auto const copied = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started);
+
+            started = std::chrono::steady_clock::now();
+            copy.reset();
+            auto const cleared = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started);
+
+            std::printf("%10zu %12.2f %14.1f %12.2f %14.1f\n", count, copied.count(), copied.count() * 1e6 / count,
+                cleared.count(), cleared.count() * 1e6 / count);
+        }
+    }
+
+    void relocation_benchmark()
+    {
+        std::vector<int> keys(tree_keys_count);
+        std::iota(keys.begin(), keys.end(), 0);
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(9));
+
+        std::printf("\ninsert and dispose of %zu random keys\n", keys.size());
+        std::printf("%6s %20s %16s %16s\n", "t", "value", "insert ns/op", "dispose ns/op");
+
+        measure_relocation<std::shared_ptr<int>>("shared_ptr (memmove)", keys, [](int key)
+        {
+            return std::make_shared<int>(key);
+        });
+        measure_relocation<boxed_pointer>("boxed_pointer (move)", keys, [](int key)
+        {
+            return boxed_pointer{ std::make_shared<int>(key) };
+        });
+    }
+
+    // every thread either obtains a random prefilled key or inserts/disposes keys of its own range
+    void thread_scaling_benchmark(
+        unsigned read_percentage)
+    {
+        size_t const prefilled_keys_count = 1 << 18;
+        size_t const operations_per_thread = 1 << 17;
+
+        b_tree<int, int, associative_container<int, int>::default_key_comparer> tree(32);
+        for (size_t i = 0; i < prefilled_keys_count; ++i)
+        {
+            tree.insert(static_cast<int>(i), 1);
+        }
+
+        std::printf("\nthread scaling, %u%% obtain / %u%% insert+dispose, %zu operations per thread\n",
+            read_percentage, 100 - read_percentage, operations_per_thread);
+        std::printf("%8s %16s\n", "threads", "Mops/s");
+
+        for (size_t threads_count : { 1, 2, 4, 8, 16, 32 })
+        {
+            std::vector<std::thread> threads;
+            auto const started = std::chrono::steady_clock::now();
+
+            for (size_t thread_index = 0; thread_index < threads_count; ++thread_index)
+            {
+                threads.emplace_back([&tree, thread_index, read_percentage, prefilled_keys_count, operations_per_thread]()
+                {
+                    std::mt19937 rng(static_cast<unsigned>(thread_index));
+                    int const own_keys_begin = static_cast<int>(prefilled_keys_count + thread_index * operations_per_thread);
+                    int inserted = 0;
+                    int disposed = 0;
+
+                    for (size_t i = 0; i < operations_per_thread; ++i)
+                    {
+                        if (rng() % 100 < read_percentage)
+                        {
+                            tree.obtain(static_cast<int>(rng() % prefilled_keys_count));
+                        }
+                        else if (disposed < inserted && (rng() & 1))
+                        {
+                            tree.dispose(own_keys_begin + disposed++);
+                        }
+                        else
+                        {
+                            tree.insert(own_keys_begin + inserted++, 1);
+                        }
+                    }
+
+                    while (disposed < inserted)
+                    {
+                        tree.dispose(own_keys_begin + disposed++);
+                    }
+                });
+            }
+
+            for (auto &thread : threads)
+            {
+                thread.join();
+            }
+
+            auto const elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started);
+            std::printf("%8zu %16.2f\n", threads_count,
+                static_cast<double>(threads_count * operations_per_thread) / elapsed.count());
+        }
+    }
+
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+    node_search_benchmark<int>("int");
+    node_search_benchmark<long long>("long long");
+    node_search_benchmark<double>("double");
+
+    comparer_benchmark<int>("int");
+    comparer_benchmark<std::string>("std::string");
+
+    bulk_load_benchmark();
+    batch_benchmark();
+    seek_benchmark();
+    order_statistics_benchmark();
+    logging_benchmark();
+    snapshot_benchmark();
+    copy_teardown_benchmark();
+    relocation_benchmark();
+    fixed_order_benchmark();
+
+    thread_scaling_benchmark(95);
+    thread_scaling_benchmark(50);
+
+    return 0;
+}
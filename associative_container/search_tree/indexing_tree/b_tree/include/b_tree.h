@@ -4,12 +4,26 @@
 #include <search_tree.h>
 
 #include <extra_utility.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <limits>
 #include <mutex>
-
+#include <numeric>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+// nonzero torder fixes node order at compile time, so node bounds fold into constants; t given to constructor must
+// then be equal to it
 template<
     typename tkey,
-    typename tvalue>
-class b_tree final : public search_tree<tkey, tvalue> {
+    typename tvalue,
+    typename tcomparer = std::function<int(tkey const &, tkey const &)>,
+    size_t torder = 0>
+class b_tree : public search_tree<tkey, tvalue, tcomparer> {
 
 public:
     
@@ -18,7 +32,7 @@ public:
     class infix_iterator final
     {
         
-        friend class b_tree<tkey, tvalue>;
+        friend class b_tree<tkey, tvalue, tcomparer, torder>;
         
     public:
 
@@ -38,18 +52,18 @@ public:
     private:
     
         infix_iterator(
-            typename search_tree<tkey, tvalue>::common_node *node);
+            typename search_tree<tkey, tvalue, tcomparer>::common_node *node);
     
     private:
     
-        std::stack<std::pair<typename search_tree<tkey, tvalue>::common_node*, int>> _state;
+        node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node*, int>> _state;
     
     };
 
     class infix_const_iterator final
     {
         
-        friend class b_tree<tkey, tvalue>;
+        friend class b_tree<tkey, tvalue, tcomparer, torder>;
         
     public:
 
@@ -69,20 +83,20 @@ public:
     private:
     
         infix_const_iterator(
-            typename search_tree<tkey, tvalue>::common_node *node);
+            typename search_tree<tkey, tvalue, tcomparer>::common_node *node);
         
         infix_const_iterator(
-            std::stack<std::pair<typename search_tree<tkey, tvalue>::common_node*, int>> path);
+            node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node*, int>> path);
     
     private:
     
-        std::stack<std::pair<typename search_tree<tkey, tvalue>::common_node*, int>> _state;
+        node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node*, int>> _state;
     
     };
 
     class infix_reverse_iterator final
     {
-        friend class b_tree<tkey, tvalue>;
+        friend class b_tree<tkey, tvalue, tcomparer, torder>;
 
     public:
 
@@ -102,17 +116,17 @@ public:
     private:
 
         infix_reverse_iterator(
-                typename search_tree<tkey, tvalue>::common_node *node);
+                typename search_tree<tkey, tvalue, tcomparer>::common_node *node);
 
     private:
 
-        std::stack<std::pair<typename search_tree<tkey, tvalue>::common_node*, int>> _state;
+        node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node*, int>> _state;
 
     };
 
     class infix_const_reverse_iterator final
     {
-        friend class b_tree<tkey, tvalue>;
+        friend class b_tree<tkey, tvalue, tcomparer, torder>;
 
     public:
 
@@ -132,20 +146,183 @@ public:
     private:
 
         infix_const_reverse_iterator(
-                typename search_tree<tkey, tvalue>::common_node *node);
+                typename search_tree<tkey, tvalue, tcomparer>::common_node *node);
 
         infix_const_reverse_iterator(
-                std::stack<std::pair<typename search_tree<tkey, tvalue>::common_node*, int>> path);
+                node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node*, int>> path);
 
     private:
 
-        std::stack<std::pair<typename search_tree<tkey, tvalue>::common_node*, int>> _state;
+        node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node*, int>> _state;
 
     };
 
 
 #pragma endregion iterators definition
 
+public:
+
+    #pragma region range cursor definition
+
+    // walks entries in keys order both ways from sought position; tree is shared-locked from the first call
+    // until release(), next call relocks it and, if tree was modified meanwhile, finds its place again by key;
+    // cursor must not outlive tree
+    class range_cursor final
+    {
+
+        friend class b_tree<tkey, tvalue, tcomparer, torder>;
+
+    public:
+
+        range_cursor(
+            range_cursor const &other) = delete;
+
+        range_cursor &operator=(
+            range_cursor const &other) = delete;
+
+        range_cursor(
+            range_cursor &&other) noexcept = default;
+
+        range_cursor &operator=(
+            range_cursor &&other) noexcept = default;
+
+    public:
+
+        // positions on first key not less than bound (greater than, if bound is not inclusive)
+        bool seek(
+            tkey const &bound,
+            bool inclusive = true);
+
+        bool seek_first();
+
+        bool seek_last();
+
+        bool next();
+
+        bool prev();
+
+        bool is_valid() const noexcept;
+
+        // references are valid until release() or cursor is moved
+        tkey const &key();
+
+        tvalue &value();
+
+        // appends at most count entries from current one on while they are not beyond upper bound,
+        // leaves cursor on first entry not fetched; returns count of appended entries
+        size_t fetch(
+            std::vector<typename associative_container<tkey, tvalue>::key_value_pair> &entries,
+            size_t count,
+            tkey const &upper_bound,
+            bool upper_bound_inclusive);
+
+        // lets writers in until next call
+        void release();
+
+    private:
+
+        explicit range_cursor(
+            b_tree<tkey, tvalue, tcomparer, torder> *tree);
+
+    private:
+
+        // false if tree was modified since it was released, path is cleared then
+        bool relock();
+
+        // after relock: on released key, or on its successor if it is gone; returns released key
+        tkey reposition();
+
+        void step_forward();
+
+        void step_backward();
+
+        void descend_leftmost(
+            typename search_tree<tkey, tvalue, tcomparer>::common_node *node);
+
+        void descend_rightmost(
+            typename search_tree<tkey, tvalue, tcomparer>::common_node *node);
+
+    private:
+
+        b_tree<tkey, tvalue, tcomparer, torder> *_tree;
+
+        std::shared_lock<std::shared_mutex> _lock;
+
+        size_t _version;
+
+        // entries below top hold subtree index descended into, top one holds index of current key
+        std::vector<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node *, size_t>> _path;
+
+        std::optional<tkey> _released_key;
+
+    };
+
+    #pragma endregion range cursor definition
+
+public:
+
+    #pragma region snapshot definition
+
+    // frozen view of tree taken in O(1): nodes are shared with tree, which copies them before changing, so snapshot
+    // is read without locks while tree is modified; values changed in place (through obtain, non-const iterators or
+    // cursor) are seen by snapshot too; snapshot must be released before tree is destroyed or moved from or into
+    class snapshot final
+    {
+
+        friend class b_tree<tkey, tvalue, tcomparer, torder>;
+
+    public:
+
+        snapshot(
+            snapshot const &other) = delete;
+
+        snapshot &operator=(
+            snapshot const &other) = delete;
+
+        snapshot(
+            snapshot &&other) noexcept;
+
+        snapshot &operator=(
+            snapshot &&other) noexcept;
+
+        ~snapshot() noexcept;
+
+    public:
+
+        tvalue const &obtain(
+            tkey const &key) const;
+
+        [[nodiscard]] size_t size() const noexcept;
+
+        infix_const_iterator cbegin_infix() const noexcept;
+
+        infix_const_iterator cend_infix() const noexcept;
+
+        infix_const_iterator lower_bound(
+            tkey const &key) const;
+
+        infix_const_iterator upper_bound(
+            tkey const &key) const;
+
+        // gives shared nodes back to tree, which frees those it doesn't hold itself
+        void release() noexcept;
+
+    private:
+
+        explicit snapshot(
+            b_tree<tkey, tvalue, tcomparer, torder> *tree,
+            typename search_tree<tkey, tvalue, tcomparer>::common_node *root) noexcept;
+
+    private:
+
+        b_tree<tkey, tvalue, tcomparer, torder> *_tree;
+
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *_root;
+
+    };
+
+    #pragma endregion snapshot definition
+
 public:
     
     #pragma region CRUD operations
@@ -179,6 +356,42 @@ public:
         bool upper_bound_inclusive) override;
     
     #pragma endregion CRUD operations
+
+public:
+
+    #pragma region batched operations
+
+    // keys are processed in ascending order under one lock, each descent starts from the path of the previous key;
+    // results are in batch order
+
+    // false for keys present in tree or earlier in batch
+    std::vector<bool> insert_batch(
+        std::vector<typename associative_container<tkey, tvalue>::key_value_pair> &&entries);
+
+    // nullopt for keys not present in tree
+    std::vector<std::optional<tvalue>> obtain_batch(
+        std::vector<tkey> const &keys);
+
+    // nullopt for keys not present in tree or repeated in batch
+    std::vector<std::optional<tvalue>> dispose_batch(
+        std::vector<tkey> const &keys);
+
+    #pragma endregion batched operations
+
+public:
+
+    #pragma region bulk loading
+
+    // builds empty tree bottom-up from entries given in strictly ascending keys order, without searches and splits;
+    // nodes get fill_factor share of 2t - 1 keys where tree shape allows (not less than t - 1)
+    template<
+        typename tinput_iterator>
+    void bulk_load(
+        tinput_iterator begin,
+        tinput_iterator end,
+        double fill_factor = 1.0);
+
+    #pragma endregion bulk loading
     
 public:
     
@@ -186,23 +399,23 @@ public:
     
     explicit b_tree(
         size_t t,
-        std::function<int(tkey const &, tkey const &)> keys_comparer = typename associative_container<tkey, tvalue>::default_key_comparer(),
+        tcomparer keys_comparer = search_tree<tkey, tvalue, tcomparer>::default_keys_comparer(),
         allocator *allocator = nullptr,
         logger *logger = nullptr);
 
     b_tree(
-        b_tree<tkey, tvalue> const &other);
+        b_tree<tkey, tvalue, tcomparer, torder> const &other);
 
-    b_tree<tkey, tvalue> &operator=(
-        b_tree<tkey, tvalue> const &other);
+    b_tree<tkey, tvalue, tcomparer, torder> &operator=(
+        b_tree<tkey, tvalue, tcomparer, torder> const &other);
 
     b_tree(
-        b_tree<tkey, tvalue> &&other) noexcept;
+        b_tree<tkey, tvalue, tcomparer, torder> &&other) noexcept;
 
-    b_tree<tkey, tvalue> &operator=(
-        b_tree<tkey, tvalue> &&other) noexcept;
+    b_tree<tkey, tvalue, tcomparer, torder> &operator=(
+        b_tree<tkey, tvalue, tcomparer, torder> &&other) noexcept;
 
-    ~b_tree() = default;
+    ~b_tree() noexcept override;
     
     #pragma endregion BTree constructors, assignments, destructor
     
@@ -225,26 +438,120 @@ public:
     infix_const_reverse_iterator crbegin_infix() const noexcept;
 
     infix_const_reverse_iterator crend_infix() const noexcept;
+
+    // positioned on first key not less than key, end if there is none
+    infix_const_iterator lower_bound(
+        tkey const &key) const;
+
+    // positioned on first key greater than key, end if there is none
+    infix_const_iterator upper_bound(
+        tkey const &key) const;
+
+    // positioned on key, end if there is none
+    infix_const_iterator find(
+        tkey const &key) const;
+
+    // positioned on greatest key, end if tree is empty
+    infix_const_iterator clast_infix() const;
+
+    // count of keys less than key
+    size_t rank(
+        tkey const &key) const;
+
+    // positioned on k-th (counting from 0) key in ascending order, end if there are not more than k keys
+    infix_const_iterator select(
+        size_t k) const;
+
+    // count of keys in range, taken from subtree sizes without walking the range
+    size_t count_between(
+        tkey const &lower_bound,
+        tkey const &upper_bound,
+        bool lower_bound_inclusive,
+        bool upper_bound_inclusive) const;
+
+    // cursor is not positioned until seek
+    range_cursor open_cursor();
+
+    snapshot take_snapshot();
     
     #pragma endregion iterators requesting
     
 private:
 
+    static_assert(torder == 0 || torder >= 2, "compile-time node order must be not less than 2");
+
+    // node order given to constructor, equal to torder unless that is 0
     size_t _t;
+
+    // keys count bound known at compile time, 0 if node order is given to constructor
+    static constexpr size_t node_capacity = torder == 0
+        ? 0
+        : 2 * torder - 1;
     
-    mutable std::mutex _mutex;
+    // obtain and obtain_between share the tree, modifying operations own it exclusively
+    mutable std::shared_mutex _mutex;
+
+    // changed under exclusive lock whenever entries may move, released cursors compare it
+    size_t _version;
+
+    // snapshots not yet released; whole tree is torn down by several threads only when none share it
+    size_t _snapshots_count;
     
 private:
 
     void insert_inner(
         typename associative_container<tkey, tvalue>::key_value_pair &&kvp,
         bool is_update);
+
+    // path is found for kvp key and isn't changed unless leaf is split
+    void insert_inner(
+        typename associative_container<tkey, tvalue>::key_value_pair &&kvp,
+        bool is_update,
+        node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node **, int>> &path);
+
+    // path leads to entry to dispose
+    tvalue dispose_inner(
+        node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node **, int>> &path);
+
+protected:
+
+    // full non-root node on top of path takes pending entry (with its right subtree); returns false if nothing is left
+    // to insert, otherwise leaves path on parent and entry with right subtree pending at subtree index there; nodes
+    // it changes get their subtree sizes recounted, ones left on path are counted by caller
+    virtual bool resolve_overflow(
+        node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node **, int>> &path,
+        typename associative_container<tkey, tvalue>::key_value_pair &kvp,
+        size_t &subtree_index,
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *&right_subtree);
+
+    // subtree size of node is recounted from its entries and subtrees, which must be up to date
+    void refresh_subtree_size(
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *node) const noexcept;
+
+    // node in slot is replaced by its copy if snapshots share it, so it may be changed; slot parent must not be shared
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *unshare(
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *&slot);
+
+    // unshares path nodes from root down, retargeting path to copies
+    void unshare_path(
+        node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node **, int>> &path);
+
 public:
-    size_t get_t() const
+
+    // node order, constant folded into node loops when given as template argument
+    size_t get_t() const noexcept
     {
+        if constexpr (torder != 0)
+        {
+            return torder;
+        }
+
         return _t;
     }
 
+    // trees of at least that many entries are copied and torn down by several threads
+    static constexpr size_t parallel_threshold = 1 << 16;
+
 private:
 
     #pragma region utility functions
@@ -253,11 +560,97 @@ private:
     
     inline size_t get_max_keys_count() const noexcept;
     
-    typename search_tree<tkey, tvalue>::common_node *copy(
-        typename search_tree<tkey, tvalue>::common_node const *node);
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *copy(
+        typename search_tree<tkey, tvalue, tcomparer>::common_node const *node);
+    
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *copy(
+        typename search_tree<tkey, tvalue, tcomparer>::common_node const *node,
+        node_slab &slab);
+    
+    // drops reference to node, subtree is destroyed as far as neither tree nor snapshots hold it
+    void clear(
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *node);
     
     void clear(
-        typename search_tree<tkey, tvalue>::common_node *node);
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *node,
+        node_slab &slab);
+    
+    // large tree is copied by threads, each building subtrees below fan out depth in its own slab
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *copy_tree(
+        typename search_tree<tkey, tvalue, tcomparer>::common_node const *root);
+    
+    // whole tree is cleared, by threads if it is large and no snapshot shares its nodes
+    void clear_tree() noexcept;
+    
+    // depth of the highest level with enough subtrees to keep workers busy, 0 if tree is too low for that
+    size_t get_fan_out_depth(
+        typename search_tree<tkey, tvalue, tcomparer>::common_node const *root,
+        size_t workers_count) const noexcept;
+    
+    // copies nodes above depth, collecting subtrees at depth with slots their copies are to be put in
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *copy_crown(
+        typename search_tree<tkey, tvalue, tcomparer>::common_node const *node,
+        size_t depth,
+        std::vector<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node const *, typename search_tree<tkey, tvalue, tcomparer>::common_node **>> &subtrees);
+    
+    void collect_subtrees(
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *node,
+        size_t depth,
+        std::vector<typename search_tree<tkey, tvalue, tcomparer>::common_node *> &subtrees) const;
+    
+    // destructs entries and nodes above depth, leaving their blocks to the slab, which is to be dropped at once
+    void discard(
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *node,
+        size_t depth = std::numeric_limits<size_t>::max()) noexcept;
+    
+    // runs tasks on calling thread and up to workers count - 1 more, returns first failure
+    template<
+        typename ttask>
+    static std::exception_ptr run_parallel(
+        size_t tasks_count,
+        size_t workers_count,
+        ttask task) noexcept;
+    
+    static size_t get_workers_count() noexcept;
+
+    // descends to key in O(log n): on miss positions on its successor, unless exact match is required
+    infix_const_iterator seek_infix(
+        tkey const &key,
+        bool exact_match,
+        bool skip_equal) const;
+
+    infix_const_iterator seek_infix(
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *root,
+        tkey const &key,
+        bool exact_match,
+        bool skip_equal) const;
+
+    // count of keys less than key (or not greater, if inclusive), caller holds the lock
+    size_t count_preceding(
+        tkey const &key,
+        bool inclusive) const;
+
+    // keys counts of subtrees by height (leaves are of height 1): least non-root, full and filled at fill factor
+    struct bulk_load_shape final
+    {
+
+        std::vector<size_t> min_keys_count;
+
+        std::vector<size_t> max_keys_count;
+
+        std::vector<size_t> target_keys_count;
+
+    };
+
+    template<
+        typename tinput_iterator>
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *bulk_load_subtree(
+        tinput_iterator &iter,
+        size_t keys_count,
+        size_t height,
+        bool is_root,
+        bulk_load_shape const &shape,
+        tkey const *&previous_key);
     
     #pragma endregion utility functions
 
@@ -271,8 +664,10 @@ private:
 
 template<
     typename tkey,
-    typename tvalue>
-bool b_tree<tkey, tvalue>::infix_iterator::operator==(
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+bool b_tree<tkey, tvalue, tcomparer, torder>::infix_iterator::operator==(
     typename b_tree::infix_iterator const &other) const noexcept
 {
     if (_state.empty() && other._state.empty())
@@ -290,8 +685,10 @@ bool b_tree<tkey, tvalue>::infix_iterator::operator==(
 
 template<
     typename tkey,
-    typename tvalue>
-bool b_tree<tkey, tvalue>::infix_iterator::operator!=(
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+bool b_tree<tkey, tvalue, tcomparer, torder>::infix_iterator::operator!=(
     typename b_tree::infix_iterator const &other) const noexcept
 {
     return !(*this == other);
@@ -299,8 +696,10 @@ bool b_tree<tkey, tvalue>::infix_iterator::operator!=(
 
 template<
     typename tkey,
-    typename tvalue>
-typename b_tree<tkey, tvalue>::infix_iterator &b_tree<tkey, tvalue>::infix_iterator::operator++()
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_iterator &b_tree<tkey, tvalue, tcomparer, torder>::infix_iterator::operator++()
 {
     if (_state.empty())
     {
@@ -351,36 +750,42 @@ typename b_tree<tkey, tvalue>::infix_iterator &b_tree<tkey, tvalue>::infix_itera
 
 template<
     typename tkey,
-    typename tvalue>
-typename b_tree<tkey, tvalue>::infix_iterator b_tree<tkey, tvalue>::infix_iterator::operator++(
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_iterator b_tree<tkey, tvalue, tcomparer, torder>::infix_iterator::operator++(
     int not_used)
 {
     infix_iterator iter = *this;
-    *this++;
+    ++*this;
     return iter;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-std::tuple<size_t, size_t, tkey const &, tvalue &> b_tree<tkey, tvalue>::infix_iterator::operator*() const
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+std::tuple<size_t, size_t, tkey const &, tvalue &> b_tree<tkey, tvalue, tcomparer, torder>::infix_iterator::operator*() const
 {
     if (_state.empty())
     {
         throw std::logic_error("attempt to dereference invalid or end iterator");
     }
     
-    auto *kvp = _state.top().first->keys_and_values;
+    auto *node = _state.top().first;
     auto pos = _state.top().second;
     
-    return std::tuple<size_t, size_t, tkey const &, tvalue &>(_state.size() - 1, pos, kvp[pos].key, kvp[pos].value);
+    return std::tuple<size_t, size_t, tkey const &, tvalue &>(_state.size() - 1, pos, node->keys[pos], node->values[pos]);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-b_tree<tkey, tvalue>::infix_iterator::infix_iterator(
-    typename search_tree<tkey, tvalue>::common_node *node)
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+b_tree<tkey, tvalue, tcomparer, torder>::infix_iterator::infix_iterator(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *node)
 {
     if (node == nullptr)
     {
@@ -400,8 +805,10 @@ b_tree<tkey, tvalue>::infix_iterator::infix_iterator(
 
 template<
     typename tkey,
-    typename tvalue>
-bool b_tree<tkey, tvalue>::infix_const_iterator::operator==(
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+bool b_tree<tkey, tvalue, tcomparer, torder>::infix_const_iterator::operator==(
     b_tree::infix_const_iterator const &other) const noexcept
 {
     if (_state.empty() && other._state.empty())
@@ -419,8 +826,10 @@ bool b_tree<tkey, tvalue>::infix_const_iterator::operator==(
 
 template<
     typename tkey,
-    typename tvalue>
-bool b_tree<tkey, tvalue>::infix_const_iterator::operator!=(
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+bool b_tree<tkey, tvalue, tcomparer, torder>::infix_const_iterator::operator!=(
     b_tree::infix_const_iterator const &other) const noexcept
 {
     return !(*this == other);
@@ -428,8 +837,10 @@ bool b_tree<tkey, tvalue>::infix_const_iterator::operator!=(
 
 template<
     typename tkey,
-    typename tvalue>
-typename b_tree<tkey, tvalue>::infix_const_iterator &b_tree<tkey, tvalue>::infix_const_iterator::operator++()
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_const_iterator &b_tree<tkey, tvalue, tcomparer, torder>::infix_const_iterator::operator++()
 {
     if (_state.empty())
     {
@@ -480,36 +891,42 @@ typename b_tree<tkey, tvalue>::infix_const_iterator &b_tree<tkey, tvalue>::infix
 
 template<
     typename tkey,
-    typename tvalue>
-typename b_tree<tkey, tvalue>::infix_const_iterator b_tree<tkey, tvalue>::infix_const_iterator::operator++(
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_const_iterator b_tree<tkey, tvalue, tcomparer, torder>::infix_const_iterator::operator++(
     int not_used)
 {
-    infix_iterator iter = *this;
-    *this++;
+    infix_const_iterator iter = *this;
+    ++*this;
     return iter;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-std::tuple<size_t, size_t, tkey const &, tvalue const &> b_tree<tkey, tvalue>::infix_const_iterator::operator*() const
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+std::tuple<size_t, size_t, tkey const &, tvalue const &> b_tree<tkey, tvalue, tcomparer, torder>::infix_const_iterator::operator*() const
 {
     if (_state.empty())
     {
         throw std::logic_error("attempt to dereference invalid or end iterator");
     }
     
-    auto *kvp = _state.top().first->keys_and_values;
+    auto *node = _state.top().first;
     auto pos = _state.top().second;
     
-    return std::tuple<size_t, size_t, tkey const &, tvalue const &>(_state.size() - 1, pos, kvp[pos].key, kvp[pos].value);
+    return std::tuple<size_t, size_t, tkey const &, tvalue const &>(_state.size() - 1, pos, node->keys[pos], node->values[pos]);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-b_tree<tkey, tvalue>::infix_const_iterator::infix_const_iterator(
-    typename search_tree<tkey, tvalue>::common_node *node)
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+b_tree<tkey, tvalue, tcomparer, torder>::infix_const_iterator::infix_const_iterator(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *node)
 {
     if (node == nullptr)
     {
@@ -529,16 +946,20 @@ b_tree<tkey, tvalue>::infix_const_iterator::infix_const_iterator(
 
 template<
     typename tkey,
-    typename tvalue>
-b_tree<tkey, tvalue>::infix_const_iterator::infix_const_iterator(
-    std::stack<std::pair<typename search_tree<tkey, tvalue>::common_node*, int>> path):
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+b_tree<tkey, tvalue, tcomparer, torder>::infix_const_iterator::infix_const_iterator(
+    node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node*, int>> path):
         _state(path)
 { }
 
 template<
         typename tkey,
-        typename tvalue>
-bool b_tree<tkey, tvalue>::infix_reverse_iterator::operator==(
+        typename tvalue,
+        typename tcomparer,
+        size_t torder>
+bool b_tree<tkey, tvalue, tcomparer, torder>::infix_reverse_iterator::operator==(
         typename b_tree::infix_reverse_iterator const &other) const noexcept
 {
     if (_state.empty() && other._state.empty())
@@ -556,8 +977,10 @@ bool b_tree<tkey, tvalue>::infix_reverse_iterator::operator==(
 
 template<
         typename tkey,
-        typename tvalue>
-bool b_tree<tkey, tvalue>::infix_reverse_iterator::operator!=(
+        typename tvalue,
+        typename tcomparer,
+        size_t torder>
+bool b_tree<tkey, tvalue, tcomparer, torder>::infix_reverse_iterator::operator!=(
         typename b_tree::infix_reverse_iterator const &other) const noexcept
 {
     return !(*this == other);
@@ -565,8 +988,10 @@ bool b_tree<tkey, tvalue>::infix_reverse_iterator::operator!=(
 
 template<
         typename tkey,
-        typename tvalue>
-typename b_tree<tkey, tvalue>::infix_reverse_iterator &b_tree<tkey, tvalue>::infix_reverse_iterator::operator++()
+        typename tvalue,
+        typename tcomparer,
+        size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_reverse_iterator &b_tree<tkey, tvalue, tcomparer, torder>::infix_reverse_iterator::operator++()
 {
     if (_state.empty())
     {
@@ -622,36 +1047,42 @@ typename b_tree<tkey, tvalue>::infix_reverse_iterator &b_tree<tkey, tvalue>::inf
 
 template<
         typename tkey,
-        typename tvalue>
-typename b_tree<tkey, tvalue>::infix_reverse_iterator b_tree<tkey, tvalue>::infix_reverse_iterator::operator++(
+        typename tvalue,
+        typename tcomparer,
+        size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_reverse_iterator b_tree<tkey, tvalue, tcomparer, torder>::infix_reverse_iterator::operator++(
         int not_used)
 {
     infix_reverse_iterator iter = *this;
-    *this++;
+    ++*this;
     return iter;
 }
 
 template<
         typename tkey,
-        typename tvalue>
-std::tuple<size_t, size_t, tkey const &, tvalue &> b_tree<tkey, tvalue>::infix_reverse_iterator::operator*() const
+        typename tvalue,
+        typename tcomparer,
+        size_t torder>
+std::tuple<size_t, size_t, tkey const &, tvalue &> b_tree<tkey, tvalue, tcomparer, torder>::infix_reverse_iterator::operator*() const
 {
     if (_state.empty())
     {
         throw std::logic_error("attempt to dereference invalid or end iterator");
     }
 
-    auto *kvp = _state.top().first->keys_and_values;
+    auto *node = _state.top().first;
     auto pos = _state.top().second;
 
-    return std::tuple<size_t, size_t, tkey const &, tvalue &>(_state.size() - 1, pos, kvp[pos].key, kvp[pos].value);
+    return std::tuple<size_t, size_t, tkey const &, tvalue &>(_state.size() - 1, pos, node->keys[pos], node->values[pos]);
 }
 
 template<
         typename tkey,
-        typename tvalue>
-b_tree<tkey, tvalue>::infix_reverse_iterator::infix_reverse_iterator(
-        typename search_tree<tkey, tvalue>::common_node *node)
+        typename tvalue,
+        typename tcomparer,
+        size_t torder>
+b_tree<tkey, tvalue, tcomparer, torder>::infix_reverse_iterator::infix_reverse_iterator(
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *node)
 {
     if (node == nullptr)
     {
@@ -671,8 +1102,10 @@ b_tree<tkey, tvalue>::infix_reverse_iterator::infix_reverse_iterator(
 
 template<
         typename tkey,
-        typename tvalue>
-bool b_tree<tkey, tvalue>::infix_const_reverse_iterator::operator==(
+        typename tvalue,
+        typename tcomparer,
+        size_t torder>
+bool b_tree<tkey, tvalue, tcomparer, torder>::infix_const_reverse_iterator::operator==(
         b_tree::infix_const_reverse_iterator const &other) const noexcept
 {
     if (_state.empty() && other._state.empty())
@@ -690,8 +1123,10 @@ bool b_tree<tkey, tvalue>::infix_const_reverse_iterator::operator==(
 
 template<
         typename tkey,
-        typename tvalue>
-bool b_tree<tkey, tvalue>::infix_const_reverse_iterator::operator!=(
+        typename tvalue,
+        typename tcomparer,
+        size_t torder>
+bool b_tree<tkey, tvalue, tcomparer, torder>::infix_const_reverse_iterator::operator!=(
         b_tree::infix_const_reverse_iterator const &other) const noexcept
 {
     return !(*this == other);
@@ -699,8 +1134,10 @@ bool b_tree<tkey, tvalue>::infix_const_reverse_iterator::operator!=(
 
 template<
         typename tkey,
-        typename tvalue>
-typename b_tree<tkey, tvalue>::infix_const_reverse_iterator &b_tree<tkey, tvalue>::infix_const_reverse_iterator::operator++()
+        typename tvalue,
+        typename tcomparer,
+        size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_const_reverse_iterator &b_tree<tkey, tvalue, tcomparer, torder>::infix_const_reverse_iterator::operator++()
 {
     if (_state.empty())
     {
@@ -756,36 +1193,42 @@ typename b_tree<tkey, tvalue>::infix_const_reverse_iterator &b_tree<tkey, tvalue
 
 template<
         typename tkey,
-        typename tvalue>
-typename b_tree<tkey, tvalue>::infix_const_reverse_iterator b_tree<tkey, tvalue>::infix_const_reverse_iterator::operator++(
+        typename tvalue,
+        typename tcomparer,
+        size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_const_reverse_iterator b_tree<tkey, tvalue, tcomparer, torder>::infix_const_reverse_iterator::operator++(
         int not_used)
 {
-    infix_reverse_iterator iter = *this;
-    *this++;
+    infix_const_reverse_iterator iter = *this;
+    ++*this;
     return iter;
 }
 
 template<
         typename tkey,
-        typename tvalue>
-std::tuple<size_t, size_t, tkey const &, tvalue const &> b_tree<tkey, tvalue>::infix_const_reverse_iterator::operator*() const
+        typename tvalue,
+        typename tcomparer,
+        size_t torder>
+std::tuple<size_t, size_t, tkey const &, tvalue const &> b_tree<tkey, tvalue, tcomparer, torder>::infix_const_reverse_iterator::operator*() const
 {
     if (_state.empty())
     {
         throw std::logic_error("attempt to dereference invalid or end iterator");
     }
 
-    auto *kvp = _state.top().first->keys_and_values;
+    auto *node = _state.top().first;
     auto pos = _state.top().second;
 
-    return std::tuple<size_t, size_t, tkey const &, tvalue const &>(_state.size() - 1, pos, kvp[pos].key, kvp[pos].value);
+    return std::tuple<size_t, size_t, tkey const &, tvalue const &>(_state.size() - 1, pos, node->keys[pos], node->values[pos]);
 }
 
 template<
         typename tkey,
-        typename tvalue>
-b_tree<tkey, tvalue>::infix_const_reverse_iterator::infix_const_reverse_iterator(
-        typename search_tree<tkey, tvalue>::common_node *node)
+        typename tvalue,
+        typename tcomparer,
+        size_t torder>
+b_tree<tkey, tvalue, tcomparer, torder>::infix_const_reverse_iterator::infix_const_reverse_iterator(
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *node)
 {
     if (node == nullptr)
     {
@@ -805,732 +1248,2460 @@ b_tree<tkey, tvalue>::infix_const_reverse_iterator::infix_const_reverse_iterator
 
 template<
         typename tkey,
-        typename tvalue>
-b_tree<tkey, tvalue>::infix_const_reverse_iterator::infix_const_reverse_iterator(
-        std::stack<std::pair<typename search_tree<tkey, tvalue>::common_node*, int>> path):
+        typename tvalue,
+        typename tcomparer,
+        size_t torder>
+b_tree<tkey, tvalue, tcomparer, torder>::infix_const_reverse_iterator::infix_const_reverse_iterator(
+        node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node*, int>> path):
         _state(path)
 { }
 
 #pragma endregion infix iterator implementation
 
-#pragma region BTree CRUD imlementation
+#pragma region range cursor implementation
 
 template<
     typename tkey,
-    typename tvalue>
-void b_tree<tkey, tvalue>::insert_inner(
-    typename associative_container<tkey, tvalue>::key_value_pair &&kvp,
-    bool is_update)
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+b_tree<tkey, tvalue, tcomparer, torder>::range_cursor::range_cursor(
+    b_tree<tkey, tvalue, tcomparer, torder> *tree):
+        _tree(tree),
+        _lock(tree->_mutex, std::defer_lock),
+        _version(0)
 {
-    auto path = this->find_path(kvp.key);
-    
-    if (path.top().second >= 0)
+
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+bool b_tree<tkey, tvalue, tcomparer, torder>::range_cursor::seek(
+    tkey const &bound,
+    bool inclusive)
+{
+    relock();
+    _released_key.reset();
+    _path.clear();
+
+    auto *node = reinterpret_cast<typename search_tree<tkey, tvalue, tcomparer>::common_node *>(_tree->_root);
+
+    while (node != nullptr)
     {
-        if (is_update)
+        int const index = _tree->template node_find_path<node_capacity>(node, bound, 0, node->virtual_size - 1);
+        if (index >= 0)
         {
-            (*path.top().first)->keys_and_values[path.top().second] = std::move(kvp);
+            _path.emplace_back(node, index);
+            if (!inclusive)
+            {
+                step_forward();
+            }
+
+            break;
         }
-        else
+
+        size_t const position = -index - 1;
+        if (node->subtrees[0] == nullptr)
         {
-            throw typename search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_exception_exception(kvp.key);
+            // bound is beyond the leaf, its successor is up the path
+            _path.emplace_back(node, std::min(position, node->virtual_size - 1));
+            if (position == node->virtual_size)
+            {
+                step_forward();
+            }
+
+            break;
         }
-        
-        return;
+
+        _path.emplace_back(node, position);
+        node = node->subtrees[position];
     }
-    
-    if (is_update)
+
+    return !_path.empty();
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+bool b_tree<tkey, tvalue, tcomparer, torder>::range_cursor::seek_first()
+{
+    relock();
+    _released_key.reset();
+    _path.clear();
+
+    descend_leftmost(reinterpret_cast<typename search_tree<tkey, tvalue, tcomparer>::common_node *>(_tree->_root));
+
+    return !_path.empty();
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+bool b_tree<tkey, tvalue, tcomparer, torder>::range_cursor::seek_last()
+{
+    relock();
+    _released_key.reset();
+    _path.clear();
+
+    descend_rightmost(reinterpret_cast<typename search_tree<tkey, tvalue, tcomparer>::common_node *>(_tree->_root));
+
+    return !_path.empty();
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+bool b_tree<tkey, tvalue, tcomparer, torder>::range_cursor::next()
+{
+    if (!relock())
     {
-        throw typename search_tree<tkey, tvalue>::updating_of_nonexistent_key_attempt_exception(kvp.key);
+        tkey const released_key = reposition();
+
+        // released entry is gone, its successor is already the next one
+        if (_path.empty() || _tree->_keys_comparer(key(), released_key) != 0)
+        {
+            return !_path.empty();
+        }
     }
-    
-    if (*path.top().first == nullptr && path.size() == 1)
+
+    if (!_path.empty())
     {
-        typename search_tree<tkey, tvalue>::common_node *new_node = this->create_node(_t);
-        *path.top().first = new_node;
-        allocator::construct(new_node->keys_and_values, std::move(kvp));
-        ++new_node->virtual_size;
-        
-        return;
+        step_forward();
     }
-    
-    typename search_tree<tkey, tvalue>::common_node *node = *path.top().first;
-    typename search_tree<tkey, tvalue>::common_node *right_subtree = nullptr;
-    size_t subtree_index = -path.top().second - 1;
-    
-    while(true)
+
+    return !_path.empty();
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+bool b_tree<tkey, tvalue, tcomparer, torder>::range_cursor::prev()
+{
+    if (!relock())
     {
-        if (node->virtual_size < get_max_keys_count())
-        {
-            this->node_insert(node, std::move(kvp), subtree_index, right_subtree);
-            return;
-        }
-        
-        auto pair = this->node_split(node, std::move(kvp), subtree_index, right_subtree);
-        right_subtree = pair.first;
-        kvp = std::move(pair.second);
-        
-        
-        if (path.size() == 1)
+        reposition();
+
+        if (_path.empty())
         {
-            typename search_tree<tkey, tvalue>::common_node *new_root = this->create_node(_t);
-            allocator::construct(new_root->keys_and_values, std::move(kvp));
-            new_root->virtual_size = 1;
-            new_root->subtrees[0] = node;
-            new_root->subtrees[1] = right_subtree;
-            *path.top().first = new_root;
-            return;
+            return seek_last();
         }
-        
-        path.pop();
-        node = *path.top().first;
-        subtree_index = -path.top().second - 1;
     }
+
+    if (!_path.empty())
+    {
+        step_backward();
+    }
+
+    return !_path.empty();
 }
 
 template<
     typename tkey,
-    typename tvalue>
-void b_tree<tkey, tvalue>::insert(
-    tkey const &key,
-    tvalue const &value)
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+bool b_tree<tkey, tvalue, tcomparer, torder>::range_cursor::is_valid() const noexcept
 {
-    std::lock_guard<std::mutex> lock(_mutex);
-    
-    this->trace_with_guard(get_typename() + "::insert(tkey const &, tvalue const &) : called.")
-        ->debug_with_guard(get_typename() + "::insert(tkey const &, tvalue const &) : called.")
-        ->debug_with_guard(get_typename() + "::insert(tkey const &, tvalue const &) : inserting node with key \"" + 
-            extra_utility::make_string(key) + "\"");
-    
-    try
-    {
-        insert_inner(std::move(typename associative_container<tkey, tvalue>::key_value_pair(key, value)), false);
-    }
-    catch (typename search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_exception_exception const &)
+    return !_path.empty() || _released_key.has_value();
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+tkey const &b_tree<tkey, tvalue, tcomparer, torder>::range_cursor::key()
+{
+    if (!relock())
     {
-        this->error_with_guard(get_typename() + "::insert(tkey const &, tvalue const &) : attempt to insert key duplicate.");
-        throw;
+        reposition();
     }
-    catch (std::bad_alloc const &)
+
+    if (_path.empty())
     {
-        this->error_with_guard(get_typename() + "::insert(tkey const &, tvalue const &) : bad alloc occurred.");
-        throw;
+        throw std::logic_error("attempt to dereference not positioned cursor");
     }
-    
-    this->trace_with_guard(get_typename() + "::insert(tkey const &, tvalue const &) : successfuly finished.")
-        ->debug_with_guard(get_typename() + "::insert(tkey const &, tvalue const &) : successfuly finished.");
+
+    return _path.back().first->keys[_path.back().second];
 }
 
 template<
     typename tkey,
-    typename tvalue>
-void b_tree<tkey, tvalue>::insert(
-    tkey const &key,
-    tvalue &&value)
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+tvalue &b_tree<tkey, tvalue, tcomparer, torder>::range_cursor::value()
 {
-    std::lock_guard<std::mutex> lock(_mutex);
-    
-    this->trace_with_guard(get_typename() + "::insert(tkey const &, tvalue &&) : called.")
-        ->debug_with_guard(get_typename() + "::insert(tkey const &, tvalue &&) : called.")
-        ->debug_with_guard(get_typename() + "::insert(tkey const &, tvalue &&) : inserting node with key \"" + 
-            extra_utility::make_string(key) + "\"");
-    
-    try
+    if (!relock())
     {
-        insert_inner(std::move(typename associative_container<tkey, tvalue>::key_value_pair(key, std::move(value))), false);
+        reposition();
     }
-    catch (typename search_tree<tkey, tvalue>::insertion_of_existent_key_attempt_exception_exception const &)
+
+    if (_path.empty())
+    {
+        throw std::logic_error("attempt to dereference not positioned cursor");
+    }
+
+    return _path.back().first->values[_path.back().second];
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+size_t b_tree<tkey, tvalue, tcomparer, torder>::range_cursor::fetch(
+    std::vector<typename associative_container<tkey, tvalue>::key_value_pair> &entries,
+    size_t count,
+    tkey const &upper_bound,
+    bool upper_bound_inclusive)
+{
+    if (!relock())
+    {
+        reposition();
+    }
+
+    size_t fetched = 0;
+
+    while (fetched < count && !_path.empty())
+    {
+        auto *node = _path.back().first;
+        auto const index = _path.back().second;
+
+        if (_tree->_keys_comparer(node->keys[index], upper_bound) >= (upper_bound_inclusive ? 1 : 0))
+        {
+            break;
+        }
+
+        entries.emplace_back(node->keys[index], node->values[index]);
+        ++fetched;
+        step_forward();
+    }
+
+    return fetched;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+void b_tree<tkey, tvalue, tcomparer, torder>::range_cursor::release()
+{
+    if (!_lock.owns_lock())
+    {
+        return;
+    }
+
+    if (_path.empty())
+    {
+        _released_key.reset();
+    }
+    else
+    {
+        _released_key.emplace(_path.back().first->keys[_path.back().second]);
+    }
+
+    _version = _tree->_version;
+    _lock.unlock();
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+bool b_tree<tkey, tvalue, tcomparer, torder>::range_cursor::relock()
+{
+    if (_lock.owns_lock())
+    {
+        return true;
+    }
+
+    _lock.lock();
+
+    if (!_released_key.has_value() || _version == _tree->_version)
+    {
+        _released_key.reset();
+        return true;
+    }
+
+    _path.clear();
+    return false;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+tkey b_tree<tkey, tvalue, tcomparer, torder>::range_cursor::reposition()
+{
+    // seek resets released key, so it is taken out first
+    tkey released_key = std::move(*_released_key);
+    seek(released_key, true);
+
+    return released_key;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+void b_tree<tkey, tvalue, tcomparer, torder>::range_cursor::step_forward()
+{
+    auto *node = _path.back().first;
+    auto const index = _path.back().second;
+
+    if (node->subtrees[0] != nullptr)
+    {
+        _path.back().second = index + 1;
+        descend_leftmost(node->subtrees[index + 1]);
+        return;
+    }
+
+    if (index + 1 < node->virtual_size)
+    {
+        ++_path.back().second;
+        return;
+    }
+
+    // leaf is passed: the next key is the one after the deepest subtree which is not the last
+    _path.pop_back();
+    while (!_path.empty() && _path.back().second == _path.back().first->virtual_size)
+    {
+        _path.pop_back();
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+void b_tree<tkey, tvalue, tcomparer, torder>::range_cursor::step_backward()
+{
+    auto *node = _path.back().first;
+    auto const index = _path.back().second;
+
+    if (node->subtrees[0] != nullptr)
+    {
+        descend_rightmost(node->subtrees[index]);
+        return;
+    }
+
+    if (index > 0)
+    {
+        --_path.back().second;
+        return;
+    }
+
+    _path.pop_back();
+    while (!_path.empty() && _path.back().second == 0)
+    {
+        _path.pop_back();
+    }
+
+    if (!_path.empty())
+    {
+        --_path.back().second;
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+void b_tree<tkey, tvalue, tcomparer, torder>::range_cursor::descend_leftmost(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *node)
+{
+    if (node == nullptr)
+    {
+        return;
+    }
+
+    while (node->subtrees[0] != nullptr)
+    {
+        _path.emplace_back(node, 0);
+        node = node->subtrees[0];
+    }
+
+    _path.emplace_back(node, 0);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+void b_tree<tkey, tvalue, tcomparer, torder>::range_cursor::descend_rightmost(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *node)
+{
+    if (node == nullptr)
+    {
+        return;
+    }
+
+    while (node->subtrees[0] != nullptr)
+    {
+        _path.emplace_back(node, node->virtual_size);
+        node = node->subtrees[node->virtual_size];
+    }
+
+    _path.emplace_back(node, node->virtual_size - 1);
+}
+
+#pragma endregion range cursor implementation
+
+#pragma region snapshot implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+b_tree<tkey, tvalue, tcomparer, torder>::snapshot::snapshot(
+    b_tree<tkey, tvalue, tcomparer, torder> *tree,
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *root) noexcept:
+        _tree(tree),
+        _root(root)
+{
+
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+b_tree<tkey, tvalue, tcomparer, torder>::snapshot::snapshot(
+    snapshot &&other) noexcept:
+        _tree(other._tree),
+        _root(other._root)
+{
+    other._root = nullptr;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::snapshot &b_tree<tkey, tvalue, tcomparer, torder>::snapshot::operator=(
+    snapshot &&other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        _tree = other._tree;
+        _root = other._root;
+        other._root = nullptr;
+    }
+
+    return *this;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+b_tree<tkey, tvalue, tcomparer, torder>::snapshot::~snapshot() noexcept
+{
+    release();
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+tvalue const &b_tree<tkey, tvalue, tcomparer, torder>::snapshot::obtain(
+    tkey const &key) const
+{
+    auto iter = _tree->seek_infix(_root, key, true, false);
+    if (iter == cend_infix())
+    {
+        throw typename search_tree<tkey, tvalue, tcomparer>::obtaining_of_nonexistent_key_attempt_exception(key);
+    }
+
+    return std::get<3>(*iter);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+size_t b_tree<tkey, tvalue, tcomparer, torder>::snapshot::size() const noexcept
+{
+    return _root == nullptr
+        ? 0
+        : _root->subtree_size;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_const_iterator b_tree<tkey, tvalue, tcomparer, torder>::snapshot::cbegin_infix() const noexcept
+{
+    return infix_const_iterator(_root);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_const_iterator b_tree<tkey, tvalue, tcomparer, torder>::snapshot::cend_infix() const noexcept
+{
+    return infix_const_iterator(nullptr);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_const_iterator b_tree<tkey, tvalue, tcomparer, torder>::snapshot::lower_bound(
+    tkey const &key) const
+{
+    return _tree->seek_infix(_root, key, false, false);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_const_iterator b_tree<tkey, tvalue, tcomparer, torder>::snapshot::upper_bound(
+    tkey const &key) const
+{
+    return _tree->seek_infix(_root, key, false, true);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+void b_tree<tkey, tvalue, tcomparer, torder>::snapshot::release() noexcept
+{
+    if (_root == nullptr)
+    {
+        return;
+    }
+
+    // references are changed by writers only, under exclusive lock
+    std::lock_guard<std::shared_mutex> lock(_tree->_mutex);
+
+    _tree->clear(_root);
+    --_tree->_snapshots_count;
+    _root = nullptr;
+}
+
+#pragma endregion snapshot implementation
+
+#pragma region BTree CRUD imlementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+void b_tree<tkey, tvalue, tcomparer, torder>::insert_inner(
+    typename associative_container<tkey, tvalue>::key_value_pair &&kvp,
+    bool is_update)
+{
+    auto path = this->template find_path<node_capacity>(kvp.key);
+    insert_inner(std::move(kvp), is_update, path);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+void b_tree<tkey, tvalue, tcomparer, torder>::insert_inner(
+    typename associative_container<tkey, tvalue>::key_value_pair &&kvp,
+    bool is_update,
+    node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node **, int>> &path)
+{
+    if (path.top().second >= 0)
+    {
+        if (is_update)
+        {
+            unshare_path(path);
+            (*path.top().first)->keys[path.top().second] = std::move(kvp.key);
+            (*path.top().first)->values[path.top().second] = std::move(kvp.value);
+        }
+        else
+        {
+            throw typename search_tree<tkey, tvalue, tcomparer>::insertion_of_existent_key_attempt_exception_exception(kvp.key);
+        }
+        
+        return;
+    }
+    
+    if (is_update)
+    {
+        throw typename search_tree<tkey, tvalue, tcomparer>::updating_of_nonexistent_key_attempt_exception(kvp.key);
+    }
+    
+    ++_version;
+    unshare_path(path);
+    
+    if (*path.top().first == nullptr && path.size() == 1)
+    {
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *new_node = this->create_node(get_t());
+        *path.top().first = new_node;
+        this->node_construct_entry(new_node, 0, std::move(kvp));
+        ++new_node->virtual_size;
+        new_node->subtree_size = 1;
+        
+        return;
+    }
+    
+    // full node on path takes at most two new nodes to resolve its overflow: split off one and new root (or, in
+    // b_star_tree, copy of shared sibling); they are reserved, so restructuring is not left halfway by bad_alloc
+    size_t full_nodes_count = 0;
+    while (full_nodes_count < path.size() &&
+        (*(path.end() - full_nodes_count - 1)->first)->virtual_size == get_max_keys_count())
+    {
+        ++full_nodes_count;
+    }
+    this->_nodes_slab.reserve(2 * full_nodes_count);
+    
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *node = *path.top().first;
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *right_subtree = nullptr;
+    size_t subtree_index = -path.top().second - 1;
+    
+    while(true)
+    {
+        if (node->virtual_size < get_max_keys_count())
+        {
+            this->node_insert(node, std::move(kvp), subtree_index, right_subtree);
+            break;
+        }
+        
+        if (path.size() == 1)
+        {
+            auto pair = this->node_split(node, std::move(kvp), subtree_index, right_subtree);
+            typename search_tree<tkey, tvalue, tcomparer>::common_node *new_root = this->create_node(get_t());
+            this->node_construct_entry(new_root, 0, std::move(pair.second));
+            new_root->virtual_size = 1;
+            new_root->subtrees[0] = node;
+            new_root->subtrees[1] = pair.first;
+            refresh_subtree_size(node);
+            refresh_subtree_size(pair.first);
+            refresh_subtree_size(new_root);
+            *path.top().first = new_root;
+            return;
+        }
+        
+        if (!resolve_overflow(path, kvp, subtree_index, right_subtree))
+        {
+            break;
+        }
+        
+        node = *path.top().first;
+    }
+    
+    // nodes left on path gain an entry in their subtrees, restructured ones are recounted already
+    for (auto &entry : path)
+    {
+        ++(*entry.first)->subtree_size;
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+bool b_tree<tkey, tvalue, tcomparer, torder>::resolve_overflow(
+    node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node **, int>> &path,
+    typename associative_container<tkey, tvalue>::key_value_pair &kvp,
+    size_t &subtree_index,
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *&right_subtree)
+{
+    auto pair = this->node_split(*path.top().first, std::move(kvp), subtree_index, right_subtree);
+    right_subtree = pair.first;
+    kvp = std::move(pair.second);
+    refresh_subtree_size(*path.top().first);
+    refresh_subtree_size(right_subtree);
+    
+    path.pop();
+    subtree_index = -path.top().second - 1;
+    
+    return true;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+void b_tree<tkey, tvalue, tcomparer, torder>::insert(
+    tkey const &key,
+    tvalue const &value)
+{
+    std::lock_guard<std::shared_mutex> lock(_mutex);
+    
+    this->trace_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue const &) : called."; })
+        ->debug_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue const &) : called."; })
+        ->debug_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue const &) : inserting node with key \"" + 
+            extra_utility::make_string(key) + "\""; });
+    
+    try
+    {
+        insert_inner(std::move(typename associative_container<tkey, tvalue>::key_value_pair(key, value)), false);
+    }
+    catch (typename search_tree<tkey, tvalue, tcomparer>::insertion_of_existent_key_attempt_exception_exception const &)
+    {
+        this->error_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue const &) : attempt to insert key duplicate."; });
+        throw;
+    }
+    catch (std::bad_alloc const &)
+    {
+        this->error_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue const &) : bad alloc occurred."; });
+        throw;
+    }
+    
+    this->trace_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue const &) : successfuly finished."; })
+        ->debug_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue const &) : successfuly finished."; });
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+void b_tree<tkey, tvalue, tcomparer, torder>::insert(
+    tkey const &key,
+    tvalue &&value)
+{
+    std::lock_guard<std::shared_mutex> lock(_mutex);
+    
+    this->trace_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue &&) : called."; })
+        ->debug_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue &&) : called."; })
+        ->debug_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue &&) : inserting node with key \"" + 
+            extra_utility::make_string(key) + "\""; });
+    
+    try
+    {
+        insert_inner(std::move(typename associative_container<tkey, tvalue>::key_value_pair(key, std::move(value))), false);
+    }
+    catch (typename search_tree<tkey, tvalue, tcomparer>::insertion_of_existent_key_attempt_exception_exception const &)
+    {
+        this->error_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue const &) : attempt to insert key duplicate."; });
+        throw;
+    }
+    catch (std::bad_alloc const &)
+    {
+        this->error_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue const &) : bad alloc occurred."; });
+        throw;
+    }
+    
+    this->trace_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue &&) : successfuly finished."; })
+        ->debug_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue &&) : successfuly finished."; });
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+void b_tree<tkey, tvalue, tcomparer, torder>::update(
+    tkey const &key,
+    tvalue const &value)
+{
+    std::lock_guard<std::shared_mutex> lock(_mutex);
+    
+    this->trace_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue const &) : called."; })
+        ->debug_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue const &) : called."; })
+        ->debug_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue const &) : inserting node with key \"" + 
+            extra_utility::make_string(key) + "\""; });
+    
+    try
+    {
+        insert_inner(std::move(typename associative_container<tkey, tvalue>::key_value_pair(key, value)), true);
+    }
+    catch (typename search_tree<tkey, tvalue, tcomparer>::updating_of_nonexistent_key_attempt_exception const &)
+    {
+        this->error_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue const &) : attempt to update value by non-existent key."; });
+        throw;
+    }
+    catch (std::bad_alloc const &)
+    {
+        this->error_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue const &) : bad alloc occurred."; });
+        throw;
+    }
+    
+    this->trace_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue const &) : successfuly finished."; })
+        ->debug_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue const &) : successfuly finished."; });
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+void b_tree<tkey, tvalue, tcomparer, torder>::update(
+    tkey const &key,
+    tvalue &&value)
+{
+    std::lock_guard<std::shared_mutex> lock(_mutex);
+    
+    this->trace_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue &&) : called."; })
+        ->debug_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue &&) : called."; })
+        ->debug_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue &&) : inserting node with key \"" + 
+            extra_utility::make_string(key) + "\""; });
+    
+    try
+    {
+        insert_inner(std::move(typename associative_container<tkey, tvalue>::key_value_pair(key, std::move(value))), true);
+    }
+    catch (typename search_tree<tkey, tvalue, tcomparer>::updating_of_nonexistent_key_attempt_exception const &)
+    {
+        this->error_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue const &) : attempt to update value by non-existent key."; });
+        throw;
+    }
+    catch (std::bad_alloc const &)
+    {
+        this->error_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue const &) : bad alloc occurred."; });
+        throw;
+    }
+    
+    this->trace_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue &&) : successfuly finished."; })
+        ->debug_with_guard([&]() { return get_typename() + "::insert(tkey const &, tvalue &&) : successfuly finished."; });
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+tvalue &b_tree<tkey, tvalue, tcomparer, torder>::obtain(
+    tkey const &key)
+{
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+    
+    this->trace_with_guard([&]() { return get_typename() + "::obtain(tkey const &) : called."; })
+        ->debug_with_guard([&]() { return get_typename() + "::obtain(tkey const &) : called."; });
+    
+    auto path = this->template find_path<node_capacity>(key);
+    if (path.top().second < 0)
+    {
+        this->error_with_guard([&]() { return get_typename() + "::obtain(tkey const &) : key \"" +
+                extra_utility::make_string(key) + "\" is not present in container."; });
+        throw typename search_tree<tkey, tvalue, tcomparer>::obtaining_of_nonexistent_key_attempt_exception(key);
+    }
+    
+    this->trace_with_guard([&]() { return get_typename() + "::obtain(tkey const &) : successfuly finished."; })
+        ->debug_with_guard([&]() { return get_typename() + "::obtain(tkey const &) : successfuly finished."; });
+    
+    return (*path.top().first)->values[path.top().second];
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+tvalue b_tree<tkey, tvalue, tcomparer, torder>::dispose(
+    tkey const &key)
+{
+    std::lock_guard<std::shared_mutex> lock(_mutex);
+    
+    this->trace_with_guard([&]() { return get_typename() + "::dispose(tkey const &) : called."; })
+        ->debug_with_guard([&]() { return get_typename() + "::dispose(tkey const &) : called."; })
+        ->debug_with_guard([&]() { return get_typename() + "::dispose(tkey const &) : disposing node with key \"" + 
+            extra_utility::make_string(key) + "\""; });
+    
+    auto path = this->template find_path<node_capacity>(key);
+    if (path.top().second < 0)
+    {
+        this->error_with_guard([&]() { return get_typename() + "::dispose(tkey const &) : key \"" +
+                extra_utility::make_string(key) + "\" is not present in container."; });
+        throw typename search_tree<tkey, tvalue, tcomparer>::disposal_of_nonexistent_key_attempt_exception(key);
+    }
+    
+    tvalue value = dispose_inner(path);
+    
+    this->trace_with_guard([&]() { return get_typename() + "::dispose(tkey const &) : successfuly finished."; })
+        ->debug_with_guard([&]() { return get_typename() + "::dispose(tkey const &) : successfuly finished."; });
+    return value;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+tvalue b_tree<tkey, tvalue, tcomparer, torder>::dispose_inner(
+    node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node **, int>> &path)
+{
+    ++_version;
+    unshare_path(path);
+    
+    // Reducing non-leaf disposal to leaf disposal
+    if ((*path.top().first)->subtrees[0] != nullptr)
+    {
+        auto *non_leaf = *path.top().first;
+        auto non_leaf_index = path.top().second;
+        typename search_tree<tkey, tvalue, tcomparer>::common_node **iterator = non_leaf->subtrees + non_leaf_index;
+        path.top().second = -non_leaf_index - 1;
+        
+        // TODO: configure this for min of right subtree (what for???)
+        while (*iterator != nullptr)
+        {
+            auto *descended = unshare(*iterator);
+            auto index = descended->virtual_size;
+            path.emplace(iterator, -index - 1);
+            iterator = descended->subtrees + index;
+        }
+        
+        auto *leaf = *path.top().first;
+        auto &leaf_index = path.top().second;
+        
+        leaf_index = leaf->virtual_size - 1;
+        this->node_swap_entries(non_leaf, non_leaf_index, leaf, leaf_index);
+    }
+    
+    // every node on path loses an entry in its subtree, however it is restructured below
+    for (auto &entry : path)
+    {
+        --(*entry.first)->subtree_size;
+    }
+    
+    auto *target_node = *path.top().first;
+    auto kvp_to_dispose_index = path.top().second;
+    path.pop();
+    
+    tvalue value = std::move(this->node_extract_entry(target_node, kvp_to_dispose_index).value);
+    
+    this->node_relocate_entries(target_node, kvp_to_dispose_index, target_node, kvp_to_dispose_index + 1,
+            target_node->virtual_size - kvp_to_dispose_index - 1);
+    --target_node->virtual_size;
+    
+    while (true)
+    {
+        if (target_node->virtual_size >= get_min_keys_count())
+        {
+            return value;
+        }
+        
+        if (path.size() == 0)
+        {
+            if (target_node->virtual_size == 0)
+            {
+                this->_root = target_node->subtrees[0];
+                this->destroy_node(target_node);
+                this->debug_with_guard([&]() { return get_typename() + "::dispose(tkey const &) : new root is set."; });
+            }
+            
+            return value;
+        }
+        
+        // right parent
+        typename search_tree<tkey, tvalue, tcomparer>::common_node *parent = *path.top().first;
+        size_t parent_index = -path.top().second - 1;
+        path.pop();
+        
+        bool const left_brother_exists = parent_index != 0;
+        bool const can_take_from_left = left_brother_exists && parent->subtrees[parent_index-1]->virtual_size > get_min_keys_count();
+        
+        
+        bool const right_brother_exists = parent_index != parent->virtual_size;
+        bool const can_take_from_right = right_brother_exists && parent->subtrees[parent_index+1]->virtual_size > get_min_keys_count();
+        
+        if (can_take_from_left)
+        {
+            auto *left_brother = unshare(parent->subtrees[parent_index - 1]);
+            
+            this->node_relocate_entries(target_node, 1, target_node, 0, target_node->virtual_size);
+            this->node_relocate_subtrees(target_node, 1, target_node, 0, target_node->virtual_size + 1);
+            
+            this->node_relocate_entries(target_node, 0, parent, parent_index - 1, 1);
+            target_node->subtrees[0] = left_brother->subtrees[left_brother->virtual_size];
+            ++target_node->virtual_size;
+            
+            this->node_relocate_entries(parent, parent_index - 1, left_brother, left_brother->virtual_size - 1, 1);
+            --left_brother->virtual_size;
+            refresh_subtree_size(left_brother);
+            refresh_subtree_size(target_node);
+            
+            return value;
+        }
+        
+        if (can_take_from_right)
+        {
+            auto *right_brother = unshare(parent->subtrees[parent_index + 1]);
+            
+            this->node_relocate_entries(target_node, target_node->virtual_size, parent, parent_index, 1);
+            target_node->subtrees[target_node->virtual_size + 1] = right_brother->subtrees[0];
+            ++target_node->virtual_size;
+            
+            this->node_relocate_entries(parent, parent_index, right_brother, 0, 1);
+            
+            this->node_relocate_entries(right_brother, 0, right_brother, 1, right_brother->virtual_size - 1);
+            this->node_relocate_subtrees(right_brother, 0, right_brother, 1, right_brother->virtual_size);
+            --right_brother->virtual_size;
+            refresh_subtree_size(right_brother);
+            refresh_subtree_size(target_node);
+            
+            return value;
+        }
+        
+        size_t const merged_index = parent_index - (left_brother_exists ? 1 : 0);
+        unshare(parent->subtrees[left_brother_exists ? parent_index - 1 : parent_index + 1]);
+        this->node_merge(parent, merged_index);
+        refresh_subtree_size(parent->subtrees[merged_index]);
+        
+        target_node = parent;
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+std::vector<typename associative_container<tkey, tvalue>::key_value_pair> b_tree<tkey, tvalue, tcomparer, torder>::obtain_between(
+    tkey const &lower_bound,
+    tkey const &upper_bound,
+    bool lower_bound_inclusive,
+    bool upper_bound_inclusive)
+{
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+
+    this->trace_with_guard([&]() { return get_typename() + "::obtain_between(tkey const &, tkey const &, bool, bool) : called."; })
+        ->debug_with_guard([&]() { return get_typename() + "::obtain_between(tkey const &, tkey const &, bool, bool) : called."; });
+
+    auto const &comparer = this->_keys_comparer;
+    std::vector<typename associative_container<tkey, tvalue>::key_value_pair> range;
+    node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node *, int>> path;
+    bool lower_bound_found = false;
+
+    auto *path_finder = reinterpret_cast<typename search_tree<tkey, tvalue, tcomparer>::common_node *>(this->_root);
+
+    // descent compares keys only, values are not touched until the range is collected
+    while (path_finder != nullptr)
+    {
+        int index = this->template node_find_path<node_capacity>(path_finder, lower_bound, 0, path_finder->virtual_size - 1);
+        if (index >= 0)
+        {
+            path.emplace(path_finder, index);
+            lower_bound_found = true;
+            break;
+        }
+
+        path.emplace(path_finder, -index - 2);
+
+        path_finder = path_finder->subtrees[-index - 1];
+    }
+
+    if (path.empty())
+    {
+        return range;
+    }
+
+    auto iter = infix_const_iterator(path);
+    auto end_iter = infix_const_iterator(nullptr);
+
+    // not found lower bound leaves iterator at its predecessor
+    if (!lower_bound_found || !lower_bound_inclusive)
+    {
+        ++iter;
+    }
+
+    while(iter != end_iter &&
+            (comparer(std::get<2>(*iter), upper_bound)) < (upper_bound_inclusive ? 1 : 0))
+    {
+        range.emplace_back(std::get<2>(*iter), std::get<3>(*iter));
+        ++iter;
+    }
+
+    this->trace_with_guard([&]() { return get_typename() + "::obtain_between(tkey const &, tkey const &, bool, bool) : successfuly finished."; })
+        ->debug_with_guard([&]() { return get_typename() + "::obtain_between(tkey const &, tkey const &, bool, bool) : successfuly finished."; });
+
+
+    return range;
+}
+
+#pragma endregion BTree CRUD imlementation
+
+#pragma region BTree batched operations implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+std::vector<bool> b_tree<tkey, tvalue, tcomparer, torder>::insert_batch(
+    std::vector<typename associative_container<tkey, tvalue>::key_value_pair> &&entries)
+{
+    std::lock_guard<std::shared_mutex> lock(_mutex);
+
+    this->trace_with_guard([&]() { return get_typename() + "::insert_batch(std::vector<key_value_pair> &&) : called."; })
+        ->debug_with_guard([&]() { return get_typename() + "::insert_batch(std::vector<key_value_pair> &&) : called."; });
+
+    std::vector<size_t> order(entries.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this, &entries](size_t left, size_t right)
+    {
+        return this->_keys_comparer(entries[left].key, entries[right].key) < 0;
+    });
+
+    std::vector<bool> inserted(entries.size(), false);
+    node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node **, int>> path;
+
+    for (auto index : order)
+    {
+        this->template resume_path<node_capacity>(path, entries[index].key);
+
+        if (path.top().second >= 0)
+        {
+            continue;
+        }
+
+        // path outlives insertion unless leaf (or empty root) is to be split
+        auto const *leaf = *path.top().first;
+        bool const keeps_path = leaf != nullptr && leaf->virtual_size < get_max_keys_count();
+
+        insert_inner(std::move(entries[index]), false, path);
+        inserted[index] = true;
+
+        if (!keeps_path)
+        {
+            path = decltype(path)();
+        }
+    }
+
+    this->trace_with_guard([&]() { return get_typename() + "::insert_batch(std::vector<key_value_pair> &&) : successfuly finished."; })
+        ->debug_with_guard([&]() { return get_typename() + "::insert_batch(std::vector<key_value_pair> &&) : successfuly finished."; });
+
+    return inserted;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+std::vector<std::optional<tvalue>> b_tree<tkey, tvalue, tcomparer, torder>::obtain_batch(
+    std::vector<tkey> const &keys)
+{
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+
+    this->trace_with_guard([&]() { return get_typename() + "::obtain_batch(std::vector<tkey> const &) : called."; })
+        ->debug_with_guard([&]() { return get_typename() + "::obtain_batch(std::vector<tkey> const &) : called."; });
+
+    std::vector<size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this, &keys](size_t left, size_t right)
+    {
+        return this->_keys_comparer(keys[left], keys[right]) < 0;
+    });
+
+    std::vector<std::optional<tvalue>> values(keys.size());
+    node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node **, int>> path;
+
+    for (auto index : order)
+    {
+        this->template resume_path<node_capacity>(path, keys[index]);
+
+        if (path.top().second >= 0)
+        {
+            values[index] = (*path.top().first)->values[path.top().second];
+        }
+    }
+
+    this->trace_with_guard([&]() { return get_typename() + "::obtain_batch(std::vector<tkey> const &) : successfuly finished."; })
+        ->debug_with_guard([&]() { return get_typename() + "::obtain_batch(std::vector<tkey> const &) : successfuly finished."; });
+
+    return values;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+std::vector<std::optional<tvalue>> b_tree<tkey, tvalue, tcomparer, torder>::dispose_batch(
+    std::vector<tkey> const &keys)
+{
+    std::lock_guard<std::shared_mutex> lock(_mutex);
+
+    this->trace_with_guard([&]() { return get_typename() + "::dispose_batch(std::vector<tkey> const &) : called."; })
+        ->debug_with_guard([&]() { return get_typename() + "::dispose_batch(std::vector<tkey> const &) : called."; });
+
+    std::vector<size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this, &keys](size_t left, size_t right)
+    {
+        return this->_keys_comparer(keys[left], keys[right]) < 0;
+    });
+
+    std::vector<std::optional<tvalue>> values(keys.size());
+    node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node **, int>> path;
+
+    for (auto index : order)
+    {
+        this->template resume_path<node_capacity>(path, keys[index]);
+
+        if (path.top().second < 0)
+        {
+            continue;
+        }
+
+        // path outlives disposal only if entry is taken from leaf which needs no rebalancing
+        auto const *node = *path.top().first;
+        bool const keeps_path = node->subtrees[0] == nullptr &&
+            (node->virtual_size > get_min_keys_count() || (path.size() == 1 && node->virtual_size > 1));
+
+        values[index] = dispose_inner(path);
+
+        if (!keeps_path)
+        {
+            path = decltype(path)();
+        }
+    }
+
+    this->trace_with_guard([&]() { return get_typename() + "::dispose_batch(std::vector<tkey> const &) : successfuly finished."; })
+        ->debug_with_guard([&]() { return get_typename() + "::dispose_batch(std::vector<tkey> const &) : successfuly finished."; });
+
+    return values;
+}
+
+#pragma endregion BTree batched operations implementation
+
+#pragma region BTree bulk loading implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+template<
+    typename tinput_iterator>
+void b_tree<tkey, tvalue, tcomparer, torder>::bulk_load(
+    tinput_iterator begin,
+    tinput_iterator end,
+    double fill_factor)
+{
+    using iterator_category = typename std::iterator_traits<tinput_iterator>::iterator_category;
+
+    // shape is planned by entries count, so single pass ranges are buffered first
+    if constexpr (!std::is_base_of_v<std::forward_iterator_tag, iterator_category>)
+    {
+        std::vector<typename associative_container<tkey, tvalue>::key_value_pair> entries;
+        for (; begin != end; ++begin)
+        {
+            entries.emplace_back(*begin);
+        }
+
+        bulk_load(std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()), fill_factor);
+    }
+    else
+    {
+        std::lock_guard<std::shared_mutex> lock(_mutex);
+
+        this->trace_with_guard([&]() { return get_typename() + "::bulk_load(tinput_iterator, tinput_iterator, double) : called."; })
+            ->debug_with_guard([&]() { return get_typename() + "::bulk_load(tinput_iterator, tinput_iterator, double) : called."; });
+
+        if (this->_root != nullptr)
+        {
+            this->error_with_guard([&]() { return get_typename() + "::bulk_load(tinput_iterator, tinput_iterator, double) : tree is not empty."; });
+            throw std::logic_error("bulk load requires empty tree");
+        }
+
+        if (!(fill_factor > 0 && fill_factor <= 1))
+        {
+            throw std::logic_error("fill factor must be in (0, 1]");
+        }
+
+        size_t const keys_count = static_cast<size_t>(std::distance(begin, end));
+        if (keys_count == 0)
+        {
+            return;
+        }
+
+        size_t const saturation = std::numeric_limits<size_t>::max() / (4 * get_t());
+        size_t const target_node_keys_count = std::clamp<size_t>(
+            static_cast<size_t>(fill_factor * static_cast<double>(get_max_keys_count()) + 0.5),
+            get_min_keys_count(), get_max_keys_count());
+
+        bulk_load_shape shape;
+        shape.min_keys_count = { 0, get_min_keys_count() };
+        shape.max_keys_count = { 0, get_max_keys_count() };
+        shape.target_keys_count = { 0, target_node_keys_count };
+
+        while (shape.target_keys_count.back() < keys_count)
+        {
+            shape.min_keys_count.push_back(std::min(saturation,
+                get_min_keys_count() + get_t() * shape.min_keys_count.back()));
+            shape.max_keys_count.push_back(std::min(saturation,
+                get_max_keys_count() + 2 * get_t() * shape.max_keys_count.back()));
+            shape.target_keys_count.push_back(std::min(saturation,
+                target_node_keys_count + (target_node_keys_count + 1) * shape.target_keys_count.back()));
+        }
+
+        // the lowest tree holding all keys at fill factor, unless its root would be left without two full enough subtrees
+        size_t height = shape.target_keys_count.size() - 1;
+        if (height > 1 && keys_count < 2 * shape.min_keys_count[height - 1] + 1)
+        {
+            --height;
+        }
+
+        ++_version;
+        tkey const *previous_key = nullptr;
+        this->_root = bulk_load_subtree(begin, keys_count, height, true, shape, previous_key);
+
+        this->trace_with_guard([&]() { return get_typename() + "::bulk_load(tinput_iterator, tinput_iterator, double) : successfuly finished."; })
+            ->debug_with_guard([&]() { return get_typename() + "::bulk_load(tinput_iterator, tinput_iterator, double) : successfuly finished."; });
+    }
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+template<
+    typename tinput_iterator>
+typename search_tree<tkey, tvalue, tcomparer>::common_node *b_tree<tkey, tvalue, tcomparer, torder>::bulk_load_subtree(
+    tinput_iterator &iter,
+    size_t keys_count,
+    size_t height,
+    bool is_root,
+    bulk_load_shape const &shape,
+    tkey const *&previous_key)
+{
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *node = this->create_node(get_t());
+
+    auto take_entry = [this, node, &iter, &previous_key]()
+    {
+        typename associative_container<tkey, tvalue>::key_value_pair kvp(*iter);
+        ++iter;
+
+        int const order = previous_key == nullptr ? 1 : this->_keys_comparer(kvp.key, *previous_key);
+        if (order == 0)
+        {
+            this->error_with_guard([&]() { return get_typename() + "::bulk_load(tinput_iterator, tinput_iterator, double) : attempt to insert key duplicate."; });
+            throw typename search_tree<tkey, tvalue, tcomparer>::insertion_of_existent_key_attempt_exception_exception(kvp.key);
+        }
+        if (order < 0)
+        {
+            this->error_with_guard([&]() { return get_typename() + "::bulk_load(tinput_iterator, tinput_iterator, double) : keys are not sorted."; });
+            throw std::logic_error("bulk load requires keys in ascending order");
+        }
+
+        this->node_construct_entry(node, node->virtual_size, std::move(kvp));
+        previous_key = node->keys + node->virtual_size++;
+    };
+
+    try
+    {
+        if (height == 1)
+        {
+            while (node->virtual_size < keys_count)
+            {
+                take_entry();
+            }
+
+            node->subtree_size = node->virtual_size;
+
+            return node;
+        }
+
+        // subtrees count is the one filling them at fill factor, clamped to what keeps every subtree valid
+        size_t const subtrees_min_keys_count = shape.min_keys_count[height - 1];
+        size_t const subtrees_max_keys_count = shape.max_keys_count[height - 1];
+        size_t const subtrees_target_keys_count = shape.target_keys_count[height - 1];
+
+        size_t const least_subtrees_count = std::max<size_t>(is_root ? 2 : get_t(),
+            (keys_count + subtrees_max_keys_count) / (subtrees_max_keys_count + 1));
+        size_t const most_subtrees_count = std::min<size_t>(2 * get_t(),
+            (keys_count + 1) / (subtrees_min_keys_count + 1));
+        size_t const subtrees_count = std::clamp<size_t>(
+            (keys_count + subtrees_target_keys_count + 1) / (subtrees_target_keys_count + 1),
+            least_subtrees_count, std::max(least_subtrees_count, most_subtrees_count));
+
+        size_t const subtrees_keys_count = keys_count - (subtrees_count - 1);
+
+        for (size_t i = 0; i < subtrees_count; ++i)
+        {
+            node->subtrees[i] = bulk_load_subtree(iter,
+                subtrees_keys_count / subtrees_count + (i < subtrees_keys_count % subtrees_count ? 1 : 0),
+                height - 1, false, shape, previous_key);
+
+            if (i + 1 < subtrees_count)
+            {
+                take_entry();
+            }
+        }
+
+        refresh_subtree_size(node);
+    }
+    catch (...)
     {
-        this->error_with_guard(get_typename() + "::insert(tkey const &, tvalue const &) : attempt to insert key duplicate.");
+        clear(node);
         throw;
     }
-    catch (std::bad_alloc const &)
+
+    return node;
+}
+
+#pragma endregion BTree bulk loading implementation
+
+#pragma region BTree construction, assignment, destruction implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+b_tree<tkey, tvalue, tcomparer, torder>::b_tree(
+    size_t t,
+    tcomparer keys_comparer,
+    allocator *allocator,
+    logger *logger):
+        search_tree<tkey, tvalue, tcomparer>(keys_comparer, allocator, logger),
+        _t(t),
+        _version(0),
+        _snapshots_count(0)
+{
+    if (t < 2)
+    {
+        throw std::logic_error("parameter t must be not less than 2");
+    }
+
+    if (torder != 0 && t != torder)
     {
-        this->error_with_guard(get_typename() + "::insert(tkey const &, tvalue const &) : bad alloc occurred.");
-        throw;
+        throw std::logic_error("parameter t must be equal to compile-time node order");
     }
-    
-    this->trace_with_guard(get_typename() + "::insert(tkey const &, tvalue &&) : successfuly finished.")
-        ->debug_with_guard(get_typename() + "::insert(tkey const &, tvalue &&) : successfuly finished.");
 }
 
 template<
     typename tkey,
-    typename tvalue>
-void b_tree<tkey, tvalue>::update(
-    tkey const &key,
-    tvalue const &value)
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+b_tree<tkey, tvalue, tcomparer, torder>::b_tree(
+    b_tree<tkey, tvalue, tcomparer, torder> const &other):
+        search_tree<tkey, tvalue, tcomparer>(other._keys_comparer, other._allocator, other._logger),
+        _t(other._t),
+        _version(0),
+        _snapshots_count(0)
 {
-    std::lock_guard<std::mutex> lock(_mutex);
-    
-    this->trace_with_guard(get_typename() + "::insert(tkey const &, tvalue const &) : called.")
-        ->debug_with_guard(get_typename() + "::insert(tkey const &, tvalue const &) : called.")
-        ->debug_with_guard(get_typename() + "::insert(tkey const &, tvalue const &) : inserting node with key \"" + 
-            extra_utility::make_string(key) + "\"");
+    std::shared_lock<std::shared_mutex> lock(other._mutex);
     
     try
     {
-        insert_inner(std::move(typename associative_container<tkey, tvalue>::key_value_pair(key, value)), true);
-    }
-    catch (typename search_tree<tkey, tvalue>::updating_of_nonexistent_key_attempt_exception const &)
-    {
-        this->error_with_guard(get_typename() + "::insert(tkey const &, tvalue const &) : attempt to update value by non-existent key.");
-        throw;
+        this->_root = copy_tree(reinterpret_cast<typename search_tree<tkey, tvalue, tcomparer>::common_node *>(other._root));
     }
-    catch (std::bad_alloc const &)
+    catch (const std::bad_alloc& ex)
     {
-        this->error_with_guard(get_typename() + "::insert(tkey const &, tvalue const &) : bad alloc occurred.");
         throw;
     }
-    
-    this->trace_with_guard(get_typename() + "::insert(tkey const &, tvalue const &) : successfuly finished.")
-        ->debug_with_guard(get_typename() + "::insert(tkey const &, tvalue const &) : successfuly finished.");
 }
 
 template<
     typename tkey,
-    typename tvalue>
-void b_tree<tkey, tvalue>::update(
-    tkey const &key,
-    tvalue &&value)
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+b_tree<tkey, tvalue, tcomparer, torder>::b_tree(
+    b_tree<tkey, tvalue, tcomparer, torder> &&other) noexcept:
+        search_tree<tkey, tvalue, tcomparer>(other._keys_comparer, other._allocator, other._logger),
+        _t(other._t),
+        _version(0),
+        _snapshots_count(0)
 {
-    std::lock_guard<std::mutex> lock(_mutex);
+    std::lock_guard<std::shared_mutex> lock(other._mutex);
     
-    this->trace_with_guard(get_typename() + "::insert(tkey const &, tvalue &&) : called.")
-        ->debug_with_guard(get_typename() + "::insert(tkey const &, tvalue &&) : called.")
-        ->debug_with_guard(get_typename() + "::insert(tkey const &, tvalue &&) : inserting node with key \"" + 
-            extra_utility::make_string(key) + "\"");
+    ++other._version;
+    this->_root = other._root;
+    this->_nodes_slab = std::move(other._nodes_slab);
     
-    try
-    {
-        insert_inner(std::move(typename associative_container<tkey, tvalue>::key_value_pair(key, std::move(value))), true);
-    }
-    catch (typename search_tree<tkey, tvalue>::updating_of_nonexistent_key_attempt_exception const &)
-    {
-        this->error_with_guard(get_typename() + "::insert(tkey const &, tvalue const &) : attempt to update value by non-existent key.");
-        throw;
-    }
-    catch (std::bad_alloc const &)
+    other._logger = nullptr;
+    other._allocator = nullptr;
+    other._root = nullptr;
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+b_tree<tkey, tvalue, tcomparer, torder> &b_tree<tkey, tvalue, tcomparer, torder>::operator=(
+    b_tree<tkey, tvalue, tcomparer, torder> const &other)
+{
+    if (this != &other)
     {
-        this->error_with_guard(get_typename() + "::insert(tkey const &, tvalue const &) : bad alloc occurred.");
-        throw;
+        std::unique_lock<std::shared_mutex> lock_1(_mutex, std::defer_lock);
+        std::shared_lock<std::shared_mutex> lock_2(other._mutex, std::defer_lock);
+        std::lock(lock_1, lock_2);
+        
+        ++_version;
+        clear_tree();
+        
+        this->_keys_comparer = other._keys_comparer;
+        this->_native_keys_order = other._native_keys_order;
+        this->_prefixed_keys_order = other._prefixed_keys_order;
+        this->_allocator = other._allocator;
+        this->_logger = other._logger;
+        
+        _t = other._t;
+        
+        this->_root = copy_tree(reinterpret_cast<typename search_tree<tkey, tvalue, tcomparer>::common_node *>(other._root));
     }
     
-    this->trace_with_guard(get_typename() + "::insert(tkey const &, tvalue &&) : successfuly finished.")
-        ->debug_with_guard(get_typename() + "::insert(tkey const &, tvalue &&) : successfuly finished.");
+    return *this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-tvalue &b_tree<tkey, tvalue>::obtain(
-    tkey const &key)
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+b_tree<tkey, tvalue, tcomparer, torder> &b_tree<tkey, tvalue, tcomparer, torder>::operator=(
+    b_tree<tkey, tvalue, tcomparer, torder> &&other) noexcept
 {
-    std::lock_guard<std::mutex> lock(_mutex);
-    
-    this->trace_with_guard(get_typename() + "::obtain(tkey const &) : called.")
-        ->debug_with_guard(get_typename() + "::obtain(tkey const &) : called.");
-    
-    auto path = this->find_path(key);
-    if (path.top().second < 0)
+    if (this != &other)
     {
-        this->error_with_guard(get_typename() + "::obtain(tkey const &) : key \"" +
-                extra_utility::make_string(key) + "\" is not present in container.");
-        throw typename search_tree<tkey, tvalue>::obtaining_of_nonexistent_key_attempt_exception(key);
+        std::lock(_mutex, other._mutex);
+        std::lock_guard<std::shared_mutex> lock_1(_mutex, std::adopt_lock);
+        std::lock_guard<std::shared_mutex> lock_2(other._mutex, std::adopt_lock);
+        
+        ++_version;
+        ++other._version;
+        clear_tree();
+        
+        this->_keys_comparer = std::move(other._keys_comparer);
+        this->_native_keys_order = other._native_keys_order;
+        this->_prefixed_keys_order = other._prefixed_keys_order;
+        this->_allocator = other._allocator;
+        this->_logger = other._logger;
+        this->_root = other._root;
+        this->_nodes_slab = std::move(other._nodes_slab);
+        
+        _t = other._t;
+        
+        other._allocator = nullptr;
+        other._logger = nullptr;
+        other._root = nullptr;
     }
     
-    this->trace_with_guard(get_typename() + "::obtain(tkey const &) : successfuly finished.")
-        ->debug_with_guard(get_typename() + "::obtain(tkey const &) : successfuly finished.");
-    
-    return (*path.top().first)->keys_and_values[path.top().second].value;
+    return *this;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-tvalue b_tree<tkey, tvalue>::dispose(
-    tkey const &key)
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+b_tree<tkey, tvalue, tcomparer, torder>::~b_tree() noexcept
+{
+    clear_tree();
+}
+
+#pragma endregion BTree construction, assignment, destruction implementation
+
+#pragma region iterators requesting implementation
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_iterator b_tree<tkey, tvalue, tcomparer, torder>::begin_infix() const noexcept
+{
+    return infix_iterator(reinterpret_cast<typename search_tree<tkey, tvalue, tcomparer>::common_node *>(this->_root));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_iterator b_tree<tkey, tvalue, tcomparer, torder>::end_infix() const noexcept
+{
+    return infix_iterator(nullptr);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_const_iterator b_tree<tkey, tvalue, tcomparer, torder>::cbegin_infix() const noexcept
+{
+    return infix_const_iterator(reinterpret_cast<typename search_tree<tkey, tvalue, tcomparer>::common_node *>(this->_root));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_const_iterator b_tree<tkey, tvalue, tcomparer, torder>::cend_infix() const noexcept
+{
+    return infix_const_iterator(nullptr);
+}
+
+template<
+        typename tkey,
+        typename tvalue,
+        typename tcomparer,
+        size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_reverse_iterator b_tree<tkey, tvalue, tcomparer, torder>::rbegin_infix() const noexcept
+{
+    return infix_reverse_iterator(reinterpret_cast<typename search_tree<tkey, tvalue, tcomparer>::common_node *>(this->_root));
+}
+
+template<
+        typename tkey,
+        typename tvalue,
+        typename tcomparer,
+        size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_reverse_iterator b_tree<tkey, tvalue, tcomparer, torder>::rend_infix() const noexcept
+{
+    return infix_reverse_iterator(nullptr);
+}
+
+template<
+        typename tkey,
+        typename tvalue,
+        typename tcomparer,
+        size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_const_reverse_iterator b_tree<tkey, tvalue, tcomparer, torder>::crbegin_infix() const noexcept
+{
+    return infix_const_reverse_iterator(reinterpret_cast<typename search_tree<tkey, tvalue, tcomparer>::common_node *>(this->_root));
+}
+
+template<
+        typename tkey,
+        typename tvalue,
+        typename tcomparer,
+        size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_const_reverse_iterator b_tree<tkey, tvalue, tcomparer, torder>::crend_infix() const noexcept
+{
+    return infix_const_reverse_iterator(nullptr);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_const_iterator b_tree<tkey, tvalue, tcomparer, torder>::lower_bound(
+    tkey const &key) const
+{
+    return seek_infix(key, false, false);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_const_iterator b_tree<tkey, tvalue, tcomparer, torder>::upper_bound(
+    tkey const &key) const
+{
+    return seek_infix(key, false, true);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_const_iterator b_tree<tkey, tvalue, tcomparer, torder>::find(
+    tkey const &key) const
 {
-    std::lock_guard<std::mutex> lock(_mutex);
+    return seek_infix(key, true, false);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_const_iterator b_tree<tkey, tvalue, tcomparer, torder>::clast_infix() const
+{
+    std::shared_lock<std::shared_mutex> lock(_mutex);
     
-    this->trace_with_guard(get_typename() + "::dispose(tkey const &) : called.")
-        ->debug_with_guard(get_typename() + "::dispose(tkey const &) : called.")
-        ->debug_with_guard(get_typename() + "::dispose(tkey const &) : disposing node with key \"" + 
-            extra_utility::make_string(key) + "\"");
+    node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node*, int>> path;
+    auto *node = reinterpret_cast<typename search_tree<tkey, tvalue, tcomparer>::common_node *>(this->_root);
     
-    auto path = this->find_path(key);
-    if (path.top().second < 0)
+    if (node == nullptr)
     {
-        this->error_with_guard(get_typename() + "::dispose(tkey const &) : key \"" +
-                extra_utility::make_string(key) + "\" is not present in container.");
-        throw typename search_tree<tkey, tvalue>::disposal_of_nonexistent_key_attempt_exception(key);
+        return cend_infix();
     }
     
-    // Reducing non-leaf disposal to leaf disposal
-    if ((*path.top().first)->subtrees[0] != nullptr)
+    // ancestors hold index of key preceding the subtree descended into, as forward iteration expects
+    while (node->subtrees[0] != nullptr)
     {
-        auto *non_leaf = *path.top().first;
-        auto non_leaf_index = path.top().second;
-        typename search_tree<tkey, tvalue>::common_node **iterator = non_leaf->subtrees + non_leaf_index;
-        path.top().second = -non_leaf_index - 1;
-        
-        // TODO: configure this for min of right subtree (what for???)
-        while (*iterator != nullptr)
-        {
-            auto index = (*iterator)->virtual_size;
-            path.emplace(iterator, -index - 1);
-            iterator = (*iterator)->subtrees + index;
-        }
-        
-        auto *leaf = *path.top().first;
-        auto &leaf_index = path.top().second;
-        
-        leaf_index = leaf->virtual_size - 1;
-        std::swap(non_leaf->keys_and_values[non_leaf_index], leaf->keys_and_values[leaf_index]);
+        path.emplace(node, static_cast<int>(node->virtual_size) - 1);
+        node = node->subtrees[node->virtual_size];
     }
     
-    auto *target_node = *path.top().first;
-    auto kvp_to_dispose_index = path.top().second;
-    path.pop();
+    path.emplace(node, static_cast<int>(node->virtual_size) - 1);
+    
+    return infix_const_iterator(std::move(path));
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_const_iterator b_tree<tkey, tvalue, tcomparer, torder>::select(
+    size_t k) const
+{
+    std::shared_lock<std::shared_mutex> lock(_mutex);
     
-    tvalue value = std::move(target_node->keys_and_values[kvp_to_dispose_index].value);
+    node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node*, int>> path;
+    auto *node = reinterpret_cast<typename search_tree<tkey, tvalue, tcomparer>::common_node *>(this->_root);
     
-    for (size_t i = kvp_to_dispose_index + 1; i < target_node->virtual_size; ++i)
+    if (node == nullptr || k >= node->subtree_size)
     {
-        std::swap(target_node->keys_and_values[i - 1], target_node->keys_and_values[i]);
+        return cend_infix();
     }
     
-    --target_node->virtual_size;
-    allocator::destruct(target_node->keys_and_values + target_node->virtual_size);
-    
+    // k is skipped past preceding subtrees and keys until it falls into a subtree or onto a key
     while (true)
     {
-        if (target_node->virtual_size >= get_min_keys_count())
-        {
-            this->trace_with_guard(get_typename() + "::dispose(tkey const &) : successfuly finished.")
-                ->debug_with_guard(get_typename() + "::dispose(tkey const &) : successfuly finished.");
-            return value;
-        }
-        
-        if (path.size() == 0)
-        {
-            if (target_node->virtual_size == 0)
-            {
-                this->_root = target_node->subtrees[0];
-                this->destroy_node(target_node);
-                this->debug_with_guard(get_typename() + "::dispose(tkey const &) : new root is set.");
-            }
-            
-            this->trace_with_guard(get_typename() + "::dispose(tkey const &) : successfuly finished.")
-                ->debug_with_guard(get_typename() + "::dispose(tkey const &) : successfuly finished.");
-            return value;
-        }
-        
-        // right parent
-        typename search_tree<tkey, tvalue>::common_node *parent = *path.top().first;
-        size_t parent_index = -path.top().second - 1;
-        path.pop();
-        
-        bool const left_brother_exists = parent_index != 0;
-        bool const can_take_from_left = left_brother_exists && parent->subtrees[parent_index-1]->virtual_size > get_min_keys_count();
+        size_t index = 0;
         
-        
-        bool const right_brother_exists = parent_index != parent->virtual_size;
-        bool const can_take_from_right = right_brother_exists && parent->subtrees[parent_index+1]->virtual_size > get_min_keys_count();
-        
-        if (can_take_from_left)
+        while (true)
         {
-            auto *left_brother = parent->subtrees[parent_index - 1];
-            std::swap(parent->keys_and_values[parent_index-1], left_brother->keys_and_values[left_brother->virtual_size-1]);
-            
-            allocator::construct(target_node->keys_and_values + target_node->virtual_size,
-                    std::move(left_brother->keys_and_values[left_brother->virtual_size-1]));
-            ++target_node->virtual_size;
-            
-            target_node->subtrees[target_node->virtual_size] = target_node->subtrees[target_node->virtual_size - 1];
-            target_node->subtrees[target_node->virtual_size - 1] = left_brother->subtrees[left_brother->virtual_size];
+            size_t const preceding_count = node->subtrees[index] == nullptr
+                ? 0
+                : node->subtrees[index]->subtree_size;
             
-            for (size_t i = target_node->virtual_size - 1; i > 0; --i)
+            if (k < preceding_count)
             {
-                std::swap(target_node->keys_and_values[i], target_node->keys_and_values[i-1]);
-                std::swap(target_node->subtrees[i], target_node->subtrees[i-1]);
+                break;
             }
             
-            --left_brother->virtual_size;
-            allocator::destruct(left_brother->keys_and_values + left_brother->virtual_size);
-            
-            this->trace_with_guard(get_typename() + "::dispose(tkey const &) : successfuly finished.")
-                ->debug_with_guard(get_typename() + "::dispose(tkey const &) : successfuly finished.");
-            return value;
-        }
-        
-        if (can_take_from_right)
-        {
-            auto *right_brother = parent->subtrees[parent_index + 1];
-            std::swap(parent->keys_and_values[parent_index], right_brother->keys_and_values[0]);
-            
-            allocator::construct(target_node->keys_and_values + target_node->virtual_size, std::move(right_brother->keys_and_values[0]));
-            ++target_node->virtual_size;
-            
-            target_node->subtrees[target_node->virtual_size] = right_brother->subtrees[0];
-            
-            for (size_t i = 0; i < right_brother->virtual_size - 1; ++i)
+            if (k == preceding_count)
             {
-                std::swap(right_brother->keys_and_values[i], right_brother->keys_and_values[i+1]);
-                right_brother->subtrees[i] = right_brother->subtrees[i+1];
+                path.emplace(node, static_cast<int>(index));
+                
+                return infix_const_iterator(std::move(path));
             }
             
-            right_brother->subtrees[right_brother->virtual_size-1] = right_brother->subtrees[right_brother->virtual_size];
-            
-            --right_brother->virtual_size;
-            allocator::destruct(right_brother->keys_and_values + right_brother->virtual_size);
-            
-            this->trace_with_guard(get_typename() + "::dispose(tkey const &) : successfuly finished.")
-                ->debug_with_guard(get_typename() + "::dispose(tkey const &) : successfuly finished.");
-            return value;
+            k -= preceding_count + 1;
+            ++index;
         }
         
-        this->node_merge(parent, parent_index - (left_brother_exists ? 1 : 0));
-        
-        target_node = parent;
+        path.emplace(node, static_cast<int>(index) - 1);
+        node = node->subtrees[index];
     }
 }
 
 template<
     typename tkey,
-    typename tvalue>
-std::vector<typename associative_container<tkey, tvalue>::key_value_pair> b_tree<tkey, tvalue>::obtain_between(
-    tkey const &lower_bound,
-    tkey const &upper_bound,
-    bool lower_bound_inclusive,
-    bool upper_bound_inclusive)
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::range_cursor b_tree<tkey, tvalue, tcomparer, torder>::open_cursor()
 {
-    std::lock_guard<std::mutex> lock(_mutex);
+    return range_cursor(this);
+}
 
-    this->trace_with_guard(get_typename() + "::obtain_between(tkey const &, tkey const &, bool, bool) : called.")
-        ->debug_with_guard(get_typename() + "::obtain_between(tkey const &, tkey const &, bool, bool) : called.");
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::snapshot b_tree<tkey, tvalue, tcomparer, torder>::take_snapshot()
+{
+    std::lock_guard<std::shared_mutex> lock(_mutex);
 
-    auto const &comparer = this->_keys_comparer;
-    std::vector<typename associative_container<tkey, tvalue>::key_value_pair> range;
-    std::stack<std::pair<typename search_tree<tkey, tvalue>::common_node *, int>> path;
+    auto *root = reinterpret_cast<typename search_tree<tkey, tvalue, tcomparer>::common_node *>(this->_root);
+    if (root != nullptr)
+    {
+        ++root->references;
+        ++_snapshots_count;
+    }
 
-    auto *path_finder = reinterpret_cast<typename search_tree<tkey, tvalue>::common_node *>(this->_root);
+    return snapshot(this, root);
+}
 
-    while (path_finder != nullptr)
-    {
-        int index = this->node_find_path(path_finder, lower_bound, 0, path_finder->virtual_size - 1);
-        if (index >= 0)
-        {
-            path.emplace(path_finder, index);
-            break;
-        }
+#pragma endregion iterators requesting implementation
 
-        path.emplace(path_finder, -index - 2);
+#pragma region BTree extra functions
 
-        path_finder = path_finder->subtrees[-index - 1];
-    }
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+size_t b_tree<tkey, tvalue, tcomparer, torder>::get_min_keys_count() const noexcept
+{
+    return get_t() - 1;
+}
 
-    if (path.top().second == -1)
-    {
-        path.top().second = 0;
-    }
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+size_t b_tree<tkey, tvalue, tcomparer, torder>::get_max_keys_count() const noexcept
+{
+    return 2 * get_t() - 1;
+}
 
-    if (path.empty())
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename search_tree<tkey, tvalue, tcomparer>::common_node *b_tree<tkey, tvalue, tcomparer, torder>::copy(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node const *node)
+{
+    return copy(node, this->_nodes_slab);
+}
+
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename search_tree<tkey, tvalue, tcomparer>::common_node *b_tree<tkey, tvalue, tcomparer, torder>::copy(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node const *node,
+    node_slab &slab)
+{
+    if (node == nullptr)
     {
-        return range;
+        return nullptr;
     }
-
-    tkey &found_key = path.top().first->keys_and_values[path.top().second].key;
-    auto iter = infix_const_iterator(path);
-    auto end_iter = infix_const_iterator(nullptr);
-
-    if (comparer(found_key, lower_bound) < (lower_bound_inclusive ? 0 : 1))
+    
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *copied = this->create_node(get_t(), slab);
+    
+    try
     {
-        ++iter;
+        for (; copied->virtual_size < node->virtual_size; ++copied->virtual_size)
+        {
+            this->node_construct_entry(copied, copied->virtual_size, typename associative_container<tkey, tvalue>::key_value_pair(
+                node->keys[copied->virtual_size], node->values[copied->virtual_size]));
+        }
+        copied->subtree_size = node->subtree_size;
+        
+        for (size_t i = 0; i <= node->virtual_size; ++i)
+        {
+            copied->subtrees[i] = copy(node->subtrees[i], slab);
+        }
     }
-
-    while(iter != end_iter &&
-            (comparer(std::get<2>(*iter), upper_bound)) < (upper_bound_inclusive ? 1 : 0))
+    catch (...)
     {
-        range.emplace_back(std::get<2>(*iter), std::get<3>(*iter));
-        ++iter;
+        // slots not filled yet are null
+        clear(copied, slab);
+        throw;
     }
-
-    this->trace_with_guard(get_typename() + "::obtain_between(tkey const &, tkey const &, bool, bool) : successfuly finished.")
-        ->debug_with_guard(get_typename() + "::obtain_between(tkey const &, tkey const &, bool, bool) : successfuly finished.");
-
-
-    return range;
+    
+    return copied;
 }
 
-#pragma endregion BTree CRUD imlementation
-
-#pragma region BTree construction, assignment, destruction implementation
+template<
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+void b_tree<tkey, tvalue, tcomparer, torder>::clear(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *node)
+{
+    clear(node, this->_nodes_slab);
+}
 
 template<
     typename tkey,
-    typename tvalue>
-b_tree<tkey, tvalue>::b_tree(
-    size_t t,
-    std::function<int(tkey const &, tkey const &)> keys_comparer,
-    allocator *allocator,
-    logger *logger):
-        search_tree<tkey, tvalue>(keys_comparer, allocator, logger),
-        _t(t)
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+void b_tree<tkey, tvalue, tcomparer, torder>::clear(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *node,
+    node_slab &slab)
 {
-    if (t < 2)
+    if (node == nullptr || --node->references != 0)
     {
-        throw std::logic_error("parameter t must be not less than 2");
+        return;
+    }
+    
+    for (size_t i = 0; i <= node->virtual_size; ++i)
+    {
+        clear(node->subtrees[i], slab);
     }
+
+    this->destroy_node(node, slab);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-b_tree<tkey, tvalue>::b_tree(
-    b_tree<tkey, tvalue> const &other):
-        search_tree<tkey, tvalue>(other._keys_comparer, other._allocator, other._logger),
-        _t(other._t)
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename search_tree<tkey, tvalue, tcomparer>::common_node *b_tree<tkey, tvalue, tcomparer, torder>::copy_tree(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node const *root)
 {
-    std::lock(_mutex, other._mutex);
-    std::lock_guard<std::mutex> lock_1(_mutex, std::adopt_lock);
-    std::lock_guard<std::mutex> lock_2(other._mutex, std::adopt_lock);
+    size_t const workers_count = get_workers_count();
+    size_t const depth = root == nullptr || root->subtree_size < parallel_threshold
+        ? 0
+        : get_fan_out_depth(root, workers_count);
+    
+    if (depth == 0)
+    {
+        return copy(root);
+    }
+    
+    std::vector<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node const *, typename search_tree<tkey, tvalue, tcomparer>::common_node **>> subtrees;
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *copied = copy_crown(root, depth, subtrees);
     
+    // slabs are not shared between threads, nodes built by workers join tree slab afterwards
+    std::vector<node_slab> slabs;
+    std::exception_ptr failure;
     try
     {
-        this->_root = copy(reinterpret_cast<typename search_tree<tkey, tvalue>::common_node *>(other._root));
+        slabs.reserve(workers_count);
+        for (size_t i = 0; i < workers_count; ++i)
+        {
+            slabs.emplace_back(0, this->_allocator);
+        }
+        
+        failure = run_parallel(subtrees.size(), workers_count, [this, &subtrees, &slabs](size_t worker, size_t index)
+        {
+            *subtrees[index].second = copy(subtrees[index].first, slabs[worker]);
+        });
     }
-    catch (const std::bad_alloc& ex)
+    catch (...)
     {
-        throw;
+        failure = std::current_exception();
+    }
+    
+    for (auto &slab : slabs)
+    {
+        this->_nodes_slab.splice(std::move(slab));
+    }
+    
+    if (failure != nullptr)
+    {
+        clear(copied);
+        std::rethrow_exception(failure);
     }
+    
+    return copied;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-b_tree<tkey, tvalue>::b_tree(
-    b_tree<tkey, tvalue> &&other) noexcept:
-        search_tree<tkey, tvalue>(other._keys_comparer, other._allocator, other._logger),
-        _t(other._t)
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+void b_tree<tkey, tvalue, tcomparer, torder>::clear_tree() noexcept
 {
-    std::lock(_mutex, other._mutex);
-    std::lock_guard<std::mutex> lock_1(_mutex, std::adopt_lock);
-    std::lock_guard<std::mutex> lock_2(other._mutex, std::adopt_lock);
+    auto *root = reinterpret_cast<typename search_tree<tkey, tvalue, tcomparer>::common_node *>(this->_root);
+    this->_root = nullptr;
     
-    this->_root = other._root;
+    size_t const workers_count = get_workers_count();
+    size_t const depth = root == nullptr || root->subtree_size < parallel_threshold || _snapshots_count != 0
+        ? 0
+        : get_fan_out_depth(root, workers_count);
     
-    other._logger = nullptr;
-    other._allocator = nullptr;
-    other._root = nullptr;
+    std::vector<typename search_tree<tkey, tvalue, tcomparer>::common_node *> subtrees;
+    try
+    {
+        if (depth != 0)
+        {
+            collect_subtrees(root, depth, subtrees);
+        }
+    }
+    catch (std::bad_alloc const &)
+    {
+        subtrees.clear();
+    }
+    
+    if (subtrees.empty())
+    {
+        clear(root);
+        return;
+    }
+    
+    // every node is the tree's own, so blocks are not given back one by one: the slab is dropped as a whole
+    run_parallel(subtrees.size(), workers_count, [this, &subtrees](size_t, size_t index)
+    {
+        discard(subtrees[index]);
+    });
+    discard(root, depth);
+    
+    this->_nodes_slab = node_slab(0, this->_allocator);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-b_tree<tkey, tvalue> &b_tree<tkey, tvalue>::operator=(
-    b_tree<tkey, tvalue> const &other)
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+size_t b_tree<tkey, tvalue, tcomparer, torder>::get_fan_out_depth(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node const *root,
+    size_t workers_count) const noexcept
 {
-    std::lock(_mutex, other._mutex);
-    std::lock_guard<std::mutex> lock_1(_mutex, std::adopt_lock);
-    std::lock_guard<std::mutex> lock_2(other._mutex, std::adopt_lock);
+    if (workers_count < 2)
+    {
+        return 0;
+    }
     
-    if (this != &other)
+    // levels are counted along the leftmost path, every node of a level having at least t subtrees
+    size_t depth = 0;
+    size_t level_nodes_count = 1;
+    auto const *node = root;
+    
+    while (level_nodes_count < 4 * workers_count && node->subtrees[0] != nullptr)
     {
-        this->clear(reinterpret_cast<typename search_tree<tkey, tvalue>::common_node *>(this->_root));
-        this->_root = copy(reinterpret_cast<typename search_tree<tkey, tvalue>::common_node *>(other._root));
-        
-        this->_keys_comparer = other._keys_comparer;
-        this->_allocator = other._allocator;
-        this->_logger = other._logger;
-        
-        _t = other._t;
+        level_nodes_count *= depth == 0
+            ? node->virtual_size + 1
+            : get_t();
+        node = node->subtrees[0];
+        ++depth;
     }
     
-    return *this;
+    return depth;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-b_tree<tkey, tvalue> &b_tree<tkey, tvalue>::operator=(
-    b_tree<tkey, tvalue> &&other) noexcept
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename search_tree<tkey, tvalue, tcomparer>::common_node *b_tree<tkey, tvalue, tcomparer, torder>::copy_crown(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node const *node,
+    size_t depth,
+    std::vector<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node const *, typename search_tree<tkey, tvalue, tcomparer>::common_node **>> &subtrees)
 {
-    std::lock(_mutex, other._mutex);
-    std::lock_guard<std::mutex> lock_1(_mutex, std::adopt_lock);
-    std::lock_guard<std::mutex> lock_2(other._mutex, std::adopt_lock);
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *copied = this->create_node(get_t());
     
-    if (this != &other)
+    try
     {
-        this->clear(reinterpret_cast<typename search_tree<tkey, tvalue>::common_node *>(this->_root));
-        
-        this->_keys_comparer = std::move(other._keys_comparer);
-        this->_allocator = other._allocator;
-        this->_logger = other._logger;
-        this->_root = other._root;
-        
-        _t = other._t;
+        for (; copied->virtual_size < node->virtual_size; ++copied->virtual_size)
+        {
+            this->node_construct_entry(copied, copied->virtual_size, typename associative_container<tkey, tvalue>::key_value_pair(
+                node->keys[copied->virtual_size], node->values[copied->virtual_size]));
+        }
+        copied->subtree_size = node->subtree_size;
         
-        other._allocator = nullptr;
-        other._logger = nullptr;
-        other._root = nullptr;
+        for (size_t i = 0; i <= node->virtual_size; ++i)
+        {
+            if (depth == 1)
+            {
+                subtrees.emplace_back(node->subtrees[i], copied->subtrees + i);
+            }
+            else
+            {
+                copied->subtrees[i] = copy_crown(node->subtrees[i], depth - 1, subtrees);
+            }
+        }
+    }
+    catch (...)
+    {
+        // slots not filled yet are null
+        clear(copied);
+        throw;
     }
     
-    return *this;
+    return copied;
 }
 
-#pragma endregion BTree construction, assignment, destruction implementation
-
-#pragma region iterators requesting implementation
-
 template<
     typename tkey,
-    typename tvalue>
-typename b_tree<tkey, tvalue>::infix_iterator b_tree<tkey, tvalue>::begin_infix() const noexcept
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+void b_tree<tkey, tvalue, tcomparer, torder>::collect_subtrees(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *node,
+    size_t depth,
+    std::vector<typename search_tree<tkey, tvalue, tcomparer>::common_node *> &subtrees) const
 {
-    return infix_iterator(reinterpret_cast<typename search_tree<tkey, tvalue>::common_node *>(this->_root));
+    if (depth == 0)
+    {
+        subtrees.push_back(node);
+        return;
+    }
+    
+    for (size_t i = 0; i <= node->virtual_size; ++i)
+    {
+        collect_subtrees(node->subtrees[i], depth - 1, subtrees);
+    }
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename b_tree<tkey, tvalue>::infix_iterator b_tree<tkey, tvalue>::end_infix() const noexcept
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+void b_tree<tkey, tvalue, tcomparer, torder>::discard(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *node,
+    size_t depth) noexcept
 {
-    return infix_iterator(nullptr);
+    if (node == nullptr || depth == 0)
+    {
+        return;
+    }
+    
+    for (size_t i = 0; i <= node->virtual_size; ++i)
+    {
+        discard(node->subtrees[i], depth - 1);
+    }
+    
+    for (size_t i = 0; i < node->virtual_size; ++i)
+    {
+        this->node_destruct_entry(node, i);
+    }
+    allocator::destruct(node);
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename b_tree<tkey, tvalue>::infix_const_iterator b_tree<tkey, tvalue>::cbegin_infix() const noexcept
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+template<
+    typename ttask>
+std::exception_ptr b_tree<tkey, tvalue, tcomparer, torder>::run_parallel(
+    size_t tasks_count,
+    size_t workers_count,
+    ttask task) noexcept
 {
-    return infix_const_iterator(reinterpret_cast<typename search_tree<tkey, tvalue>::common_node *>(this->_root));
+    std::atomic<size_t> next_index(0);
+    std::mutex failure_mutex;
+    std::exception_ptr failure;
+    
+    auto work = [&](size_t worker)
+    {
+        for (size_t index = next_index++; index < tasks_count; index = next_index++)
+        {
+            try
+            {
+                task(worker, index);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(failure_mutex);
+                if (failure == nullptr)
+                {
+                    failure = std::current_exception();
+                }
+                next_index = tasks_count;
+            }
+        }
+    };
+    
+    std::vector<std::thread> workers;
+    try
+    {
+        workers.reserve(workers_count);
+        for (size_t i = 1; i < std::min(workers_count, tasks_count); ++i)
+        {
+            workers.emplace_back(work, i);
+        }
+    }
+    catch (...)
+    {
+        // tasks are shared by those workers that did start, calling thread included
+    }
+    
+    work(0);
+    
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+    
+    return failure;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename b_tree<tkey, tvalue>::infix_const_iterator b_tree<tkey, tvalue>::cend_infix() const noexcept
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+size_t b_tree<tkey, tvalue, tcomparer, torder>::get_workers_count() noexcept
 {
-    return infix_const_iterator(nullptr);
+    return std::max<size_t>(1, std::thread::hardware_concurrency());
 }
 
 template<
-        typename tkey,
-        typename tvalue>
-typename b_tree<tkey, tvalue>::infix_reverse_iterator b_tree<tkey, tvalue>::rbegin_infix() const noexcept
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_const_iterator b_tree<tkey, tvalue, tcomparer, torder>::seek_infix(
+    tkey const &key,
+    bool exact_match,
+    bool skip_equal) const
 {
-    return infix_reverse_iterator(reinterpret_cast<typename search_tree<tkey, tvalue>::common_node *>(this->_root));
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+    
+    return seek_infix(reinterpret_cast<typename search_tree<tkey, tvalue, tcomparer>::common_node *>(this->_root),
+        key, exact_match, skip_equal);
 }
 
 template<
-        typename tkey,
-        typename tvalue>
-typename b_tree<tkey, tvalue>::infix_reverse_iterator b_tree<tkey, tvalue>::rend_infix() const noexcept
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename b_tree<tkey, tvalue, tcomparer, torder>::infix_const_iterator b_tree<tkey, tvalue, tcomparer, torder>::seek_infix(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *root,
+    tkey const &key,
+    bool exact_match,
+    bool skip_equal) const
 {
-    return infix_reverse_iterator(nullptr);
+    node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node*, int>> path;
+    auto *node = root;
+    
+    while (node != nullptr)
+    {
+        int const index = this->template node_find_path<node_capacity>(node, key, 0, node->virtual_size - 1);
+        
+        if (index >= 0)
+        {
+            path.emplace(node, index);
+            infix_const_iterator iter(std::move(path));
+            
+            return skip_equal
+                ? ++iter
+                : iter;
+        }
+        
+        int const position = -index - 1;
+        
+        if (node->subtrees[0] == nullptr)
+        {
+            if (exact_match)
+            {
+                return cend_infix();
+            }
+            
+            // successor of key beyond the leaf is found by stepping from its last key
+            path.emplace(node, std::min(position, static_cast<int>(node->virtual_size) - 1));
+            infix_const_iterator iter(std::move(path));
+            
+            return position == static_cast<int>(node->virtual_size)
+                ? ++iter
+                : iter;
+        }
+        
+        path.emplace(node, position - 1);
+        node = node->subtrees[position];
+    }
+    
+    return cend_infix();
 }
 
 template<
-        typename tkey,
-        typename tvalue>
-typename b_tree<tkey, tvalue>::infix_const_reverse_iterator b_tree<tkey, tvalue>::crbegin_infix() const noexcept
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+size_t b_tree<tkey, tvalue, tcomparer, torder>::rank(
+    tkey const &key) const
 {
-    return infix_const_reverse_iterator(reinterpret_cast<typename search_tree<tkey, tvalue>::common_node *>(this->_root));
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+    
+    return count_preceding(key, false);
 }
 
 template<
-        typename tkey,
-        typename tvalue>
-typename b_tree<tkey, tvalue>::infix_const_reverse_iterator b_tree<tkey, tvalue>::crend_infix() const noexcept
+    typename tkey,
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+size_t b_tree<tkey, tvalue, tcomparer, torder>::count_between(
+    tkey const &lower_bound,
+    tkey const &upper_bound,
+    bool lower_bound_inclusive,
+    bool upper_bound_inclusive) const
 {
-    return infix_const_reverse_iterator(nullptr);
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+    
+    size_t const preceding_range_count = count_preceding(lower_bound, !lower_bound_inclusive);
+    size_t const preceding_range_end_count = count_preceding(upper_bound, upper_bound_inclusive);
+    
+    return preceding_range_end_count > preceding_range_count
+        ? preceding_range_end_count - preceding_range_count
+        : 0;
 }
 
-#pragma endregion iterators requesting implementation
-
-#pragma region BTree extra functions
-
 template<
     typename tkey,
-    typename tvalue>
-size_t b_tree<tkey, tvalue>::get_min_keys_count() const noexcept
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+size_t b_tree<tkey, tvalue, tcomparer, torder>::count_preceding(
+    tkey const &key,
+    bool inclusive) const
 {
-    return _t - 1;
+    size_t count = 0;
+    auto const *node = reinterpret_cast<typename search_tree<tkey, tvalue, tcomparer>::common_node const *>(this->_root);
+    
+    while (node != nullptr)
+    {
+        int const index = this->template node_find_path<node_capacity>(node, key, 0, node->virtual_size - 1);
+        
+        // keys before position and subtrees up to it precede key, as does the key itself if found and inclusive
+        size_t const position = index >= 0
+            ? index + (inclusive ? 1 : 0)
+            : -index - 1;
+        
+        count += position;
+        
+        if (node->subtrees[0] != nullptr)
+        {
+            for (size_t i = 0; i < position; ++i)
+            {
+                count += node->subtrees[i]->subtree_size;
+            }
+            
+            if (index >= 0)
+            {
+                // subtree between found key and its predecessor precedes it too
+                return inclusive
+                    ? count
+                    : count + node->subtrees[index]->subtree_size;
+            }
+        }
+        else if (index >= 0)
+        {
+            return count;
+        }
+        
+        node = node->subtrees[position];
+    }
+    
+    return count;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-size_t b_tree<tkey, tvalue>::get_max_keys_count() const noexcept
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+void b_tree<tkey, tvalue, tcomparer, torder>::refresh_subtree_size(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *node) const noexcept
 {
-    return 2 * _t - 1;
+    size_t subtree_size = node->virtual_size;
+    
+    if (node->subtrees[0] != nullptr)
+    {
+        for (size_t i = 0; i <= node->virtual_size; ++i)
+        {
+            subtree_size += node->subtrees[i]->subtree_size;
+        }
+    }
+    
+    node->subtree_size = subtree_size;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-typename search_tree<tkey, tvalue>::common_node *b_tree<tkey, tvalue>::copy(
-    typename search_tree<tkey, tvalue>::common_node const *node)
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+typename search_tree<tkey, tvalue, tcomparer>::common_node *b_tree<tkey, tvalue, tcomparer, torder>::unshare(
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *&slot)
 {
-    if (node == nullptr)
+    auto *node = slot;
+    if (node == nullptr || node->references == 1)
     {
-        return nullptr;
+        return node;
     }
     
-    typename search_tree<tkey, tvalue>::common_node *copied = this->create_node(_t);
-    copied->virtual_size = node->virtual_size;
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *copied = this->create_node(get_t());
     
-    for (size_t i = 0; i <= node->virtual_size; ++i)
-    {
-        copied->subtrees[i] = nullptr;
-    }
-       
     try
     {
-        for (size_t i = 0; i <= node->virtual_size; ++i)
+        for (; copied->virtual_size < node->virtual_size; ++copied->virtual_size)
         {
-            copied->subtrees[i] = copy(node->subtrees[i]);
+            this->node_construct_entry(copied, copied->virtual_size, typename associative_container<tkey, tvalue>::key_value_pair(
+                node->keys[copied->virtual_size], node->values[copied->virtual_size]));
         }
     }
-    catch (std::bad_alloc const &)
+    catch (...)
     {
-        clear(copied);
+        this->destroy_node(copied);
         throw;
     }
     
-    for (size_t i = 0; i < node->virtual_size; ++i)
+    // subtrees are shared by the copy and the node left to snapshots
+    std::copy_n(node->subtrees, node->virtual_size + 1, copied->subtrees);
+    if (node->subtrees[0] != nullptr)
     {
-        allocator::construct(copied->keys_and_values + i, node->keys_and_values[i]);
+        for (size_t i = 0; i <= node->virtual_size; ++i)
+        {
+            ++node->subtrees[i]->references;
+        }
     }
+    copied->subtree_size = node->subtree_size;
+    
+    --node->references;
+    slot = copied;
+    
+    // released cursors must not resume on replaced nodes
+    ++_version;
     
     return copied;
 }
 
 template<
     typename tkey,
-    typename tvalue>
-void b_tree<tkey, tvalue>::clear(
-    typename search_tree<tkey, tvalue>::common_node *node)
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+void b_tree<tkey, tvalue, tcomparer, torder>::unshare_path(
+    node_path<std::pair<typename search_tree<tkey, tvalue, tcomparer>::common_node **, int>> &path)
 {
-    if (node == nullptr)
-    {
-        return;
-    }
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *parent = nullptr;
+    typename search_tree<tkey, tvalue, tcomparer>::common_node *parent_copy = nullptr;
     
-    for (size_t i = 0; i <= node->virtual_size; ++i)
+    for (auto &entry : path)
     {
-        clear(node->subtrees[i]);
+        if (parent != parent_copy)
+        {
+            entry.first = parent_copy->subtrees + (entry.first - parent->subtrees);
+        }
+        
+        parent = *entry.first;
+        parent_copy = unshare(*entry.first);
     }
-
-    this->destroy_node(node);
 }
 
 #pragma endregion BTree extra functions
 
 template<
     typename tkey,
-    typename tvalue>
-inline std::string b_tree<tkey, tvalue>::get_typename() const noexcept
+    typename tvalue,
+    typename tcomparer,
+    size_t torder>
+inline std::string b_tree<tkey, tvalue, tcomparer, torder>::get_typename() const noexcept
 {
     return "b_tree<tkey, tvalue>";
 }
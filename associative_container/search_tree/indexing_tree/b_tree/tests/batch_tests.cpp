@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+
+#include <b_tree.h>
+
+#include <map>
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+    using kvp = associative_container<int, int>::key_value_pair;
+
+    template<
+        size_t torder>
+    void expect_same(
+        b_tree<int, int, std::function<int(int const &, int const &)>, torder> const &tree,
+        std::map<int, int> const &expected)
+    {
+        auto iter = tree.cbegin_infix();
+        size_t k = 0;
+
+        for (auto const &[key, value] : expected)
+        {
+            ASSERT_NE(iter, tree.cend_infix());
+            ASSERT_EQ(std::get<2>(*iter), key);
+            ASSERT_EQ(std::get<3>(*iter), value);
+            ASSERT_EQ(tree.rank(key), k++);
+            ++iter;
+        }
+
+        EXPECT_EQ(iter, tree.cend_infix());
+    }
+
+    // random batches of every kind, with keys repeated in batch and keys present or absent in tree
+    template<
+        size_t torder>
+    void run_batches(
+        b_tree<int, int, std::function<int(int const &, int const &)>, torder> &tree,
+        unsigned seed)
+    {
+        std::map<int, int> expected;
+        std::mt19937 random(seed);
+
+        for (int round = 0; round < 300; ++round)
+        {
+            size_t const batch_size = random() % 200;
+            std::vector<int> keys(batch_size);
+            for (auto &key : keys)
+            {
+                key = static_cast<int>(random() % 6000);
+            }
+
+            switch (random() % 3)
+            {
+            case 0:
+            {
+                std::vector<kvp> entries;
+                std::vector<bool> expected_inserted;
+
+                for (auto key : keys)
+                {
+                    entries.emplace_back(key, round);
+                    expected_inserted.push_back(expected.emplace(key, round).second);
+                }
+
+                ASSERT_EQ(tree.insert_batch(std::move(entries)), expected_inserted);
+                break;
+            }
+            case 1:
+            {
+                std::vector<std::optional<int>> const values = tree.obtain_batch(keys);
+                ASSERT_EQ(values.size(), keys.size());
+
+                for (size_t i = 0; i < keys.size(); ++i)
+                {
+                    auto found = expected.find(keys[i]);
+                    ASSERT_EQ(values[i].has_value(), found != expected.end()) << keys[i];
+                    if (values[i])
+                    {
+                        ASSERT_EQ(*values[i], found->second);
+                    }
+                }
+                break;
+            }
+            default:
+            {
+                std::vector<std::optional<int>> const values = tree.dispose_batch(keys);
+                ASSERT_EQ(values.size(), keys.size());
+
+                for (size_t i = 0; i < keys.size(); ++i)
+                {
+                    auto found = expected.find(keys[i]);
+                    ASSERT_EQ(values[i].has_value(), found != expected.end()) << keys[i];
+                    if (values[i])
+                    {
+                        ASSERT_EQ(*values[i], found->second);
+                        expected.erase(found);
+                    }
+                }
+                break;
+            }
+            }
+        }
+
+        expect_same(tree, expected);
+    }
+
+}
+
+TEST(b_tree_batch, random_batches_match_map)
+{
+    for (size_t t : { 2, 3, 5, 16 })
+    {
+        b_tree<int, int> tree(t);
+        run_batches(tree, static_cast<unsigned>(t));
+    }
+
+    b_tree<int, int, std::function<int(int const &, int const &)>, 3> tree(3);
+    run_batches(tree, 3);
+}
+
+TEST(b_tree_batch, first_of_repeated_keys_is_taken)
+{
+    b_tree<int, int> tree(2);
+    tree.insert(5, 50);
+
+    std::vector<kvp> entries;
+    entries.emplace_back(7, 1);
+    entries.emplace_back(5, 2);
+    entries.emplace_back(7, 3);
+    entries.emplace_back(1, 4);
+
+    EXPECT_EQ(tree.insert_batch(std::move(entries)), (std::vector<bool>{ true, false, false, true }));
+    EXPECT_EQ(tree.obtain(7), 1);
+    EXPECT_EQ(tree.obtain(5), 50);
+
+    std::vector<std::optional<int>> const values = tree.dispose_batch({ 7, 9, 7, 1 });
+    EXPECT_EQ(values, (std::vector<std::optional<int>>{ 1, std::nullopt, std::nullopt, 4 }));
+    expect_same(tree, { { 5, 50 } });
+
+    EXPECT_TRUE(tree.insert_batch({}).empty());
+    EXPECT_TRUE(tree.obtain_batch({}).empty());
+    EXPECT_TRUE(tree.dispose_batch({}).empty());
+}
+
+TEST(b_tree_batch, batches_leave_snapshot_nodes_unchanged)
+{
+    std::map<int, int> expected;
+    b_tree<int, int> tree(2);
+
+    for (int i = 0; i < 3000; i += 2)
+    {
+        tree.insert(i, int(i));
+        expected.emplace(i, i);
+    }
+
+    auto snapshot = tree.take_snapshot();
+    std::map<int, int> const snapshot_expected = expected;
+
+    std::vector<kvp> entries;
+    std::vector<int> keys;
+    for (int i = 1; i < 3000; i += 2)
+    {
+        entries.emplace_back(i, -i);
+        expected.emplace(i, -i);
+        keys.push_back(i - 1);
+        expected.erase(i - 1);
+    }
+
+    tree.insert_batch(std::move(entries));
+    tree.dispose_batch(keys);
+    expect_same(tree, expected);
+
+    ASSERT_EQ(snapshot.size(), snapshot_expected.size());
+    auto iter = snapshot.cbegin_infix();
+    for (auto const &[key, value] : snapshot_expected)
+    {
+        ASSERT_EQ(std::get<2>(*iter), key);
+        ASSERT_EQ(std::get<3>(*iter), value);
+        ++iter;
+    }
+    EXPECT_EQ(iter, snapshot.cend_infix());
+}
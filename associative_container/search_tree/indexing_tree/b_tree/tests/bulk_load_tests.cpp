@@ -0,0 +1,289 @@
+#include <gtest/gtest.h>
+
+#include <b_tree.h>
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+
+    using tree_type = b_tree<int, int>;
+
+    // single pass view over entries, so bulk load buffers them before planning tree shape
+    class input_entries_iterator final
+    {
+
+    public:
+
+        using iterator_category = std::input_iterator_tag;
+        using value_type = tree_type::key_value_pair;
+        using difference_type = std::ptrdiff_t;
+        using pointer = value_type const *;
+        using reference = value_type const &;
+
+    private:
+
+        std::vector<value_type>::const_iterator _iter;
+
+    public:
+
+        explicit input_entries_iterator(
+            std::vector<value_type>::const_iterator iter):
+                _iter(iter)
+        {
+
+        }
+
+    public:
+
+        reference operator*() const
+        {
+            return *_iter;
+        }
+
+        input_entries_iterator &operator++()
+        {
+            ++_iter;
+            return *this;
+        }
+
+        bool operator==(
+            input_entries_iterator const &other) const
+        {
+            return _iter == other._iter;
+        }
+
+        bool operator!=(
+            input_entries_iterator const &other) const
+        {
+            return !(*this == other);
+        }
+
+    };
+
+    std::vector<tree_type::key_value_pair> ascending_entries(
+        size_t keys_count)
+    {
+        std::vector<tree_type::key_value_pair> entries;
+        for (size_t i = 0; i < keys_count; ++i)
+        {
+            entries.emplace_back(static_cast<int>(i * 3), static_cast<int>(i));
+        }
+
+        return entries;
+    }
+
+    // iteration, rank and select agree with the model; every node keeps its keys count bounds
+    void expect_same(
+        tree_type const &tree,
+        std::map<int, int> const &expected)
+    {
+        auto iter = tree.cbegin_infix();
+        size_t k = 0;
+
+        for (auto const &[key, value] : expected)
+        {
+            ASSERT_NE(iter, tree.cend_infix());
+            ASSERT_EQ(std::get<2>(*iter), key);
+            ASSERT_EQ(std::get<3>(*iter), value);
+            ASSERT_EQ(tree.rank(key), k);
+            ASSERT_EQ(std::get<2>(*tree.select(k)), key);
+
+            ++iter;
+            ++k;
+        }
+        EXPECT_EQ(iter, tree.cend_infix());
+
+        size_t const nodes_count = tree.get_live_nodes_count();
+        if (expected.empty())
+        {
+            EXPECT_EQ(nodes_count, 0u);
+            return;
+        }
+
+        EXPECT_LE(expected.size(), nodes_count * (2 * tree.get_t() - 1));
+        EXPECT_GE(expected.size(), (nodes_count - 1) * (tree.get_t() - 1) + 1);
+    }
+
+    // leaves are entered from every internal key, so a key above leaf depth is never next to another such key
+    void expect_leaves_at_same_depth(
+        tree_type const &tree)
+    {
+        size_t leaf_depth = 0;
+        for (auto iter = tree.cbegin_infix(); iter != tree.cend_infix(); ++iter)
+        {
+            leaf_depth = std::max(leaf_depth, std::get<0>(*iter));
+        }
+
+        bool is_previous_in_leaf = true;
+        for (auto iter = tree.cbegin_infix(); iter != tree.cend_infix(); ++iter)
+        {
+            bool const is_in_leaf = std::get<0>(*iter) == leaf_depth;
+            ASSERT_TRUE(is_in_leaf || is_previous_in_leaf) << std::get<2>(*iter);
+            is_previous_in_leaf = is_in_leaf;
+        }
+        EXPECT_TRUE(is_previous_in_leaf);
+    }
+
+}
+
+TEST(b_tree_bulk_load, loaded_tree_matches_map)
+{
+    for (size_t t : { 2, 3, 5, 16 })
+    {
+        for (double fill_factor : { 1.0, 0.7, 0.5, 0.01 })
+        {
+            for (size_t keys_count : { 0, 1, 2, 3, 7, 31, 100, 1000, 20000 })
+            {
+                auto const entries = ascending_entries(keys_count);
+                std::map<int, int> expected;
+                for (auto const &entry : entries)
+                {
+                    expected.emplace(entry.key, entry.value);
+                }
+
+                tree_type tree(t);
+                tree.bulk_load(entries.begin(), entries.end(), fill_factor);
+
+                expect_same(tree, expected);
+                expect_leaves_at_same_depth(tree);
+            }
+        }
+    }
+}
+
+TEST(b_tree_bulk_load, fill_factor_sets_nodes_fill)
+{
+    size_t constexpr keys_count = 50000;
+    auto const entries = ascending_entries(keys_count);
+
+    for (size_t t : { 3, 8, 32 })
+    {
+        size_t const max_keys_count = 2 * t - 1;
+
+        for (double fill_factor : { 1.0, 0.7, 0.5 })
+        {
+            tree_type tree(t);
+            tree.bulk_load(entries.begin(), entries.end(), fill_factor);
+
+            size_t const target_keys_count = std::max<size_t>(t - 1,
+                static_cast<size_t>(fill_factor * static_cast<double>(max_keys_count) + 0.5));
+            double const expected_fill = static_cast<double>(target_keys_count) / static_cast<double>(max_keys_count);
+            double const fill = static_cast<double>(keys_count) / static_cast<double>(tree.get_live_nodes_count() * max_keys_count);
+
+            EXPECT_NEAR(fill, expected_fill, 0.1) << t << ' ' << fill_factor;
+        }
+
+        // insertions grow nodes loaded full only by splitting them, ones loaded half full take them in place
+        tree_type full(t);
+        full.bulk_load(entries.begin(), entries.end(), 1.0);
+        tree_type half(t);
+        half.bulk_load(entries.begin(), entries.end(), 0.5);
+
+        size_t const full_nodes_count = full.get_live_nodes_count();
+        size_t const half_nodes_count = half.get_live_nodes_count();
+
+        for (size_t i = 0; i < keys_count; i += 7)
+        {
+            full.insert(static_cast<int>(i * 3 + 1), 0);
+            half.insert(static_cast<int>(i * 3 + 1), 0);
+        }
+
+        EXPECT_GT(full.get_live_nodes_count() - full_nodes_count, half.get_live_nodes_count() - half_nodes_count) << t;
+    }
+}
+
+TEST(b_tree_bulk_load, loaded_tree_takes_random_operations)
+{
+    for (size_t t : { 2, 3, 8 })
+    {
+        for (double fill_factor : { 1.0, 0.5 })
+        {
+            auto const entries = ascending_entries(5000);
+            std::map<int, int> expected;
+            for (auto const &entry : entries)
+            {
+                expected.emplace(entry.key, entry.value);
+            }
+
+            tree_type tree(t);
+            tree.bulk_load(entries.begin(), entries.end(), fill_factor);
+
+            std::mt19937 random(static_cast<unsigned>(t));
+            for (int i = 0; i < 20000; ++i)
+            {
+                int const key = static_cast<int>(random() % 15000);
+
+                if (random() % 2 == 0)
+                {
+                    if (expected.emplace(key, i).second)
+                    {
+                        tree.insert(key, int(i));
+                    }
+                    continue;
+                }
+
+                auto found = expected.find(key);
+                if (found != expected.end())
+                {
+                    ASSERT_EQ(tree.dispose(key), found->second);
+                    expected.erase(found);
+                }
+            }
+
+            expect_same(tree, expected);
+            expect_leaves_at_same_depth(tree);
+        }
+    }
+}
+
+TEST(b_tree_bulk_load, single_pass_and_move_ranges_are_loaded)
+{
+    auto entries = ascending_entries(3000);
+    std::map<int, int> expected;
+    for (auto const &entry : entries)
+    {
+        expected.emplace(entry.key, entry.value);
+    }
+
+    tree_type buffered(3);
+    buffered.bulk_load(input_entries_iterator(entries.cbegin()), input_entries_iterator(entries.cend()), 0.7);
+    expect_same(buffered, expected);
+
+    tree_type moved(3);
+    moved.bulk_load(std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
+    expect_same(moved, expected);
+}
+
+TEST(b_tree_bulk_load, invalid_input_is_rejected)
+{
+    auto entries = ascending_entries(1000);
+    tree_type tree(3);
+
+    EXPECT_THROW(tree.bulk_load(entries.begin(), entries.end(), 0.0), std::logic_error);
+    EXPECT_THROW(tree.bulk_load(entries.begin(), entries.end(), 1.5), std::logic_error);
+
+    // nodes built before bad key is met are given back, and tree stays empty
+    std::vector<tree_type::key_value_pair> duplicated(entries);
+    duplicated[700].key = duplicated[699].key;
+    EXPECT_THROW(tree.bulk_load(duplicated.begin(), duplicated.end()), tree_type::insertion_of_existent_key_attempt_exception_exception);
+    EXPECT_EQ(tree.get_live_nodes_count(), 0u);
+    EXPECT_EQ(tree.cbegin_infix(), tree.cend_infix());
+
+    std::vector<tree_type::key_value_pair> unsorted(entries);
+    std::swap(unsorted[500], unsorted[501]);
+    EXPECT_THROW(tree.bulk_load(unsorted.begin(), unsorted.end()), std::logic_error);
+    EXPECT_EQ(tree.get_live_nodes_count(), 0u);
+
+    tree.bulk_load(entries.begin(), entries.end());
+    EXPECT_EQ(tree.obtain(2997), 999);
+
+    // loading is only allowed into empty tree
+    EXPECT_THROW(tree.bulk_load(entries.begin(), entries.end()), std::logic_error);
+    EXPECT_EQ(tree.rank(2997), 999u);
+}
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+
+#include <b_tree.h>
+
+#include <map>
+#include <new>
+#include <random>
+
+namespace
+{
+
+    // allocator refusing allocations once given count of them is spent
+    class limited_allocator final:
+        public allocator
+    {
+
+    private:
+
+        size_t _allocations_left;
+
+    public:
+
+        explicit limited_allocator(
+            size_t allocations_count):
+                _allocations_left(allocations_count)
+        {
+
+        }
+
+    public:
+
+        [[nodiscard]] void *allocate(
+            size_t value_size,
+            size_t values_count) override
+        {
+            if (_allocations_left == 0)
+            {
+                throw std::bad_alloc();
+            }
+
+            --_allocations_left;
+            return ::operator new(value_size * values_count);
+        }
+
+        void deallocate(
+            void *at) override
+        {
+            ::operator delete(at);
+        }
+
+    public:
+
+        void set_allocations_left(
+            size_t allocations_count) noexcept
+        {
+            _allocations_left = allocations_count;
+        }
+
+    };
+
+    template<
+        size_t torder>
+    void expect_order_statistics(
+        b_tree<int, int, std::function<int(int const &, int const &)>, torder> const &tree,
+        std::map<int, int> const &expected)
+    {
+        ASSERT_EQ(tree.count_between(-1, 1 << 20, true, true), expected.size());
+
+        size_t k = 0;
+        for (auto const &[key, value] : expected)
+        {
+            ASSERT_EQ(tree.rank(key), k);
+            ASSERT_EQ(tree.rank(key + 1), k + 1) << key;
+
+            auto found = tree.select(k);
+            ASSERT_NE(found, tree.cend_infix());
+            ASSERT_EQ(std::get<2>(*found), key);
+            ASSERT_EQ(std::get<3>(*found), value);
+
+            ++k;
+        }
+
+        EXPECT_EQ(tree.select(expected.size()), tree.cend_infix());
+    }
+
+    size_t count_between(
+        std::map<int, int> const &expected,
+        int lower_bound,
+        int upper_bound,
+        bool lower_bound_inclusive,
+        bool upper_bound_inclusive)
+    {
+        size_t count = 0;
+
+        for (auto const &[key, value] : expected)
+        {
+            if ((lower_bound_inclusive ? key >= lower_bound : key > lower_bound) &&
+                (upper_bound_inclusive ? key <= upper_bound : key < upper_bound))
+            {
+                ++count;
+            }
+        }
+
+        return count;
+    }
+
+}
+
+TEST(b_tree_order_statistics, rank_select_and_count_between_match_map)
+{
+    for (size_t t : { 2, 3, 7 })
+    {
+        std::map<int, int> expected;
+        std::mt19937 random(static_cast<unsigned>(t * 31));
+        b_tree<int, int> tree(t);
+
+        for (int i = 0; i < 20000; ++i)
+        {
+            int const key = static_cast<int>(random() % 4000) * 2;
+
+            if (random() % 3 != 0)
+            {
+                if (expected.emplace(key, i).second)
+                {
+                    tree.insert(key, int(i));
+                }
+
+                continue;
+            }
+
+            auto found = expected.find(key);
+            if (found != expected.end())
+            {
+                ASSERT_EQ(tree.dispose(key), found->second);
+                expected.erase(found);
+            }
+        }
+
+        expect_order_statistics(tree, expected);
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            int const lower_bound = static_cast<int>(random() % 8100) - 50;
+            int const upper_bound = lower_bound + static_cast<int>(random() % 1000) - 100;
+            bool const lower_bound_inclusive = random() % 2 == 0;
+            bool const upper_bound_inclusive = random() % 2 == 0;
+
+            ASSERT_EQ(tree.count_between(lower_bound, upper_bound, lower_bound_inclusive, upper_bound_inclusive),
+                count_between(expected, lower_bound, upper_bound, lower_bound_inclusive, upper_bound_inclusive))
+                    << lower_bound << ' ' << upper_bound;
+        }
+    }
+}
+
+TEST(b_tree_order_statistics, compile_time_order_keeps_subtree_sizes)
+{
+    std::map<int, int> expected;
+    b_tree<int, int, std::function<int(int const &, int const &)>, 4> tree(4);
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        int const key = (i * 7919) % 5000;
+        expected.emplace(key, i);
+        tree.insert(key, int(i));
+    }
+
+    for (int key = 0; key < 5000; key += 3)
+    {
+        ASSERT_EQ(tree.dispose(key), expected[key]);
+        expected.erase(key);
+    }
+
+    expect_order_statistics(tree, expected);
+}
+
+TEST(b_tree_order_statistics, failed_insertion_leaves_subtree_sizes)
+{
+    std::map<int, int> expected;
+    limited_allocator allocator(1);
+    b_tree<int, int> tree(2, associative_container<int, int>::default_key_comparer(), &allocator);
+
+    int key = 0;
+    size_t failures_count = 0;
+
+    while (failures_count < 20)
+    {
+        try
+        {
+            tree.insert(key, int(key));
+            expected.emplace(key, key);
+            ++key;
+        }
+        catch (std::bad_alloc const &)
+        {
+            // nodes for splits are reserved before tree is changed
+            ++failures_count;
+            expect_order_statistics(tree, expected);
+            allocator.set_allocations_left(1);
+        }
+    }
+
+    EXPECT_GT(expected.size(), 200u);
+    expect_order_statistics(tree, expected);
+}
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+
+#include <b_tree.h>
+#include <flyweight.h>
+
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+    // two digit keys, so keys order is the numbers order
+    std::string key_of(
+        int number)
+    {
+        return (number < 10 ? "0" : "") + std::to_string(number);
+    }
+
+    void fill(
+        b_tree<std::string, int> &tree,
+        int from,
+        int to)
+    {
+        for (int i = from; i < to; ++i)
+        {
+            tree.insert(key_of(i), int(i));
+        }
+    }
+
+    std::shared_ptr<flyweight_string> flyweight_key_of(
+        int number)
+    {
+        return flyweight_factory::get_instance()->get_flyweight_instance(key_of(number));
+    }
+
+    struct flyweight_key_comparer final
+    {
+
+        int operator()(
+            std::shared_ptr<flyweight_string> const &first,
+            std::shared_ptr<flyweight_string> const &second) const
+        {
+            return first->get_data().compare(second->get_data());
+        }
+
+    };
+
+}
+
+TEST(b_tree_range_cursor, walks_both_ways_from_sought_position)
+{
+    for (size_t t : { 2, 3, 5, 16 })
+    {
+        std::map<int, int> expected;
+        std::mt19937 random(static_cast<unsigned>(t));
+        b_tree<int, int> tree(t);
+
+        for (int i = 0; i < 3000; ++i)
+        {
+            int const key = static_cast<int>(random() % 6000);
+            if (expected.emplace(key, i).second)
+            {
+                tree.insert(key, int(i));
+            }
+        }
+
+        auto cursor = tree.open_cursor();
+
+        auto forward = expected.begin();
+        for (bool is_valid = cursor.seek_first(); is_valid; is_valid = cursor.next(), ++forward)
+        {
+            ASSERT_NE(forward, expected.end());
+            ASSERT_EQ(cursor.key(), forward->first);
+            ASSERT_EQ(cursor.value(), forward->second);
+        }
+        EXPECT_EQ(forward, expected.end());
+
+        auto backward = expected.rbegin();
+        for (bool is_valid = cursor.seek_last(); is_valid; is_valid = cursor.prev(), ++backward)
+        {
+            ASSERT_NE(backward, expected.rend());
+            ASSERT_EQ(cursor.key(), backward->first);
+        }
+        EXPECT_EQ(backward, expected.rend());
+
+        for (int bound = -5; bound < 6010; bound += 7)
+        {
+            for (bool inclusive : { true, false })
+            {
+                auto found = inclusive
+                    ? expected.lower_bound(bound)
+                    : expected.upper_bound(bound);
+
+                ASSERT_EQ(cursor.seek(bound, inclusive), found != expected.end()) << bound;
+                if (found != expected.end())
+                {
+                    EXPECT_EQ(cursor.key(), found->first);
+                }
+            }
+        }
+    }
+}
+
+TEST(b_tree_range_cursor, fetch_stops_at_upper_bound)
+{
+    b_tree<std::string, int> tree(2);
+    fill(tree, 0, 100);
+
+    auto cursor = tree.open_cursor();
+    std::vector<associative_container<std::string, int>::key_value_pair> entries;
+
+    ASSERT_TRUE(cursor.seek(key_of(10)));
+    EXPECT_EQ(cursor.fetch(entries, 5, key_of(90), true), 5u);
+    EXPECT_EQ(cursor.key(), key_of(15));
+
+    cursor.release();
+    EXPECT_EQ(cursor.fetch(entries, 100, key_of(20), false), 5u);
+    EXPECT_EQ(cursor.key(), key_of(20));
+
+    ASSERT_EQ(entries.size(), 10u);
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        EXPECT_EQ(entries[i].key, key_of(static_cast<int>(10 + i)));
+    }
+}
+
+TEST(b_tree_range_cursor, released_cursor_steps_from_its_key_after_unrelated_write)
+{
+    b_tree<std::string, int> tree(2);
+    fill(tree, 10, 100);
+
+    auto cursor = tree.open_cursor();
+
+    ASSERT_TRUE(cursor.seek(key_of(50)));
+    cursor.release();
+    tree.insert(key_of(5), 5);
+    ASSERT_TRUE(cursor.next());
+    EXPECT_EQ(cursor.key(), key_of(51));
+
+    cursor.release();
+    tree.insert(key_of(6), 6);
+    ASSERT_TRUE(cursor.prev());
+    EXPECT_EQ(cursor.key(), key_of(50));
+
+    cursor.release();
+    tree.dispose(key_of(5));
+    EXPECT_EQ(cursor.key(), key_of(50));
+}
+
+TEST(b_tree_range_cursor, released_cursor_steps_around_its_disposed_key)
+{
+    b_tree<std::string, int> tree(2);
+    fill(tree, 10, 100);
+
+    auto cursor = tree.open_cursor();
+
+    ASSERT_TRUE(cursor.seek(key_of(50)));
+    cursor.release();
+    tree.dispose(key_of(50));
+    ASSERT_TRUE(cursor.next());
+    EXPECT_EQ(cursor.key(), key_of(51));
+
+    cursor.release();
+    tree.dispose(key_of(51));
+    ASSERT_TRUE(cursor.prev());
+    EXPECT_EQ(cursor.key(), key_of(49));
+
+    ASSERT_TRUE(cursor.seek_last());
+    cursor.release();
+    tree.dispose(key_of(99));
+    EXPECT_FALSE(cursor.next());
+
+    ASSERT_TRUE(cursor.seek_last());
+    cursor.release();
+    tree.dispose(key_of(98));
+    ASSERT_TRUE(cursor.prev());
+    EXPECT_EQ(cursor.key(), key_of(97));
+}
+
+TEST(b_tree_range_cursor, released_shared_pointer_key_is_not_moved_from)
+{
+    b_tree<std::shared_ptr<flyweight_string>, int, flyweight_key_comparer> tree(2);
+
+    for (int i = 10; i < 100; i += 2)
+    {
+        tree.insert(flyweight_key_of(i), int(i));
+    }
+
+    auto cursor = tree.open_cursor();
+
+    ASSERT_TRUE(cursor.seek(flyweight_key_of(50)));
+    cursor.release();
+    tree.insert(flyweight_key_of(1), 1);
+    ASSERT_TRUE(cursor.next());
+    EXPECT_EQ(cursor.key()->get_data(), key_of(52));
+
+    cursor.release();
+    tree.insert(flyweight_key_of(3), 3);
+    ASSERT_TRUE(cursor.prev());
+    EXPECT_EQ(cursor.key()->get_data(), key_of(50));
+}
@@ -0,0 +1,234 @@
+#include <gtest/gtest.h>
+
+#include <b_tree.h>
+
+#include <atomic>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+    using tree_type = b_tree<int, std::string>;
+
+    void expect_same(
+        tree_type::snapshot const &snapshot,
+        std::map<int, std::string> const &expected)
+    {
+        ASSERT_EQ(snapshot.size(), expected.size());
+
+        auto iter = snapshot.cbegin_infix();
+        for (auto const &[key, value] : expected)
+        {
+            ASSERT_NE(iter, snapshot.cend_infix());
+            ASSERT_EQ(std::get<2>(*iter), key);
+            ASSERT_EQ(std::get<3>(*iter), value);
+            ASSERT_EQ(snapshot.obtain(key), value);
+            ++iter;
+        }
+        EXPECT_EQ(iter, snapshot.cend_infix());
+    }
+
+    void expect_same(
+        tree_type const &tree,
+        std::map<int, std::string> const &expected)
+    {
+        auto iter = tree.cbegin_infix();
+        for (auto const &[key, value] : expected)
+        {
+            ASSERT_NE(iter, tree.cend_infix());
+            ASSERT_EQ(std::get<2>(*iter), key);
+            ASSERT_EQ(std::get<3>(*iter), value);
+            ++iter;
+        }
+        EXPECT_EQ(iter, tree.cend_infix());
+        EXPECT_EQ(tree.count_between(-1, 1 << 20, true, true), expected.size());
+    }
+
+}
+
+TEST(b_tree_snapshot, snapshots_keep_state_they_were_taken_at)
+{
+    for (size_t t : { 2, 3, 8 })
+    {
+        std::map<int, std::string> expected;
+        std::mt19937 random(static_cast<unsigned>(t));
+        tree_type tree(t);
+        std::vector<std::pair<std::map<int, std::string>, tree_type::snapshot>> snapshots;
+
+        for (int i = 0; i < 30000; ++i)
+        {
+            int const key = static_cast<int>(random() % 2000);
+
+            switch (random() % 8)
+            {
+            case 0:
+            case 1:
+            case 2:
+                if (expected.emplace(key, std::to_string(i)).second)
+                {
+                    tree.insert(key, std::to_string(i));
+                }
+                break;
+            case 3:
+            case 4:
+                if (expected.erase(key) != 0)
+                {
+                    tree.dispose(key);
+                }
+                break;
+            case 5:
+                if (expected.count(key) != 0)
+                {
+                    expected[key] += "u";
+                    tree.update(key, std::string(expected[key]));
+                }
+                break;
+            case 6:
+            {
+                std::vector<int> keys;
+                for (int j = 0; j < 10; ++j)
+                {
+                    keys.push_back(static_cast<int>(random() % 2000));
+                    expected.erase(keys.back());
+                }
+                tree.dispose_batch(keys);
+                break;
+            }
+            default:
+                if (random() % 64 == 0)
+                {
+                    snapshots.emplace_back(expected, tree.take_snapshot());
+                    if (snapshots.size() > 4)
+                    {
+                        snapshots.erase(snapshots.begin());
+                    }
+                }
+                break;
+            }
+
+            if (i % 5000 == 0)
+            {
+                for (auto const &[snapshot_expected, snapshot] : snapshots)
+                {
+                    expect_same(snapshot, snapshot_expected);
+                }
+                expect_same(tree, expected);
+            }
+        }
+
+        for (auto const &[snapshot_expected, snapshot] : snapshots)
+        {
+            expect_same(snapshot, snapshot_expected);
+
+            if (!snapshot_expected.empty())
+            {
+                int const first_key = snapshot_expected.begin()->first;
+                EXPECT_EQ(std::get<2>(*snapshot.lower_bound(first_key)), first_key);
+                EXPECT_EQ(snapshot.upper_bound(snapshot_expected.rbegin()->first), snapshot.cend_infix());
+            }
+        }
+
+        expect_same(tree, expected);
+    }
+}
+
+TEST(b_tree_snapshot, released_snapshot_gives_its_nodes_back)
+{
+    tree_type tree(3);
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        tree.insert(i, std::to_string(i));
+    }
+
+    size_t const live_nodes_count = tree.get_live_nodes_count();
+
+    {
+        auto snapshot = tree.take_snapshot();
+
+        // every node is shared, so nothing is copied until tree changes
+        EXPECT_EQ(tree.get_live_nodes_count(), live_nodes_count);
+
+        for (int i = 0; i < 5000; i += 2)
+        {
+            tree.dispose(i);
+        }
+
+        EXPECT_GT(tree.get_live_nodes_count(), live_nodes_count);
+        EXPECT_EQ(snapshot.size(), 5000u);
+        EXPECT_THROW(snapshot.obtain(5000), tree_type::obtaining_of_nonexistent_key_attempt_exception);
+
+        tree_type::snapshot moved(std::move(snapshot));
+        EXPECT_EQ(moved.size(), 5000u);
+        EXPECT_EQ(moved.obtain(2), "2");
+    }
+
+    // copy of tree has just the nodes tree holds itself
+    EXPECT_EQ(tree.get_live_nodes_count(), tree_type(tree).get_live_nodes_count());
+
+    auto empty_snapshot = tree_type(2).take_snapshot();
+    EXPECT_EQ(empty_snapshot.size(), 0u);
+}
+
+TEST(b_tree_snapshot, snapshot_is_read_while_tree_is_changed)
+{
+    tree_type tree(4);
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        tree.insert(i, std::to_string(i));
+    }
+
+    auto snapshot = tree.take_snapshot();
+    std::atomic<bool> is_writing(true);
+    std::atomic<size_t> mismatches_count(0);
+
+    std::thread reader([&]()
+    {
+        do
+        {
+            size_t count = 0;
+
+            for (auto iter = snapshot.cbegin_infix(); iter != snapshot.cend_infix(); ++iter, ++count)
+            {
+                if (std::get<3>(*iter) != std::to_string(std::get<2>(*iter)))
+                {
+                    ++mismatches_count;
+                }
+            }
+
+            if (count != 5000)
+            {
+                ++mismatches_count;
+            }
+        }
+        while (is_writing.load());
+    });
+
+    for (int i = 0; i < 5000; i += 2)
+    {
+        tree.dispose(i);
+    }
+
+    for (int i = 1; i < 5000; i += 2)
+    {
+        tree.update(i, "updated");
+    }
+
+    for (int i = 5000; i < 9000; ++i)
+    {
+        tree.insert(i, "inserted");
+    }
+
+    is_writing.store(false);
+    reader.join();
+
+    EXPECT_EQ(mismatches_count.load(), 0u);
+    snapshot.release();
+    EXPECT_EQ(snapshot.size(), 0u);
+}
@@ -135,6 +135,38 @@ db_ipc::allocator_fit_mode read_allocator_fit_mode(
 	throw std::runtime_error("Invalid allocator fit mode");
 }
 
+// optional trailing argument, collections are kept in b tree unless told otherwise
+db_ipc::search_tree_variant read_search_tree_variant(
+	std::istringstream &stream)
+{
+	std::string tree_variant;
+	
+	if (!(stream >> tree_variant))
+	{
+		stream.clear(std::ios::eofbit);
+		return db_ipc::search_tree_variant::B;
+	}
+	
+	if (tree_variant == "b")
+	{
+		return db_ipc::search_tree_variant::B;
+	}
+	else if (tree_variant == "b_plus")
+	{
+		return db_ipc::search_tree_variant::B_PLUS;
+	}
+	else if (tree_variant == "b_star")
+	{
+		return db_ipc::search_tree_variant::B_STAR;
+	}
+	else if (tree_variant == "b_link")
+	{
+		return db_ipc::search_tree_variant::B_LINK;
+	}
+	
+	throw std::runtime_error("Invalid search tree type");
+}
+
 std::string read_key(
 	std::istringstream &args)
 {
@@ -403,6 +435,7 @@ void handle_add_collection_command(
 	size_t t = read_parameter_t_for_b_trees(args);
 	db_ipc::allocator_variant alloc_variant = read_allocator(args);
 	db_ipc::allocator_fit_mode alloc_fit_mode = read_allocator_fit_mode(args);
+	db_ipc::search_tree_variant tree_variant = read_search_tree_variant(args);
 	validate_eof(args);
 	
 	msg.mtype = 10;
@@ -414,7 +447,7 @@ void handle_add_collection_command(
 	strcpy(msg.schema_name, schema_name.c_str());
 	strcpy(msg.collection_name, collection_name.c_str());
 	
-	msg.tree_variant = db_ipc::search_tree_variant::B;
+	msg.tree_variant = tree_variant;
 	msg.t_for_b_trees = t;
 	msg.alloc_variant = alloc_variant;
 	msg.alloc_fit_mode = alloc_fit_mode;
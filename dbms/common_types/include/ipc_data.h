@@ -13,6 +13,7 @@ namespace db_ipc
 		B_PLUS,
 		B_STAR,
 		B_STAR_PLUS,
+		B_LINK,
 	};
 	
 	enum class allocator_variant
@@ -1,7 +1,10 @@
 #ifndef OPERATING_SYSTEMS_COURSE_WORK_DATABASE_MANAGEMENT_SYSTEM_COMMON_TYPES_TDATA
 #define OPERATING_SYSTEMS_COURSE_WORK_DATABASE_MANAGEMENT_SYSTEM_COMMON_TYPES_TDATA
 
+#include <functional>
+#include <string_view>
 #include <allocator.h>
+#include <key_prefix_traits.h>
 #include "flyweight.h"
 
 using tkey = std::shared_ptr<flyweight_string>;
@@ -21,6 +24,25 @@ public:
 
 };
 
+template<>
+struct key_prefix_traits<tkey>
+{
+
+    static constexpr bool enabled = true;
+
+    using comparer = tkey_comparer;
+
+    // null keys get the prefix of an empty string, equal prefixes always fall back to tkey_comparer
+    static key_prefix::type make(
+        tkey const &key) noexcept
+    {
+        return key
+            ? key_prefix::from_bytes(key->get_data().data(), key->get_data().size())
+            : 0;
+    }
+
+};
+
 class tvalue final
 {
 
@@ -69,6 +91,14 @@ public:
 
 };
 
+// record fields pointing into bytes holding it, valid as long as those bytes are
+struct file_record_view final
+{
+	std::string_view login;
+	uint64_t personal_id;
+	std::string_view name;
+};
+
 class file_tdata final
 	: public tdata
 {
@@ -82,14 +112,31 @@ public:
 	file_tdata(
 		long file_pos = -1);
 	
+	// record is appended at file end through storage write call, file end is moved past it
+	void serialize(
+		std::function<void(char const *, size_t, long)> const &write,
+		long &file_end,
+		std::string const &key,
+		tvalue const &value);
+	
 	void serialize(
-		std::string const &path,
-		tkey const &key,
-		tvalue const &value,
-		bool update_flag = false);
+		std::function<void(char const *, size_t, long)> const &write,
+		long &file_end,
+		std::string_view key,
+		uint64_t personal_id,
+		std::string_view name);
+	
+	// read call returns count of bytes read, which is less than asked only at file end
+	tvalue deserialize(
+		std::function<size_t(char *, size_t, long)> const &read) const;
 	
+	// decodes record straight from mapped data file
 	tvalue deserialize(
-		std::string const &path) const;
+		std::string_view mapped) const;
+	
+	// no bytes are copied, so name is not put to flyweight factory
+	file_record_view view(
+		std::string_view mapped) const;
 
 };
 
@@ -16,14 +16,12 @@ int tkey_comparer::operator()(
         return lhs ? 1 : -1;
     }
 
-    if (lhs->get_data() < rhs->get_data()) {
-        return -1;
+    if (lhs == rhs) {
+        return 0;
     }
 
-    if (lhs->get_data() > rhs->get_data()) {
-        return 1;
-    }
-    return 0;
+    int const comparison_result = lhs->get_data().compare(rhs->get_data());
+    return (comparison_result > 0) - (comparison_result < 0);
 }
 
 int tkey_comparer::operator()(
@@ -120,79 +118,125 @@ file_tdata::file_tdata(
 { }
 
 void file_tdata::serialize(
-	std::string const &path,
-	tkey const &key,
-	tvalue const &value,
-	bool update_flag)
+	std::function<void(char const *, size_t, long)> const &write,
+	long &file_end,
+	std::string const &key,
+	tvalue const &value)
 {
-	std::ofstream data_stream(path, std::ios::app | std::ios::binary);
-	
-    if (!data_stream.is_open())
-    {
-        throw std::ios::failure("Cannot open the file");
-    }
-	
-	// TODO UPDATE WITH BIGGER DATA
-	
-	if (_file_pos == -1 || update_flag)
-	{
-		_file_pos = data_stream.tellp();
-	}
-	else
-	{
-		data_stream.seekp(_file_pos, std::ios::beg);
-	}
+	serialize(write, file_end, key, value.personal_id, value.name->get_data());
+}
 
-    std::string key_str = key->get_data();
-    std::string name_str = value.name->get_data();
-    size_t login_len = key_str.size();
-    size_t name_len = name_str.size();
+void file_tdata::serialize(
+	std::function<void(char const *, size_t, long)> const &write,
+	long &file_end,
+	std::string_view key,
+	uint64_t personal_id,
+	std::string_view name)
+{
+	size_t login_len = key.size();
+	size_t name_len = name.size();
 	
-    data_stream.write(reinterpret_cast<char const *>(&login_len), sizeof(size_t));
-    data_stream.write(key->get_data().c_str(), sizeof(char) * login_len);
-    data_stream.write(reinterpret_cast<char const *>(&value.personal_id), sizeof(int64_t));
-    data_stream.write(reinterpret_cast<char const *>(&name_len), sizeof(size_t));
-    data_stream.write(value.name->get_data().c_str(), sizeof(char) * name_len);
-	data_stream.flush();
+	// record is put together first, so it takes a single write
+	std::string record;
+	record.reserve(2 * sizeof(size_t) + sizeof(int64_t) + login_len + name_len);
+	record.append(reinterpret_cast<char const *>(&login_len), sizeof(size_t));
+	record.append(key);
+	record.append(reinterpret_cast<char const *>(&personal_id), sizeof(int64_t));
+	record.append(reinterpret_cast<char const *>(&name_len), sizeof(size_t));
+	record.append(name);
 	
-	if (data_stream.fail())
-	{
-		throw std::ios::failure("An error occured while serializing data");
-	}
+	write(record.data(), record.size(), file_end);
+	
+	_file_pos = file_end;
+	file_end += static_cast<long>(record.size());
 }
 
 tvalue file_tdata::deserialize(
-	std::string const &path) const
+	std::function<size_t(char *, size_t, long)> const &read) const
 {
-	std::ifstream data_stream(path, std::ios::binary);
-    if (!data_stream.is_open())
-    {
-        throw std::ios::failure("Cannot open the file");
-    }
-	if (_file_pos == 1)
+	if (_file_pos < 0)
 	{
 		throw std::logic_error("Invalid pointer to data");
 	}
-
-    data_stream.seekg(_file_pos, std::ios::beg);
+	
+	// most records fit in one read, parts of longer ones beyond it are read separately
+	char buffer[256];
+	size_t const buffered = read(buffer, sizeof(buffer), _file_pos);
+	
+	auto const fetch = [this, &read, &buffer, buffered](
+		char *to,
+		size_t count,
+		size_t offset)
+	{
+		if (offset + count <= buffered)
+		{
+			std::memcpy(to, buffer + offset, count);
+		}
+		else if (read(to, count, _file_pos + static_cast<long>(offset)) != count)
+		{
+			throw std::ios::failure("An error occured while deserializing data");
+		}
+	};
 	
 	tvalue value;
 	size_t login_len, name_len;
 	
-	data_stream.read(reinterpret_cast<char *>(&login_len), sizeof(size_t));
-	data_stream.seekg(login_len, std::ios::cur);
-    data_stream.read(reinterpret_cast<char *>(&value.personal_id), sizeof(size_t));
-	data_stream.read(reinterpret_cast<char *>(&name_len), sizeof(size_t));
-
-    std::string name_str(name_len, '\0');
-    data_stream.read(&name_str[0], sizeof(char) * name_len);
+	fetch(reinterpret_cast<char *>(&login_len), sizeof(size_t), 0);
+	size_t offset = sizeof(size_t) + login_len;
+	fetch(reinterpret_cast<char *>(&value.personal_id), sizeof(int64_t), offset);
+	offset += sizeof(int64_t);
+	fetch(reinterpret_cast<char *>(&name_len), sizeof(size_t), offset);
+	offset += sizeof(size_t);
+	
+	std::string name_str(name_len, '\0');
+	fetch(name_str.data(), name_len, offset);
+	
+	value.name = flyweight_factory::get_instance()->get_flyweight_instance(name_str);
+	
+	return value;
+}
 
-    value.name = flyweight_factory::get_instance()->get_flyweight_instance(name_str);
+tvalue file_tdata::deserialize(
+	std::string_view mapped) const
+{
+	file_record_view const record = view(mapped);
 	
-	if (data_stream.fail())
+	return tvalue(record.personal_id, std::string(record.name));
+}
+
+file_record_view file_tdata::view(
+	std::string_view mapped) const
+{
+	if (_file_pos < 0)
 	{
-		throw std::ios::failure("An error occured while deserializing data");
+		throw std::logic_error("Invalid pointer to data");
 	}
 	
-    return value;
+	size_t offset = static_cast<size_t>(_file_pos);
+	
+	// fields are checked against mapped bytes, so record cut by file end is not read past it
+	auto const fetch = [&mapped, &offset](
+		size_t count)
+	{
+		if (offset > mapped.size() || mapped.size() - offset < count)
+		{
+			throw std::ios::failure("An error occured while deserializing data");
+		}
+		
+		char const *field = mapped.data() + offset;
+		offset += count;
+		
+		return field;
+	};
+	
+	file_record_view record;
+	size_t login_len, name_len;
+	
+	std::memcpy(&login_len, fetch(sizeof(size_t)), sizeof(size_t));
+	record.login = std::string_view(fetch(login_len), login_len);
+	std::memcpy(&record.personal_id, fetch(sizeof(int64_t)), sizeof(int64_t));
+	std::memcpy(&name_len, fetch(sizeof(size_t)), sizeof(size_t));
+	record.name = std::string_view(fetch(name_len), name_len);
+	
+	return record;
 }
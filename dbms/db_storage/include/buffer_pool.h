@@ -0,0 +1,199 @@
+#ifndef OPERATING_SYSTEMS_COURSE_WORK_DATABASE_MANAGEMENT_SYSTEM_STORAGE_BUFFER_POOL
+#define OPERATING_SYSTEMS_COURSE_WORK_DATABASE_MANAGEMENT_SYSTEM_STORAGE_BUFFER_POOL
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <sys/types.h>
+
+// fixed size frames holding pages of files attached to storage server; pinned frames stay in place, unpinned ones are
+// evicted by CLOCK: the hand clears reference bits of recently used frames and takes the first frame without it;
+// dirty frames of retained files are not evicted either, they reach file only when it is flushed
+class buffer_pool final
+{
+
+public:
+
+	static constexpr size_t frame_size = 4096;
+
+	// fewer frames would not hold pages pinned together by a single index operation
+	static constexpr size_t min_frames_cnt = 16;
+
+	struct statistics final
+	{
+		size_t hits;
+		size_t misses;
+		size_t evictions;
+		size_t write_backs;
+	};
+
+private:
+
+	struct frame final
+	{
+		int fd;
+		uint64_t page_no;
+		size_t pins_cnt;
+		bool is_referenced;
+		bool is_retained;
+		// frame has entry in dirty frames list, which may outlive its modification
+		bool is_listed;
+		// modified bytes, none if begin is not less than end
+		size_t dirty_begin;
+		size_t dirty_end;
+	};
+
+	struct attached_file final
+	{
+		// logical size, pages past it are never read
+		off_t size;
+		bool is_retained;
+	};
+
+public:
+
+	// keeps frame pinned while alive
+	class page_guard final
+	{
+
+	private:
+
+		friend class buffer_pool;
+
+	private:
+
+		buffer_pool *_pool;
+		size_t _frame;
+
+	private:
+
+		page_guard(
+			buffer_pool *pool,
+			size_t frame) noexcept;
+
+	public:
+
+		~page_guard() noexcept;
+
+		page_guard(
+			page_guard const &other) = delete;
+
+		page_guard &operator=(
+			page_guard const &other) = delete;
+
+		page_guard(
+			page_guard &&other) noexcept;
+
+		page_guard &operator=(
+			page_guard &&other) noexcept;
+
+	public:
+
+		[[nodiscard]] unsigned char *data() const noexcept;
+
+		// file grows to cover modified bytes
+		void mark_dirty(
+			size_t begin = 0,
+			size_t end = frame_size);
+
+	};
+
+private:
+
+	std::vector<frame> _frames;
+	std::unique_ptr<unsigned char[]> _memory;
+	std::unordered_map<uint64_t, size_t> _frames_positions;
+	std::vector<size_t> _dirty_frames;
+	size_t _dirty_frames_cnt;
+	size_t _hand;
+
+	std::unordered_map<int, attached_file> _files;
+
+	statistics _statistics;
+
+public:
+
+	explicit buffer_pool(
+		size_t budget);
+
+	buffer_pool(
+		buffer_pool const &other) = delete;
+
+	buffer_pool &operator=(
+		buffer_pool const &other) = delete;
+
+	buffer_pool(
+		buffer_pool &&other) = delete;
+
+	buffer_pool &operator=(
+		buffer_pool &&other) = delete;
+
+public:
+
+	// writes dirty frames back and drops all frames, so nothing may be pinned
+	void resize(
+		size_t budget);
+
+	void attach(
+		int fd,
+		bool is_retained = false);
+
+	// drops frames of file without writing them back, file is to be flushed before
+	void detach(
+		int fd) noexcept;
+
+	[[nodiscard]] off_t size(
+		int fd) const;
+
+	page_guard pin(
+		int fd,
+		uint64_t page_no);
+
+	// returns count of bytes read, which is less than asked only at file end
+	size_t read(
+		int fd,
+		void *to,
+		size_t count,
+		off_t pos);
+
+	void write(
+		int fd,
+		void const *from,
+		size_t count,
+		off_t pos);
+
+	// writes dirty frames of file back
+	void flush(
+		int fd);
+
+	// passes modified bytes of file with their positions in it
+	void visit_dirty(
+		int fd,
+		std::function<void(off_t, unsigned char const *, size_t)> const &visitor) const;
+
+	[[nodiscard]] size_t get_frames_cnt() const noexcept;
+
+	[[nodiscard]] size_t get_dirty_frames_cnt() const noexcept;
+
+	[[nodiscard]] statistics get_statistics() const noexcept;
+
+private:
+
+	size_t find_victim();
+
+	void reset(
+		size_t index) noexcept;
+
+	void write_back(
+		size_t frame);
+
+	static uint64_t frame_key(
+		int fd,
+		uint64_t page_no) noexcept;
+
+};
+
+#endif //OPERATING_SYSTEMS_COURSE_WORK_DATABASE_MANAGEMENT_SYSTEM_STORAGE_BUFFER_POOL
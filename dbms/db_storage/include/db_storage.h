@@ -1,12 +1,23 @@
 #ifndef OPERATING_SYSTEMS_COURSE_WORK_DATABASE_MANAGEMENT_SYSTEM_STORAGE_DATABASE
 #define OPERATING_SYSTEMS_COURSE_WORK_DATABASE_MANAGEMENT_SYSTEM_STORAGE_DATABASE
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <queue>
 #include <extra_utility.h>
 #include <search_tree.h>
 #include <b_tree.h>
+#include <b_link_tree.h>
+#include <b_plus_tree.h>
+#include <b_star_tree.h>
 #include <allocator.h>
 #include <allocator_with_fit_mode.h>
 #include <tdata.h>
+#include "buffer_pool.h"
+#include "paged_index.h"
+#include "write_ahead_log.h"
 
 class db_storage final
 {
@@ -25,7 +36,8 @@ public:
 		b,
 		b_plus,
 		b_star,
-		b_star_plus
+		b_star_plus,
+		b_link
 	};
 	
 	enum class allocator_variant
@@ -183,7 +195,7 @@ private:
 	
 	private:
 	
-		search_tree<tkey, tdata *> *_data;
+		search_tree<tkey, tdata *, tkey_comparer> *_data;
 		search_tree_variant _tree_variant;
 
         std::shared_ptr<allocator> _allocator;
@@ -192,6 +204,18 @@ private:
 		
 		size_t _records_cnt;
 		size_t _disposed_cnt;
+		
+		// data file descriptor attached to storage buffer pool, opened on first access and kept until consolidation
+		// replaces the file
+		int _data_fd;
+		long _data_file_end;
+		
+		// read only mapping of data file, it reaches past file end, so appended records are seen without remapping
+		char const *_data_map;
+		size_t _data_map_size;
+		
+		// in file system mode records are found through index kept next to data file, _data stays empty
+		paged_index *_records_index;
 
 	
 	public:
@@ -255,6 +279,15 @@ private:
 			bool upper_bound_inclusive,
 			std::string const &path);
 		
+		// hands records to consumer in keys order without gathering whole range first
+		void obtain_between(
+			tkey const &lower_bound,
+			tkey const &upper_bound,
+			bool lower_bound_inclusive,
+			bool upper_bound_inclusive,
+			std::string const &path,
+			std::function<void(tkey const &, tvalue &&)> const &consumer);
+		
 		std::pair<tkey, tvalue> obtain_min(
 			std::string const &path);
 		
@@ -267,6 +300,16 @@ private:
 		
 		size_t get_records_cnt();
 	
+	public:
+	
+		// record as it is stored in collection data file
+		struct stored_record final
+		{
+			tkey key;
+			tvalue value;
+			long file_pos;
+		};
+	
 	public:
 	
 		void load(
@@ -274,9 +317,31 @@ private:
 			tvalue &&value,
 			std::string const &path,
 			long file_pos);
+		
+		// empty b tree collection is built at once from records ordered by keys, otherwise they are loaded one by one;
+		// in file system mode index is built from the last records of keys
+		void load(
+			std::vector<stored_record> &&records,
+			std::string const &path);
+		
+		// takes records count from index kept next to data file
+		void load_index(
+			std::string const &path);
+		
+		// reads all records of data file through storage buffer pool
+		std::vector<stored_record> scan(
+			std::string const &path);
 	
 		void consolidate(
 			std::string const &path);
+		
+		// appends images of index pages modified since last checkpoint
+		void log_index_pages(
+			write_ahead_log &log,
+			std::string const &path);
+		
+		// syncs data file, then writes index pages back
+		void write_back();
 	
 	private:
 	
@@ -290,8 +355,42 @@ private:
 			
 	private:
 	
+		tdata *create_data(
+			tvalue &&value,
+			long file_pos);
+		
 		void collect_garbage(
 			std::string const &path);
+		
+		int data_file(
+			std::string const &path);
+		
+		void close_data_file() noexcept;
+		
+		// mapped bytes of records written so far, mapping is replaced once data file outgrows it
+		std::string_view mapped_data(
+			std::string const &path);
+		
+		void unmap_data_file() noexcept;
+		
+		paged_index &records_index(
+			std::string const &path);
+		
+		void close_records_index() noexcept;
+		
+		void insert_to_file(
+			tkey const &key,
+			tvalue const &value,
+			std::string const &path);
+		
+		void update_in_file(
+			tkey const &key,
+			tvalue const &value,
+			std::string const &path);
+		
+		tvalue read_from_file(
+			long file_pos,
+			std::string const &path);
 	
 	private:
 	
@@ -348,6 +447,10 @@ private:
 	
 		void consolidate(
 			std::string const &path);
+		
+		void visit(
+			std::function<void(collection &, std::string const &)> const &visitor,
+			std::string const &path);
 	
 	private:
 	
@@ -408,6 +511,10 @@ private:
 	
 		void consolidate(
 			std::string const &path);
+		
+		void visit(
+			std::function<void(collection &, std::string const &)> const &visitor,
+			std::string const &path);
 	
 	private:
 	
@@ -426,6 +533,28 @@ private:
 	size_t _id;
 	mode _mode;
 	b_tree<std::string, pool> _pools;
+	
+	// collections data with at least that many records is deleted by background thread, 0 keeps deletion inline
+	size_t _reclamation_threshold;
+	std::mutex _reclamation_mutex;
+	std::condition_variable _reclamation_condition;
+	std::queue<search_tree<tkey, tdata *, tkey_comparer> *> _reclamation_queue;
+	bool _is_reclaimer_started;
+	
+	// pages of collections data files and indices, shared by all collections of storage server
+	buffer_pool _buffer_pool;
+	
+	// records are read from mapped data files instead of buffer pool
+	bool _is_data_mapped;
+	
+	// file system mode writes are logged before they are acknowledged, pages of collections indices reach files only
+	// through checkpoints, which log their images first
+	write_ahead_log *_log;
+	write_ahead_log::sync_policy _log_sync_policy;
+	std::chrono::milliseconds _log_sync_interval;
+	
+	// logged operations not reflected by files at setup, they are replayed once collections are loaded
+	std::deque<std::string> _unreplayed_log_records;
 
 public:
 
@@ -453,6 +582,25 @@ public:
 		std::string path);
 		
 	db_storage *clear();
+	
+	// large collections are handed to background reclaimer on disposal, so it returns before their data is freed
+	db_storage *set_reclamation_threshold(
+		size_t records_cnt);
+
+	// cached pages are written back and dropped, so it is called between operations
+	db_storage *set_buffer_pool_budget(
+		size_t bytes);
+	
+	[[nodiscard]] buffer_pool::statistics get_buffer_pool_statistics() const noexcept;
+	
+	db_storage *set_data_mapping(
+		bool is_data_mapped);
+	
+	db_storage *set_log_sync_policy(
+		write_ahead_log::sync_policy policy,
+		std::chrono::milliseconds sync_interval = std::chrono::milliseconds(10));
+	
+	[[nodiscard]] write_ahead_log::statistics get_log_statistics();
 
 	db_storage *add_pool(
 		std::string const &pool_name,
@@ -535,6 +683,16 @@ public:
         bool lower_bound_inclusive,
         bool upper_bound_inclusive);
 	
+	void obtain_between(
+		std::string const &pool_name,
+		std::string const &schema_name,
+		std::string const &collection_name,
+		tkey const &lower_bound,
+		tkey const &upper_bound,
+		bool lower_bound_inclusive,
+		bool upper_bound_inclusive,
+		std::function<void(tkey const &, tvalue &&)> const &consumer);
+	
 	std::pair<tkey, tvalue> obtain_min(
 		std::string const &pool_name,
 		std::string const &schema_name,
@@ -552,6 +710,9 @@ public:
 		tkey const &key);
 	
 	db_storage *consolidate();
+	
+	// writes back pages of collections indices and empties log unless replay is not over
+	db_storage *checkpoint();
 
 	size_t get_collection_records_cnt(
 		std::string const &pool_name,
@@ -580,6 +741,23 @@ private:
 		std::string pool_name,
 		std::string schema_name,
 		std::string collection_name);
+	
+	void reclaim(
+		search_tree<tkey, tdata *, tkey_comparer> *data,
+		size_t records_cnt) noexcept;
+	
+	void run_reclaimer();
+	
+	void visit_collections(
+		std::function<void(collection &, std::string const &)> const &visitor);
+	
+	void commit_to_log(
+		std::string const &record);
+	
+	// applies index pages images of complete checkpoints and keeps operations files do not reflect
+	void recover_log();
+	
+	void replay_log();
 
 private:
 
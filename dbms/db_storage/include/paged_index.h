@@ -0,0 +1,202 @@
+#ifndef OPERATING_SYSTEMS_COURSE_WORK_DATABASE_MANAGEMENT_SYSTEM_STORAGE_PAGED_INDEX
+#define OPERATING_SYSTEMS_COURSE_WORK_DATABASE_MANAGEMENT_SYSTEM_STORAGE_PAGED_INDEX
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "buffer_pool.h"
+
+// b+ tree mapping keys to positions of their records in collection data file, kept in file of fixed size pages
+// referring to each other by ids; page 0 holds root page id, so opening index reads nothing else, and pages are
+// cached by buffer pool shared with other files
+class paged_index final
+{
+
+public:
+
+	using page_id = uint32_t;
+
+	static constexpr size_t page_size = buffer_pool::frame_size;
+
+	// any four entries fit in page, so both halves of split page are non-empty
+	static constexpr size_t max_key_size = page_size / 4 - 24;
+
+public:
+
+	// walks entries in keys order, is invalidated by index modification
+	class cursor final
+	{
+
+	private:
+
+		friend class paged_index;
+
+	private:
+
+		paged_index *_index;
+		page_id _leaf;
+		size_t _slot;
+
+	private:
+
+		cursor(
+			paged_index *index,
+			page_id leaf,
+			size_t slot) noexcept;
+
+	public:
+
+		// returns false when entries are over
+		bool fetch(
+			std::string &key,
+			long &file_pos);
+
+	};
+
+	// fills empty index with entries given in ascending keys order page after page, keeping open only the last
+	// page of every level
+	class bulk_loader final
+	{
+
+	private:
+
+		paged_index &_index;
+		std::vector<page_id> _levels;
+		std::string _last_key;
+		size_t _appended_cnt;
+
+	public:
+
+		explicit bulk_loader(
+			paged_index &index);
+
+	public:
+
+		void append(
+			std::string_view key,
+			long file_pos);
+
+		void finish();
+
+	private:
+
+		void append_to_level(
+			size_t level,
+			std::string_view key,
+			uint64_t payload);
+
+	};
+
+private:
+
+	buffer_pool &_pool;
+	int _fd;
+	page_id _root;
+	page_id _pages_cnt;
+	size_t _records_cnt;
+	bool _is_meta_dirty;
+	bool _is_retained;
+
+public:
+
+	// empty index is created if file is empty or is truncated; pages of retained index stay in buffer pool until
+	// written back explicitly, otherwise every operation writes back pages it modified
+	paged_index(
+		std::string const &path,
+		buffer_pool &pool,
+		bool is_truncated = false,
+		bool is_retained = false);
+
+	~paged_index() noexcept;
+
+	paged_index(
+		paged_index const &other) = delete;
+
+	paged_index &operator=(
+		paged_index const &other) = delete;
+
+	paged_index(
+		paged_index &&other) = delete;
+
+	paged_index &operator=(
+		paged_index &&other) = delete;
+
+public:
+
+	[[nodiscard]] size_t size() const noexcept;
+
+	std::optional<long> obtain(
+		std::string_view key);
+
+	// returns false if key is already indexed
+	bool insert(
+		std::string_view key,
+		long file_pos);
+
+	// returns previous position, nothing if key is not indexed
+	std::optional<long> update(
+		std::string_view key,
+		long file_pos);
+
+	// pages are not merged as they empty, consolidation rebuilds index compactly
+	std::optional<long> dispose(
+		std::string_view key);
+
+	cursor begin();
+
+	// cursor at first key greater than given one or equal to it if inclusive
+	cursor seek(
+		std::string_view key,
+		bool is_inclusive);
+
+	bool obtain_last(
+		std::string &key,
+		long &file_pos);
+
+public:
+
+	// passes modified bytes of index file with their positions in it
+	void visit_dirty(
+		std::function<void(off_t, unsigned char const *, size_t)> const &visitor);
+
+	// writes modified pages back and syncs file, so they survive system crash
+	void write_back();
+
+private:
+
+	buffer_pool::page_guard fetch_page(
+		page_id id);
+
+	buffer_pool::page_guard create_page(
+		bool is_leaf,
+		page_id &id);
+
+	// writes back pages modified by operation unless index is retained, meta page goes last
+	void flush();
+
+	void store_meta();
+
+	page_id find_leaf(
+		std::string_view key,
+		std::vector<page_id> *path);
+
+	void insert_split(
+		page_id id,
+		size_t index,
+		std::string_view key,
+		uint64_t payload,
+		std::vector<page_id> &path);
+
+	void insert_into_parent(
+		std::vector<page_id> &path,
+		page_id left,
+		std::string_view separator,
+		page_id right);
+
+};
+
+#endif //OPERATING_SYSTEMS_COURSE_WORK_DATABASE_MANAGEMENT_SYSTEM_STORAGE_PAGED_INDEX
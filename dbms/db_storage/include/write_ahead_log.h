@@ -0,0 +1,137 @@
+#ifndef OPERATING_SYSTEMS_COURSE_WORK_DATABASE_MANAGEMENT_SYSTEM_STORAGE_WRITE_AHEAD_LOG
+#define OPERATING_SYSTEMS_COURSE_WORK_DATABASE_MANAGEMENT_SYSTEM_STORAGE_WRITE_AHEAD_LOG
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <sys/types.h>
+
+// records appended by concurrent writers are gathered in shared buffer, the first writer to commit takes the whole
+// buffer and writes it with one fdatasync, while the others wait for it; records are framed by their sizes and
+// checksums, so torn tail left by crash is dropped when log is opened
+class write_ahead_log final
+{
+
+public:
+
+	enum class sync_policy
+	{
+		every_commit,
+		// background thread syncs appended records every interval, commit does not wait for it
+		periodic,
+		// records are written on commit and left to operating system
+		never
+	};
+
+	struct statistics final
+	{
+		size_t records;
+		size_t batches;
+		size_t syncs;
+	};
+
+private:
+
+	// buffered records are written without waiting for commit once there are that many bytes of them
+	static constexpr size_t max_buffer_size = 1 << 20;
+
+private:
+
+	int _fd;
+	off_t _file_size;
+
+	// positions in stream of appended bytes, reset of log does not move them back
+	uint64_t _appended_lsn;
+	uint64_t _written_lsn;
+	uint64_t _synced_lsn;
+	uint64_t _reset_lsn;
+
+	std::string _buffer;
+	bool _is_leader_active;
+
+	sync_policy _policy;
+	std::chrono::milliseconds _sync_interval;
+	std::thread _syncer;
+	bool _is_stopped;
+
+	std::mutex _mutex;
+	std::condition_variable _written_condition;
+	std::condition_variable _syncer_condition;
+
+	statistics _statistics;
+
+public:
+
+	explicit write_ahead_log(
+		std::string const &path);
+
+	// appended records are synced, failure to do so is ignored
+	~write_ahead_log() noexcept;
+
+	write_ahead_log(
+		write_ahead_log const &other) = delete;
+
+	write_ahead_log &operator=(
+		write_ahead_log const &other) = delete;
+
+	write_ahead_log(
+		write_ahead_log &&other) = delete;
+
+	write_ahead_log &operator=(
+		write_ahead_log &&other) = delete;
+
+public:
+
+	void set_sync_policy(
+		sync_policy policy,
+		std::chrono::milliseconds sync_interval);
+
+	// returns position past the record to commit it up to
+	uint64_t append(
+		std::string_view record);
+
+	// record is durable on return only under every commit policy
+	void commit(
+		uint64_t lsn);
+
+	// all appended records are durable on return whatever the policy is
+	void sync();
+
+	// drops all records once files reflect them
+	void reset();
+
+	// records kept in log file, appended ones are not read until written
+	std::vector<std::string> read();
+
+	// bytes appended since log was reset
+	[[nodiscard]] size_t size();
+
+	[[nodiscard]] statistics get_statistics();
+
+private:
+
+	// writes buffered records as leader or waits for leader to write them up to lsn
+	void write_up_to(
+		std::unique_lock<std::mutex> &lock,
+		uint64_t lsn,
+		bool is_synced);
+
+	void run_syncer();
+
+	// returns records of bytes up to first torn one, valid size is size of their frames
+	static std::vector<std::string> parse(
+		std::string_view bytes,
+		size_t &valid_size);
+
+	static uint32_t checksum(
+		std::string_view bytes) noexcept;
+
+};
+
+#endif //OPERATING_SYSTEMS_COURSE_WORK_DATABASE_MANAGEMENT_SYSTEM_STORAGE_WRITE_AHEAD_LOG
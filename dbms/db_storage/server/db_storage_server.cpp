@@ -48,7 +48,9 @@ int main(int argc, char** argv)
 	}
 	
 	db_ipc::strg_msg_t msg;
-	db_storage *db = db_storage::get_instance();
+	// dropping large collections must not hold up the message loop
+	db_storage *db = db_storage::get_instance()
+		->set_reclamation_threshold(1 << 16);
 	bool is_setup = false;
 	
 	logger *logger = nullptr;
@@ -884,7 +886,17 @@ int main(int argc, char** argv)
     }
     
 	db->consolidate();
-    
+
+	buffer_pool::statistics const statistics = db->get_buffer_pool_statistics();
+	size_t const accesses_cnt = statistics.hits + statistics.misses;
+	logger->information(log_base + "[-----] Buffer pool hits: " + std::to_string(statistics.hits) + '/' +
+			std::to_string(accesses_cnt) + ", evictions: " + std::to_string(statistics.evictions) +
+			", write backs: " + std::to_string(statistics.write_backs));
+
+	write_ahead_log::statistics const log_statistics = db->get_log_statistics();
+	logger->information(log_base + "[-----] Log records: " + std::to_string(log_statistics.records) + ", batches: " +
+			std::to_string(log_statistics.batches) + ", syncs: " + std::to_string(log_statistics.syncs));
+
     std::cout << "Storage server shutdowned" << std::endl;
     
     //cmd_thread.detach();
@@ -0,0 +1,428 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ios>
+#include <stdexcept>
+#include <unistd.h>
+
+#include "../include/buffer_pool.h"
+
+#pragma region buffer pool page guard implementation
+
+buffer_pool::page_guard::page_guard(
+	buffer_pool *pool,
+	size_t frame) noexcept:
+		_pool(pool),
+		_frame(frame)
+{ }
+
+buffer_pool::page_guard::~page_guard() noexcept
+{
+	if (_pool != nullptr)
+	{
+		--_pool->_frames[_frame].pins_cnt;
+	}
+}
+
+buffer_pool::page_guard::page_guard(
+	page_guard &&other) noexcept:
+		_pool(other._pool),
+		_frame(other._frame)
+{
+	other._pool = nullptr;
+}
+
+buffer_pool::page_guard &buffer_pool::page_guard::operator=(
+	page_guard &&other) noexcept
+{
+	if (this != &other)
+	{
+		if (_pool != nullptr)
+		{
+			--_pool->_frames[_frame].pins_cnt;
+		}
+
+		_pool = other._pool;
+		_frame = other._frame;
+		other._pool = nullptr;
+	}
+
+	return *this;
+}
+
+unsigned char *buffer_pool::page_guard::data() const noexcept
+{
+	return _pool->_memory.get() + _frame * frame_size;
+}
+
+void buffer_pool::page_guard::mark_dirty(
+	size_t begin,
+	size_t end)
+{
+	frame &target = _pool->_frames[_frame];
+
+	if (!target.is_listed)
+	{
+		_pool->_dirty_frames.push_back(_frame);
+		target.is_listed = true;
+	}
+
+	if (target.dirty_begin >= target.dirty_end)
+	{
+		++_pool->_dirty_frames_cnt;
+		target.dirty_begin = begin;
+		target.dirty_end = end;
+	}
+	else
+	{
+		target.dirty_begin = std::min(target.dirty_begin, begin);
+		target.dirty_end = std::max(target.dirty_end, end);
+	}
+
+	off_t &file_size = _pool->_files.at(target.fd).size;
+	file_size = std::max<off_t>(file_size, static_cast<off_t>(target.page_no * frame_size + end));
+}
+
+#pragma endregion buffer pool page guard implementation
+
+#pragma region buffer pool construction implementation
+
+buffer_pool::buffer_pool(
+	size_t budget):
+		_dirty_frames_cnt(0),
+		_hand(0),
+		_statistics{}
+{
+	resize(budget);
+}
+
+void buffer_pool::resize(
+	size_t budget)
+{
+	if (std::any_of(_frames.begin(), _frames.end(), [](frame const &target) { return target.pins_cnt != 0; }))
+	{
+		throw std::logic_error("buffer pool with pinned frames cannot be resized");
+	}
+
+	size_t const frames_cnt = std::max(budget / frame_size, min_frames_cnt);
+	std::unique_ptr<unsigned char[]> memory(new unsigned char[frames_cnt * frame_size]);
+	std::vector<frame> frames(frames_cnt, frame{ -1, 0, 0, false, false, false, 0, 0 });
+
+	for (size_t i = 0; i < _frames.size(); ++i)
+	{
+		write_back(i);
+	}
+	_dirty_frames.clear();
+
+	_frames.swap(frames);
+	_memory.swap(memory);
+	_frames_positions.clear();
+	_hand = 0;
+}
+
+#pragma endregion buffer pool construction implementation
+
+#pragma region buffer pool operations implementation
+
+void buffer_pool::attach(
+	int fd,
+	bool is_retained)
+{
+	off_t const file_size = lseek(fd, 0, SEEK_END);
+	if (file_size == -1)
+	{
+		throw std::ios::failure("Cannot attach the file");
+	}
+
+	_files[fd] = attached_file{ file_size, is_retained };
+}
+
+void buffer_pool::detach(
+	int fd) noexcept
+{
+	_dirty_frames.erase(
+		std::remove_if(_dirty_frames.begin(), _dirty_frames.end(), [this, fd](size_t index) { return _frames[index].fd == fd; }),
+		_dirty_frames.end());
+
+	for (size_t i = 0; i < _frames.size(); ++i)
+	{
+		frame &target = _frames[i];
+
+		if (target.fd == fd)
+		{
+			if (target.dirty_begin < target.dirty_end)
+			{
+				--_dirty_frames_cnt;
+			}
+
+			_frames_positions.erase(frame_key(fd, target.page_no));
+			reset(i);
+		}
+	}
+
+	_files.erase(fd);
+}
+
+off_t buffer_pool::size(
+	int fd) const
+{
+	return _files.at(fd).size;
+}
+
+buffer_pool::page_guard buffer_pool::pin(
+	int fd,
+	uint64_t page_no)
+{
+	auto position = _frames_positions.find(frame_key(fd, page_no));
+	if (position != _frames_positions.end())
+	{
+		frame &found = _frames[position->second];
+		++found.pins_cnt;
+		found.is_referenced = true;
+		++_statistics.hits;
+
+		return page_guard(this, position->second);
+	}
+
+	attached_file const &file = _files.at(fd);
+	off_t const file_size = file.size;
+	size_t const victim = find_victim();
+	frame &target = _frames[victim];
+
+	if (target.fd != -1)
+	{
+		write_back(victim);
+		_frames_positions.erase(frame_key(target.fd, target.page_no));
+		target.fd = -1;
+		++_statistics.evictions;
+	}
+
+	// pages past file end are not read, bytes missing on disk are zeroes
+	auto *bytes = _memory.get() + victim * frame_size;
+	off_t const page_start = static_cast<off_t>(page_no * frame_size);
+	size_t const stored = page_start < file_size
+		? std::min<size_t>(frame_size, file_size - page_start)
+		: 0;
+	size_t done = 0;
+
+	while (done < stored)
+	{
+		ssize_t const result = pread(fd, bytes + done, stored - done, page_start + done);
+		if (result == 0)
+		{
+			break;
+		}
+
+		if (result == -1)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+
+			throw std::ios::failure("Failed to read the page");
+		}
+
+		done += result;
+	}
+	std::memset(bytes + done, 0, frame_size - done);
+
+	// stale entry of evicted page stays in dirty frames list
+	_frames_positions.emplace(frame_key(fd, page_no), victim);
+	target = frame{ fd, page_no, 1, true, file.is_retained, target.is_listed, 0, 0 };
+	++_statistics.misses;
+
+	return page_guard(this, victim);
+}
+
+size_t buffer_pool::read(
+	int fd,
+	void *to,
+	size_t count,
+	off_t pos)
+{
+	off_t const file_size = size(fd);
+	if (pos >= file_size)
+	{
+		return 0;
+	}
+
+	count = std::min<size_t>(count, file_size - pos);
+
+	for (size_t done = 0; done < count;)
+	{
+		size_t const offset = (pos + done) % frame_size;
+		size_t const chunk = std::min(frame_size - offset, count - done);
+		page_guard page = pin(fd, (pos + done) / frame_size);
+
+		std::memcpy(static_cast<unsigned char *>(to) + done, page.data() + offset, chunk);
+		done += chunk;
+	}
+
+	return count;
+}
+
+void buffer_pool::write(
+	int fd,
+	void const *from,
+	size_t count,
+	off_t pos)
+{
+	for (size_t done = 0; done < count;)
+	{
+		size_t const offset = (pos + done) % frame_size;
+		size_t const chunk = std::min(frame_size - offset, count - done);
+		page_guard page = pin(fd, (pos + done) / frame_size);
+
+		std::memcpy(page.data() + offset, static_cast<unsigned char const *>(from) + done, chunk);
+		page.mark_dirty(offset, offset + chunk);
+		done += chunk;
+	}
+}
+
+void buffer_pool::flush(
+	int fd)
+{
+	// frames written back on eviction leave stale entries, they are dropped here
+	size_t kept = 0;
+	size_t i = 0;
+
+	try
+	{
+		for (; i < _dirty_frames.size(); ++i)
+		{
+			size_t const index = _dirty_frames[i];
+			frame &target = _frames[index];
+
+			if (target.dirty_begin < target.dirty_end)
+			{
+				if (target.fd != fd)
+				{
+					_dirty_frames[kept++] = index;
+					continue;
+				}
+
+				write_back(index);
+			}
+
+			target.is_listed = false;
+		}
+	}
+	catch (...)
+	{
+		_dirty_frames.erase(_dirty_frames.begin() + kept, _dirty_frames.begin() + i);
+		throw;
+	}
+
+	_dirty_frames.resize(kept);
+}
+
+void buffer_pool::visit_dirty(
+	int fd,
+	std::function<void(off_t, unsigned char const *, size_t)> const &visitor) const
+{
+	for (size_t index : _dirty_frames)
+	{
+		frame const &target = _frames[index];
+
+		if (target.fd == fd && target.dirty_begin < target.dirty_end)
+		{
+			visitor(static_cast<off_t>(target.page_no * frame_size + target.dirty_begin),
+				_memory.get() + index * frame_size + target.dirty_begin, target.dirty_end - target.dirty_begin);
+		}
+	}
+}
+
+size_t buffer_pool::get_frames_cnt() const noexcept
+{
+	return _frames.size();
+}
+
+size_t buffer_pool::get_dirty_frames_cnt() const noexcept
+{
+	return _dirty_frames_cnt;
+}
+
+buffer_pool::statistics buffer_pool::get_statistics() const noexcept
+{
+	return _statistics;
+}
+
+#pragma endregion buffer pool operations implementation
+
+#pragma region buffer pool utility functions implementation
+
+size_t buffer_pool::find_victim()
+{
+	// second pass finds frames whose reference bits were cleared by the first one
+	for (size_t step = 0; step < 2 * _frames.size(); ++step)
+	{
+		size_t const candidate = _hand;
+		_hand = (_hand + 1) % _frames.size();
+
+		frame &target = _frames[candidate];
+		if (target.pins_cnt != 0 || (target.is_retained && target.dirty_begin < target.dirty_end))
+		{
+			continue;
+		}
+
+		if (target.fd != -1 && target.is_referenced)
+		{
+			target.is_referenced = false;
+			continue;
+		}
+
+		return candidate;
+	}
+
+	throw std::runtime_error("all buffer pool frames are pinned or retained");
+}
+
+void buffer_pool::reset(
+	size_t index) noexcept
+{
+	_frames[index] = frame{ -1, 0, 0, false, false, false, 0, 0 };
+}
+
+void buffer_pool::write_back(
+	size_t index)
+{
+	frame &target = _frames[index];
+	if (target.dirty_begin >= target.dirty_end)
+	{
+		return;
+	}
+
+	auto const *bytes = _memory.get() + index * frame_size;
+	off_t const page_start = static_cast<off_t>(target.page_no * frame_size);
+
+	for (size_t done = target.dirty_begin; done < target.dirty_end;)
+	{
+		ssize_t const result = pwrite(target.fd, bytes + done, target.dirty_end - done, page_start + done);
+		if (result == -1)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+
+			throw std::ios::failure("Failed to write the page back");
+		}
+
+		done += result;
+	}
+
+	target.dirty_begin = 0;
+	target.dirty_end = 0;
+	--_dirty_frames_cnt;
+	++_statistics.write_backs;
+}
+
+uint64_t buffer_pool::frame_key(
+	int fd,
+	uint64_t page_no) noexcept
+{
+	return (static_cast<uint64_t>(fd) << 40) | page_no;
+}
+
+#pragma endregion buffer pool utility functions implementation
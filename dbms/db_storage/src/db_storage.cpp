@@ -1,10 +1,13 @@
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
 #include <fstream>
 #include <cstring>
 #include <climits>
+#include <thread>
 #include <unistd.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 
 #include "../include/db_storage.h"
@@ -75,6 +78,265 @@ db_storage::disposal_of_nonexistent_key_attempt_exception::disposal_of_nonexiste
 
 #pragma region collection implementation
 
+namespace
+{
+	
+	// collections b trees and b* trees are instantiated for these node orders only, so node bounds are constant;
+	// requested order is rounded to the closest one
+	template<
+		size_t ...orders>
+	class b_tree_orders final
+	{
+	
+	public:
+		
+		template<
+			template<typename, typename, typename, size_t> typename ttree>
+		static search_tree<tkey, tdata *, tkey_comparer> *create(
+			size_t t)
+		{
+			size_t closest = 0;
+			((closest = closest == 0 || distance(orders, t) < distance(closest, t) ? orders : closest), ...);
+			
+			search_tree<tkey, tdata *, tkey_comparer> *tree = nullptr;
+			((orders == closest && (tree = new ttree<tkey, tdata *, tkey_comparer, orders>(orders, tkey_comparer())) != nullptr) || ...);
+			
+			return tree;
+		}
+		
+		// calls action with tree cast to ttree of the order it was built with, returns false if tree is not ttree
+		template<
+			template<typename, typename, typename, size_t> typename ttree,
+			typename taction>
+		static bool visit(
+			search_tree<tkey, tdata *, tkey_comparer> *tree,
+			taction &&action)
+		{
+			return (try_visit<ttree<tkey, tdata *, tkey_comparer, orders>>(tree, action) || ...);
+		}
+	
+	private:
+		
+		static size_t distance(
+			size_t first,
+			size_t second) noexcept
+		{
+			return first < second
+				? second - first
+				: first - second;
+		}
+		
+		template<
+			typename ttree,
+			typename taction>
+		static bool try_visit(
+			search_tree<tkey, tdata *, tkey_comparer> *tree,
+			taction &action)
+		{
+			auto *typed = dynamic_cast<ttree *>(tree);
+			if (typed == nullptr)
+			{
+				return false;
+			}
+			
+			action(typed);
+			return true;
+		}
+	
+	};
+	
+	using collection_b_tree_orders = b_tree_orders<4, 8, 16, 32, 64>;
+	
+	std::string index_path(
+		std::string const &data_path)
+	{
+		return data_path + ".index";
+	}
+	
+	std::function<size_t(char *, size_t, long)> reader_of(
+		buffer_pool &pool,
+		int fd)
+	{
+		return [&pool, fd](char *to, size_t count, long pos) { return pool.read(fd, to, count, pos); };
+	}
+	
+	std::function<void(char const *, size_t, long)> writer_of(
+		buffer_pool &pool,
+		int fd)
+	{
+		return [&pool, fd](char const *from, size_t count, long pos) { pool.write(fd, from, count, pos); };
+	}
+	
+	// log grown that much is emptied by checkpoint, so replay on startup stays short
+	size_t constexpr checkpoint_log_size = 1 << 26;
+	
+	// insertions and updates are both logged as puts, so replaying them over files reflecting them changes nothing
+	enum class log_record_kind : char
+	{
+		put,
+		disposal,
+		page_image,
+		checkpoint,
+		replacement
+	};
+	
+	void put_field(
+		std::string &record,
+		std::string_view field)
+	{
+		size_t const field_size = field.size();
+		record.append(reinterpret_cast<char const *>(&field_size), sizeof(size_t));
+		record.append(field);
+	}
+	
+	void put_number(
+		std::string &record,
+		uint64_t number)
+	{
+		record.append(reinterpret_cast<char const *>(&number), sizeof(uint64_t));
+	}
+	
+	// value is put only to put records
+	std::string make_log_record(
+		log_record_kind kind,
+		std::string const &pool_name,
+		std::string const &schema_name,
+		std::string const &collection_name,
+		tkey const &key,
+		tvalue const *value = nullptr)
+	{
+		std::string record(1, static_cast<char>(kind));
+		put_field(record, pool_name);
+		put_field(record, schema_name);
+		put_field(record, collection_name);
+		put_field(record, key->get_data());
+		
+		if (value != nullptr)
+		{
+			put_number(record, value->personal_id);
+			put_field(record, value->name->get_data());
+		}
+		
+		return record;
+	}
+	
+	// reads fields of log record in order they were put
+	class log_record_reader final
+	{
+	
+	private:
+		
+		std::string_view _rest;
+	
+	public:
+		
+		explicit log_record_reader(
+			std::string_view record):
+				_rest(record)
+		{ }
+	
+	public:
+		
+		log_record_kind kind()
+		{
+			return static_cast<log_record_kind>(*take(1));
+		}
+		
+		std::string_view field()
+		{
+			size_t field_size;
+			std::memcpy(&field_size, take(sizeof(size_t)), sizeof(size_t));
+			
+			return std::string_view(take(field_size), field_size);
+		}
+		
+		uint64_t number()
+		{
+			uint64_t number;
+			std::memcpy(&number, take(sizeof(uint64_t)), sizeof(uint64_t));
+			
+			return number;
+		}
+	
+	private:
+		
+		char const *take(
+			size_t count)
+		{
+			if (_rest.size() < count)
+			{
+				throw std::ios::failure("Invalid log record");
+			}
+			
+			char const *taken = _rest.data();
+			_rest.remove_prefix(count);
+			
+			return taken;
+		}
+	
+	};
+	
+	// renamed entries reach disk only once their directory is synced
+	void sync_directory(
+		std::string const &path)
+	{
+		int const fd = open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (fd == -1)
+		{
+			throw std::ios::failure("Failed to sync directory");
+		}
+		
+		bool const is_synced = fsync(fd) != -1;
+		close(fd);
+		
+		if (!is_synced)
+		{
+			throw std::ios::failure("Failed to sync directory");
+		}
+	}
+	
+	// files are renamed in order they are given, so readers of record find the first one replaced first
+	std::string make_replacement_record(
+		std::string const &directory_path,
+		std::vector<std::pair<std::string, std::string>> const &replacements)
+	{
+		std::string record(1, static_cast<char>(log_record_kind::replacement));
+		put_field(record, directory_path);
+		put_number(record, replacements.size());
+		
+		for (auto const &[from, to] : replacements)
+		{
+			put_field(record, from);
+			put_field(record, to);
+		}
+		
+		return record;
+	}
+	
+	// files already renamed are skipped, so replacement interrupted at any rename is finished by doing it again
+	void replace_files(
+		std::string_view record)
+	{
+		log_record_reader reader(record);
+		reader.kind();
+		std::string const directory_path(reader.field());
+		
+		for (uint64_t i = reader.number(); i > 0; --i)
+		{
+			std::string const from(reader.field());
+			std::string const to(reader.field());
+			
+			if (access(from.c_str(), F_OK) != -1 && rename(from.c_str(), to.c_str()) == -1)
+			{
+				throw std::ios::failure("Failed to replace data file");
+			}
+		}
+		
+		sync_directory(directory_path);
+	}
+	
+}
+
 db_storage::collection::collection(
 	search_tree_variant tree_variant,
 	db_storage::allocator_variant allocator_variant,
@@ -84,22 +346,32 @@ db_storage::collection::collection(
 		_allocator_variant(allocator_variant),
 		_fit_mode(fit_mode),
 		_records_cnt(0),
-		_disposed_cnt(0)
+		_disposed_cnt(0),
+		_data_fd(-1),
+		_data_file_end(0),
+		_data_map(nullptr),
+		_data_map_size(0),
+		_records_index(nullptr)
 {
 	switch (tree_variant)
 	{
-	case search_tree_variant::b:
-		//break;
+	case search_tree_variant::b_link:
+		_data = new b_link_tree<tkey, tdata *, tkey_comparer>(t_for_b_trees, tkey_comparer());
+		break;
 	case search_tree_variant::b_plus:
-		//break;
+		_data = new b_plus_tree<tkey, tdata *, tkey_comparer>(t_for_b_trees, tkey_comparer());
+		break;
 	case search_tree_variant::b_star:
+		_data = collection_b_tree_orders::create<b_star_tree>(t_for_b_trees);
+		break;
+	case search_tree_variant::b:
 		//break;
 	case search_tree_variant::b_star_plus:
 		//break;
 	default:
 		try
 		{
-			_data = new b_tree<tkey, tdata *>(t_for_b_trees, tkey_comparer());
+			_data = collection_b_tree_orders::create<b_tree>(t_for_b_trees);
 		}
 		catch (std::bad_alloc const &)
 		{
@@ -184,20 +456,18 @@ void db_storage::collection::insert(
 {
 	collect_garbage(path);
 	
+	if (get_instance()->_mode == mode::file_system)
+	{
+		insert_to_file(key, value, path);
+		return;
+	}
+	
 	tdata *data = nullptr;
 	
 	try
 	{
-		if (get_instance()->_mode == mode::file_system)
-		{
-			data = reinterpret_cast<file_tdata *>(allocate_with_guard(sizeof(file_tdata), 1));
-			allocator::construct(reinterpret_cast<file_tdata *>(data));
-		}
-		else
-		{
-			data = reinterpret_cast<ram_tdata *>(allocate_with_guard(sizeof(ram_tdata), 1));
-			allocator::construct(reinterpret_cast<ram_tdata *>(data), value);
-		}
+		data = reinterpret_cast<ram_tdata *>(allocate_with_guard(sizeof(ram_tdata), 1));
+		allocator::construct(reinterpret_cast<ram_tdata *>(data), value);
 	}
 	catch (std::bad_alloc const &)
 	{
@@ -208,20 +478,9 @@ void db_storage::collection::insert(
 	
 	try
 	{
-		if (get_instance()->_mode == mode::file_system)
-		{
-			reinterpret_cast<file_tdata *>(data)->serialize(path, key, value);
-		}
-		
 		_data->insert(key, data);
 	}
-	catch (std::ios::failure const &)
-	{
-		allocator::destruct(data);
-		deallocate_with_guard(data);
-		throw std::ios::failure("Failed to write data");
-	}
-	catch (search_tree<tkey, tdata *>::insertion_of_existent_key_attempt_exception_exception const &)
+	catch (search_tree<tkey, tdata *, tkey_comparer>::insertion_of_existent_key_attempt_exception_exception const &)
 	{
 		allocator::destruct(data);
 		deallocate_with_guard(data);
@@ -239,20 +498,18 @@ void db_storage::collection::insert(
 {
 	collect_garbage(path);
 	
+	if (get_instance()->_mode == mode::file_system)
+	{
+		insert_to_file(key, value, path);
+		return;
+	}
+	
 	tdata *data = nullptr;
 	
 	try
 	{
-		if (get_instance()->_mode == mode::file_system)
-		{
-			data = reinterpret_cast<file_tdata *>(allocate_with_guard(sizeof(file_tdata), 1));
-			allocator::construct(reinterpret_cast<file_tdata *>(data));
-		}
-		else
-		{
-			data = reinterpret_cast<ram_tdata *>(allocate_with_guard(sizeof(ram_tdata), 1));
-			allocator::construct(reinterpret_cast<ram_tdata *>(data), std::move(value));
-		}
+		data = reinterpret_cast<ram_tdata *>(allocate_with_guard(sizeof(ram_tdata), 1));
+		allocator::construct(reinterpret_cast<ram_tdata *>(data), std::move(value));
 	}
 	catch (std::bad_alloc const &)
 	{
@@ -263,20 +520,9 @@ void db_storage::collection::insert(
 	
 	try
 	{
-		if (get_instance()->_mode == mode::file_system)
-		{
-			reinterpret_cast<file_tdata *>(data)->serialize(path, key, value);
-		}
-		
 		_data->insert(key, data);
 	}
-	catch (std::ios::failure const &)
-	{
-		allocator::destruct(data);
-		deallocate_with_guard(data);
-		throw std::ios::failure("Failed to write data");
-	}
-	catch (search_tree<tkey, tdata *>::insertion_of_existent_key_attempt_exception_exception const &)
+	catch (search_tree<tkey, tdata *, tkey_comparer>::insertion_of_existent_key_attempt_exception_exception const &)
 	{
 		allocator::destruct(data);
 		deallocate_with_guard(data);
@@ -294,20 +540,18 @@ void db_storage::collection::update(
 {
 	collect_garbage(path);
 	
+	if (get_instance()->_mode == mode::file_system)
+	{
+		update_in_file(key, value, path);
+		return;
+	}
+	
 	tdata *data = nullptr;
 	
 	try
 	{
-		if (get_instance()->_mode == mode::file_system)
-		{
-			data = reinterpret_cast<file_tdata *>(allocate_with_guard(sizeof(file_tdata), 1));
-			allocator::construct(reinterpret_cast<file_tdata *>(data));
-		}
-		else
-		{
-			data = reinterpret_cast<ram_tdata *>(allocate_with_guard(sizeof(ram_tdata), 1));
-			allocator::construct(reinterpret_cast<ram_tdata *>(data), value);
-		}
+		data = reinterpret_cast<ram_tdata *>(allocate_with_guard(sizeof(ram_tdata), 1));
+		allocator::construct(reinterpret_cast<ram_tdata *>(data), value);
 	}
 	catch (std::bad_alloc const &)
 	{
@@ -318,20 +562,9 @@ void db_storage::collection::update(
 	
 	try
 	{
-		if (get_instance()->_mode == mode::file_system)
-		{
-			reinterpret_cast<file_tdata *>(data)->serialize(path, key, value);
-		}
-		
 		_data->update(key, data);
 	}
-	catch (std::ios::failure const &)
-	{
-		allocator::destruct(data);
-		deallocate_with_guard(data);
-		throw std::ios::failure("Failed to write data");
-	}
-	catch (search_tree<tkey, tdata *>::updating_of_nonexistent_key_attempt_exception const &)
+	catch (search_tree<tkey, tdata *, tkey_comparer>::updating_of_nonexistent_key_attempt_exception const &)
 	{
 		allocator::destruct(data);
 		deallocate_with_guard(data);
@@ -347,20 +580,18 @@ void db_storage::collection::update(
 {
 	collect_garbage(path);
 	
+	if (get_instance()->_mode == mode::file_system)
+	{
+		update_in_file(key, value, path);
+		return;
+	}
+	
 	tdata *data = nullptr;
 	
 	try
 	{
-		if (get_instance()->_mode == mode::file_system)
-		{
-			data = reinterpret_cast<file_tdata *>(allocate_with_guard(sizeof(file_tdata), 1));
-			allocator::construct(reinterpret_cast<file_tdata *>(data));
-		}
-		else
-		{
-			data = reinterpret_cast<ram_tdata *>(allocate_with_guard(sizeof(ram_tdata), 1));
-			allocator::construct(reinterpret_cast<ram_tdata *>(data), std::move(value));
-		}
+		data = reinterpret_cast<ram_tdata *>(allocate_with_guard(sizeof(ram_tdata), 1));
+		allocator::construct(reinterpret_cast<ram_tdata *>(data), std::move(value));
 	}
 	catch (std::bad_alloc const &)
 	{
@@ -371,20 +602,9 @@ void db_storage::collection::update(
 	
 	try
 	{
-		if (get_instance()->_mode == mode::file_system)
-		{
-			reinterpret_cast<file_tdata *>(data)->serialize(path, key, value);
-		}
-		
 		_data->update(key, data);
 	}
-	catch (std::ios::failure const &)
-	{
-		allocator::destruct(data);
-		deallocate_with_guard(data);
-		throw std::ios::failure("Failed to write data");
-	}
-	catch (search_tree<tkey, tdata *>::updating_of_nonexistent_key_attempt_exception const &)
+	catch (search_tree<tkey, tdata *, tkey_comparer>::updating_of_nonexistent_key_attempt_exception const &)
 	{
 		allocator::destruct(data);
 		deallocate_with_guard(data);
@@ -397,37 +617,48 @@ tvalue db_storage::collection::dispose(
 	tkey const &key,
 	std::string const &path)
 {
-	tdata *data = nullptr;
-	tvalue value;
-	
-	try
-	{
-		data = _data->dispose(key);
-	}
-	catch (search_tree<tkey, tdata *>::disposal_of_nonexistent_key_attempt_exception)
-	{
-		throw db_storage::disposal_of_nonexistent_key_attempt_exception();
-		// TODO
-	}
-	
 	if (get_instance()->_mode == mode::file_system)
 	{
+		std::optional<long> file_pos = records_index(path).obtain(key->get_data());
+		if (!file_pos)
+		{
+			throw db_storage::disposal_of_nonexistent_key_attempt_exception();
+		}
+		
+		tvalue value;
+		
 		try
 		{
-			value = dynamic_cast<file_tdata *>(data)->deserialize(path);
+			value = read_from_file(*file_pos, path);
 		}
 		catch (std::ios::failure const &)
 		{
-			allocator::destruct(data);
-			deallocate_with_guard(data);
 			throw std::ios::failure("Failed to parse disposed data");
 		}
+		
+		records_index(path).dispose(key->get_data());
+		
+		--_records_cnt;
+		++_disposed_cnt;
+		
+		return value;
+	}
+	
+	tdata *data = nullptr;
+	tvalue value;
+	
+	try
+	{
+		data = _data->dispose(key);
 	}
-	else
+	catch (search_tree<tkey, tdata *, tkey_comparer>::disposal_of_nonexistent_key_attempt_exception)
 	{
-		value = dynamic_cast<ram_tdata *>(data)->value;
+		throw db_storage::disposal_of_nonexistent_key_attempt_exception();
+		// TODO
 	}
 	
+	value = dynamic_cast<ram_tdata *>(data)->value;
+	
 	allocator::destruct(data);
 	deallocate_with_guard(data);
 	
@@ -443,33 +674,30 @@ tvalue db_storage::collection::obtain(
 {
 	collect_garbage(path);
 	
+	if (get_instance()->_mode == mode::file_system)
+	{
+		std::optional<long> file_pos = records_index(path).obtain(key->get_data());
+		if (!file_pos)
+		{
+			throw db_storage::obtaining_of_nonexistent_key_attempt_exception();
+		}
+		
+		return read_from_file(*file_pos, path);
+	}
+	
 	tdata *data = nullptr;
 	
 	try
 	{
 		data = _data->obtain(key);
 	}
-	catch (search_tree<tkey, tdata *>::obtaining_of_nonexistent_key_attempt_exception)
+	catch (search_tree<tkey, tdata *, tkey_comparer>::obtaining_of_nonexistent_key_attempt_exception)
 	{
 		throw db_storage::obtaining_of_nonexistent_key_attempt_exception();
 		// TODO
 	}
 	
-	if (get_instance()->_mode == mode::file_system)
-	{
-		try
-		{
-			return dynamic_cast<file_tdata *>(data)->deserialize(path);
-		}
-		catch (std::ios::failure const &)
-		{
-			throw std::ios::failure("Failed to read data");
-		}
-	}
-	else
-	{
-		return dynamic_cast<ram_tdata *>(data)->value;
-	}
+	return dynamic_cast<ram_tdata *>(data)->value;
 };
 
 std::vector<std::pair<tkey, tvalue>> db_storage::collection::obtain_between(
@@ -479,34 +707,87 @@ std::vector<std::pair<tkey, tvalue>> db_storage::collection::obtain_between(
 	bool upper_bound_inclusive,
 	std::string const &path)
 {
-	collect_garbage(path);
+	std::vector<std::pair<tkey, tvalue>> value_vec;
 	
-	std::vector<typename associative_container<tkey, tdata *>::key_value_pair> data_vec =
-			_data->obtain_between(lower_bound, upper_bound, lower_bound_inclusive, upper_bound_inclusive);
+	obtain_between(lower_bound, upper_bound, lower_bound_inclusive, upper_bound_inclusive, path,
+			[&value_vec](tkey const &key, tvalue &&value)
+			{
+				value_vec.emplace_back(key, std::move(value));
+			});
 	
-	std::vector<std::pair<tkey, tvalue>> value_vec;
-	value_vec.reserve(data_vec.size());
+	return value_vec;
+}
+
+void db_storage::collection::obtain_between(
+	tkey const &lower_bound,
+	tkey const &upper_bound,
+	bool lower_bound_inclusive,
+	bool upper_bound_inclusive,
+	std::string const &path,
+	std::function<void(tkey const &, tvalue &&)> const &consumer)
+{
+	collect_garbage(path);
 	
-	for (auto kvp : data_vec)
+	if (get_instance()->_mode == mode::file_system)
 	{
-		if (get_instance()->_mode == mode::file_system)
+		// index pages are read one at a time, consumer must not modify collection
+		auto cursor = records_index(path).seek(lower_bound->get_data(), lower_bound_inclusive);
+		std::string key;
+		long file_pos;
+		
+		while (cursor.fetch(key, file_pos))
 		{
-			try
+			int const comparison = tkey_comparer()(key, upper_bound->get_data());
+			if (comparison > 0 || (comparison == 0 && !upper_bound_inclusive))
 			{
-				value_vec.emplace_back(kvp.key, dynamic_cast<file_tdata *>(kvp.value)->deserialize(path));
-			}
-			catch (std::ios::failure const &)
-			{
-				throw std::ios::failure("Failed to read data");
+				break;
 			}
+			
+			consumer(flyweight_factory::get_instance()->get_flyweight_instance(key), read_from_file(file_pos, path));
 		}
-		else
+		
+		return;
+	}
+	
+	auto consume = [&consumer](std::vector<typename associative_container<tkey, tdata *>::key_value_pair> const &data_vec)
+	{
+		for (auto const &kvp : data_vec)
 		{
-			value_vec.emplace_back(kvp.key, dynamic_cast<ram_tdata *>(kvp.value)->value);
+			consumer(kvp.key, tvalue(dynamic_cast<ram_tdata *>(kvp.value)->value));
 		}
-	}
+	};
 	
-	return value_vec;
+	switch (_tree_variant)
+	{
+		case search_tree_variant::b_plus:
+			//break;
+		case search_tree_variant::b_link:
+		{
+			consume(_data->obtain_between(lower_bound, upper_bound, lower_bound_inclusive, upper_bound_inclusive));
+			break;
+		}
+		default:
+		{
+			// range is walked in bounded batches, tree is not locked while records are read and consumed
+			size_t constexpr batch_size = 256;
+			
+			collection_b_tree_orders::visit<b_tree>(_data, [&](auto *tree)
+			{
+				auto cursor = tree->open_cursor();
+				std::vector<typename associative_container<tkey, tdata *>::key_value_pair> data_vec;
+				data_vec.reserve(batch_size);
+				
+				cursor.seek(lower_bound, lower_bound_inclusive);
+				
+				while (cursor.fetch(data_vec, batch_size, upper_bound, upper_bound_inclusive) != 0)
+				{
+					cursor.release();
+					consume(data_vec);
+					data_vec.clear();
+				}
+			});
+		}
+	}
 }
 
 std::pair<tkey, tvalue> db_storage::collection::obtain_max(
@@ -514,44 +795,74 @@ std::pair<tkey, tvalue> db_storage::collection::obtain_max(
 {
 	collect_garbage(path);
 	
+	if (get_instance()->_mode == mode::file_system)
+	{
+		std::string key;
+		long file_pos;
+		
+		if (!records_index(path).obtain_last(key, file_pos))
+		{
+			throw db_storage::obtaining_of_nonexistent_key_attempt_exception();
+		}
+		
+		return make_pair(flyweight_factory::get_instance()->get_flyweight_instance(key), read_from_file(file_pos, path));
+	}
+	
 	tkey key;
 	tdata *data = nullptr;
 	
 	switch (_tree_variant)
 	{
-		default:
+		case search_tree_variant::b_link:
 		{
-			b_tree<tkey, tdata *> *tree = dynamic_cast<b_tree<tkey, tdata *> *>(_data);
+			b_link_tree<tkey, tdata *, tkey_comparer> *tree = dynamic_cast<b_link_tree<tkey, tdata *, tkey_comparer> *>(_data);
 			
-			auto iter = tree->rbegin_infix();
-			auto iter_end = tree->rend_infix();
+			auto iter = tree->last_infix();
 			
-			if (iter == iter_end)
+			if (iter == tree->end_infix())
 			{
 				throw db_storage::obtaining_of_nonexistent_key_attempt_exception();
 			}
 			
 			key = std::get<2>(*iter);
 			data = std::get<3>(*iter);
+			break;
 		}
-			
-	}
-	
-	if (get_instance()->_mode == mode::file_system)
-	{
-		try
+		case search_tree_variant::b_plus:
 		{
-			return make_pair(key, dynamic_cast<file_tdata *>(data)->deserialize(path));
+			b_plus_tree<tkey, tdata *, tkey_comparer> *tree = dynamic_cast<b_plus_tree<tkey, tdata *, tkey_comparer> *>(_data);
+			
+			auto iter = tree->last_infix();
+			
+			if (iter == tree->end_infix())
+			{
+				throw db_storage::obtaining_of_nonexistent_key_attempt_exception();
+			}
+			
+			key = std::get<2>(*iter);
+			data = std::get<3>(*iter);
+			break;
 		}
-		catch (std::ios::failure const &)
+		default:
 		{
-			throw std::ios::failure("Failed to read data");
+			collection_b_tree_orders::visit<b_tree>(_data, [&](auto *tree)
+			{
+				auto iter = tree->clast_infix();
+				auto iter_end = tree->cend_infix();
+				
+				if (iter == iter_end)
+				{
+					throw db_storage::obtaining_of_nonexistent_key_attempt_exception();
+				}
+				
+				key = std::get<2>(*iter);
+				data = std::get<3>(*iter);
+			});
 		}
+			
 	}
-	else
-	{
-		return make_pair(key, dynamic_cast<ram_tdata *>(data)->value);
-	}
+	
+	return make_pair(key, dynamic_cast<ram_tdata *>(data)->value);
 };
 
 std::pair<tkey, tvalue> db_storage::collection::obtain_next(
@@ -560,14 +871,53 @@ std::pair<tkey, tvalue> db_storage::collection::obtain_next(
 {
 	collect_garbage(path);
 	
+	if (get_instance()->_mode == mode::file_system)
+	{
+		auto cursor = records_index(path).seek(key->get_data(), true);
+		std::string next_key;
+		long file_pos;
+		
+		if (!cursor.fetch(next_key, file_pos) || next_key != key->get_data())
+		{
+			throw db_storage::obtaining_of_nonexistent_key_attempt_exception();
+		}
+		
+		// the last key is its own next one
+		cursor.fetch(next_key, file_pos);
+		
+		return make_pair(flyweight_factory::get_instance()->get_flyweight_instance(next_key), read_from_file(file_pos, path));
+	}
+	
 	tkey next_key;
 	tdata *data = nullptr;
 	
 	switch (_tree_variant)
 	{
-		default:
+		case search_tree_variant::b_plus:
 		{
-			b_tree<tkey, tdata *> *tree = dynamic_cast<b_tree<tkey, tdata *> *>(_data);
+			b_plus_tree<tkey, tdata *, tkey_comparer> *tree = dynamic_cast<b_plus_tree<tkey, tdata *, tkey_comparer> *>(_data);
+			
+			auto iter = tree->find(key);
+			auto iter_end = tree->end_infix();
+			
+			if (iter == iter_end)
+			{
+				throw db_storage::obtaining_of_nonexistent_key_attempt_exception();
+			}
+			
+			next_key = std::get<2>(*iter);
+			data = std::get<3>(*iter);
+			
+			if (++iter != iter_end)
+			{
+				next_key = std::get<2>(*iter);
+				data = std::get<3>(*iter);
+			}
+			break;
+		}
+		case search_tree_variant::b_link:
+		{
+			b_link_tree<tkey, tdata *, tkey_comparer> *tree = dynamic_cast<b_link_tree<tkey, tdata *, tkey_comparer> *>(_data);
 			
 			auto iter = tree->begin_infix();
 			auto iter_end = tree->end_infix();
@@ -590,26 +940,34 @@ std::pair<tkey, tvalue> db_storage::collection::obtain_next(
 				next_key = std::get<2>(*iter);
 				data = std::get<3>(*iter);
 			}
-			
+			break;
 		}
-			
-	}
-	
-	if (get_instance()->_mode == mode::file_system)
-	{
-		try
-		{
-			return make_pair(next_key, dynamic_cast<file_tdata *>(data)->deserialize(path));
-		}
-		catch (std::ios::failure const &)
+		default:
 		{
-			throw std::ios::failure("Failed to read data");
+			collection_b_tree_orders::visit<b_tree>(_data, [&](auto *tree)
+			{
+				auto iter = tree->find(key);
+				auto iter_end = tree->cend_infix();
+				
+				if (iter == iter_end)
+				{
+					throw db_storage::obtaining_of_nonexistent_key_attempt_exception();
+				}
+				
+				next_key = std::get<2>(*iter);
+				data = std::get<3>(*iter);
+				
+				if (++iter != iter_end)
+				{
+					next_key = std::get<2>(*iter);
+					data = std::get<3>(*iter);
+				}
+			});
 		}
+			
 	}
-	else
-	{
-		return make_pair(next_key, dynamic_cast<ram_tdata *>(data)->value);
-	}
+	
+	return make_pair(next_key, dynamic_cast<ram_tdata *>(data)->value);
 };
 
 std::pair<tkey, tvalue> db_storage::collection::obtain_min(
@@ -617,44 +975,75 @@ std::pair<tkey, tvalue> db_storage::collection::obtain_min(
 {
 	collect_garbage(path);
 	
+	if (get_instance()->_mode == mode::file_system)
+	{
+		auto cursor = records_index(path).begin();
+		std::string key;
+		long file_pos;
+		
+		if (!cursor.fetch(key, file_pos))
+		{
+			throw db_storage::obtaining_of_nonexistent_key_attempt_exception();
+		}
+		
+		return make_pair(flyweight_factory::get_instance()->get_flyweight_instance(key), read_from_file(file_pos, path));
+	}
+	
 	tkey key;
 	tdata *data = nullptr;
 	
 	switch (_tree_variant)
 	{
-		default:
+		case search_tree_variant::b_link:
 		{
-			b_tree<tkey, tdata *> *tree = dynamic_cast<b_tree<tkey, tdata *> *>(_data);
+			b_link_tree<tkey, tdata *, tkey_comparer> *tree = dynamic_cast<b_link_tree<tkey, tdata *, tkey_comparer> *>(_data);
 			
 			auto iter = tree->begin_infix();
-			auto iter_end = tree->end_infix();
 			
-			if (iter == iter_end)
+			if (iter == tree->end_infix())
 			{
 				throw db_storage::obtaining_of_nonexistent_key_attempt_exception();
 			}
 			
 			key = std::get<2>(*iter);
 			data = std::get<3>(*iter);
+			break;
 		}
-			
-	}
-	
-	if (get_instance()->_mode == mode::file_system)
-	{
-		try
+		case search_tree_variant::b_plus:
 		{
-			return make_pair(key, dynamic_cast<file_tdata *>(data)->deserialize(path));
+			b_plus_tree<tkey, tdata *, tkey_comparer> *tree = dynamic_cast<b_plus_tree<tkey, tdata *, tkey_comparer> *>(_data);
+			
+			auto iter = tree->begin_infix();
+			
+			if (iter == tree->end_infix())
+			{
+				throw db_storage::obtaining_of_nonexistent_key_attempt_exception();
+			}
+			
+			key = std::get<2>(*iter);
+			data = std::get<3>(*iter);
+			break;
 		}
-		catch (std::ios::failure const &)
+		default:
 		{
-			throw std::ios::failure("Failed to read data");
+			collection_b_tree_orders::visit<b_tree>(_data, [&](auto *tree)
+			{
+				auto iter = tree->cbegin_infix();
+				auto iter_end = tree->cend_infix();
+				
+				if (iter == iter_end)
+				{
+					throw db_storage::obtaining_of_nonexistent_key_attempt_exception();
+				}
+				
+				key = std::get<2>(*iter);
+				data = std::get<3>(*iter);
+			});
 		}
+			
 	}
-	else
-	{
-		return make_pair(key, dynamic_cast<ram_tdata *>(data)->value);
-	}
+	
+	return make_pair(key, dynamic_cast<ram_tdata *>(data)->value);
 };
 
 size_t db_storage::collection::get_records_cnt()
@@ -668,40 +1057,216 @@ void db_storage::collection::load(
 	std::string const &path,
 	long file_pos)
 {
-	tdata *data = nullptr;
+	tdata *data = create_data(std::move(value), file_pos);
 	
 	try
 	{
-		if (get_instance()->_mode == mode::file_system)
+		_data->insert(key, data);
+	}
+	catch (search_tree<tkey, tdata *, tkey_comparer>::insertion_of_existent_key_attempt_exception_exception const &)
+	{
+		deallocate_with_guard(data);
+		throw db_storage::insertion_of_existent_key_attempt_exception();
+		// TODO
+	}
+	
+	++_records_cnt;
+}
+
+void db_storage::collection::load(
+	std::vector<stored_record> &&records,
+	std::string const &path)
+{
+	// data file is sorted up to records written after last consolidation
+	std::stable_sort(records.begin(), records.end(),
+		[](stored_record const &left, stored_record const &right)
 		{
-			data = reinterpret_cast<file_tdata *>(allocate_with_guard(sizeof(file_tdata), 1));
-			allocator::construct(reinterpret_cast<file_tdata *>(data), file_pos);
+			return tkey_comparer()(left.key, right.key) < 0;
+		});
+	
+	if (get_instance()->_mode == mode::file_system)
+	{
+		// existing index is trusted on load, so the one built here is moved to its place only once complete
+		std::string const directory_path = std::filesystem::path(path).parent_path().string();
+		std::string const tmp_dir_path = extra_utility::make_path({directory_path, "tmp"});
+		std::string const tmp_index_path = index_path(extra_utility::make_path({tmp_dir_path, std::to_string(get_instance()->_id)}));
+		
+		mkdir(tmp_dir_path.c_str(), 0777);
+		
+		try
+		{
+			paged_index tmp_index(tmp_index_path, get_instance()->_buffer_pool, true);
+			paged_index::bulk_loader loader(tmp_index);
+			
+			for (size_t i = 0; i < records.size(); ++i)
+			{
+				// records updated later go later in data file
+				if (i + 1 == records.size() || tkey_comparer()(records[i].key, records[i + 1].key) != 0)
+				{
+					loader.append(records[i].key->get_data(), records[i].file_pos);
+				}
+			}
+			
+			loader.finish();
 		}
-		else
+		catch (...)
 		{
-			data = reinterpret_cast<ram_tdata *>(allocate_with_guard(sizeof(ram_tdata), 1));
-			allocator::construct(reinterpret_cast<ram_tdata *>(data), std::move(value));
+			std::remove(tmp_index_path.c_str());
+			throw;
+		}
+		
+		close_records_index();
+		
+		if (rename(tmp_index_path.c_str(), index_path(path).c_str()) == -1)
+		{
+			throw std::ios::failure("Failed to replace index file");
+		}
+		sync_directory(directory_path);
+		
+		_records_cnt = records_index(path).size();
+		
+		return;
+	}
+	
+	bool const has_duplicates = std::adjacent_find(records.begin(), records.end(),
+		[](stored_record const &left, stored_record const &right)
+		{
+			return tkey_comparer()(left.key, right.key) == 0;
+		}) != records.end();
+	
+	bool is_empty_b_tree = false;
+	collection_b_tree_orders::visit<b_tree>(_data, [&is_empty_b_tree](auto *tree)
+	{
+		is_empty_b_tree = tree->begin_infix() == tree->end_infix();
+	});
+	
+	if (!is_empty_b_tree || has_duplicates)
+	{
+		for (auto &record : records)
+		{
+			load(record.key, std::move(record.value), path, record.file_pos);
+		}
+		
+		return;
+	}
+	
+	std::vector<associative_container<tkey, tdata *>::key_value_pair> entries;
+	entries.reserve(records.size());
+	
+	try
+	{
+		for (auto &record : records)
+		{
+			entries.emplace_back(record.key, create_data(std::move(record.value), record.file_pos));
 		}
+		
+		collection_b_tree_orders::visit<b_tree>(_data, [&entries](auto *tree)
+		{
+			tree->bulk_load(entries.begin(), entries.end());
+		});
 	}
 	catch (std::bad_alloc const &)
 	{
-		deallocate_with_guard(data);
+		for (auto &entry : entries)
+		{
+			allocator::destruct(entry.value);
+			deallocate_with_guard(entry.value);
+		}
 		throw;
-		// TODO
 	}
 	
-	try
+	_records_cnt += entries.size();
+}
+
+void db_storage::collection::load_index(
+	std::string const &path)
+{
+	_records_cnt = records_index(path).size();
+}
+
+std::vector<db_storage::collection::stored_record> db_storage::collection::scan(
+	std::string const &path)
+{
+	if (access(path.c_str(), F_OK) == -1)
 	{
-		_data->insert(key, data);
+		throw std::ios::failure("Failed to load collection");
 	}
-	catch (search_tree<tkey, tdata *>::insertion_of_existent_key_attempt_exception_exception const &)
+	
+	auto const read = reader_of(get_instance()->_buffer_pool, data_file(path));
+	long file_pos = 0;
+	std::vector<stored_record> records;
+	
+	// record is read field after field, data file cut in the middle of one fails the load
+	auto const fetch = [&read, &file_pos](
+		char *to,
+		size_t count)
 	{
-		deallocate_with_guard(data);
-		throw db_storage::insertion_of_existent_key_attempt_exception();
-		// TODO
+		if (read(to, count, file_pos) != count)
+		{
+			throw std::ios::failure("Failed to load collection");
+		}
+		
+		file_pos += static_cast<long>(count);
+	};
+	
+	while (file_pos < _data_file_end)
+	{
+		long const record_pos = file_pos;
+		std::string login;
+		tvalue value;
+		size_t login_len, name_len;
+		
+		fetch(reinterpret_cast<char *>(&login_len), sizeof(size_t));
+		login.resize(login_len);
+		fetch(login.data(), login_len);
+		
+		fetch(reinterpret_cast<char *>(&value.personal_id), sizeof(int64_t));
+		fetch(reinterpret_cast<char *>(&name_len), sizeof(size_t));
+		
+		std::string name(name_len, '\0');
+		fetch(name.data(), name_len);
+		value.name = flyweight_factory::get_instance()->get_flyweight_instance(name);
+		
+		records.push_back({ flyweight_factory::get_instance()->get_flyweight_instance(login), std::move(value), record_pos });
 	}
 	
-	++_records_cnt;
+	return records;
+}
+
+void db_storage::collection::log_index_pages(
+	write_ahead_log &log,
+	std::string const &path)
+{
+	if (_records_index == nullptr)
+	{
+		return;
+	}
+	
+	std::string const page_path = index_path(extra_utility::make_path({path, std::to_string(get_instance()->_id)}));
+	
+	_records_index->visit_dirty([&log, &page_path](off_t pos, unsigned char const *bytes, size_t count)
+	{
+		std::string record(1, static_cast<char>(log_record_kind::page_image));
+		put_field(record, page_path);
+		put_number(record, static_cast<uint64_t>(pos));
+		put_field(record, std::string_view(reinterpret_cast<char const *>(bytes), count));
+		
+		log.append(record);
+	});
+}
+
+void db_storage::collection::write_back()
+{
+	// index pages written back may refer to any record, so records reach disk first
+	if (_data_fd != -1 && fdatasync(_data_fd) == -1)
+	{
+		throw std::ios::failure("Failed to sync data file");
+	}
+	
+	if (_records_index != nullptr)
+	{
+		_records_index->write_back();
+	}
 }
 
 void db_storage::collection::consolidate(
@@ -712,6 +1277,12 @@ void db_storage::collection::consolidate(
 		return;
 	}
 	
+	// log refers to pages of index replaced here, so it is emptied before; load_db consolidates once replay is over
+	if (!get_instance()->_unreplayed_log_records.empty())
+	{
+		return;
+	}
+	
 	std::string tmp_dir_path = extra_utility::make_path({path, "tmp"});
 	std::string data_path = extra_utility::make_path({path, std::to_string(get_instance()->_id)});
 	std::string tmp_path = extra_utility::make_path({path, "tmp", std::to_string(get_instance()->_id)});
@@ -721,59 +1292,108 @@ void db_storage::collection::consolidate(
 		return;
 	}
 	
+	get_instance()->checkpoint();
+	
 	mkdir(tmp_dir_path.c_str(), 0777);
 	
-	switch (_tree_variant)
+	std::string tmp_index_path = index_path(tmp_path);
+	buffer_pool &pool = get_instance()->_buffer_pool;
+	int const data_fd = data_file(data_path);
+	paged_index &data_index = records_index(data_path);
+	
+	int tmp_fd = open(tmp_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+	if (tmp_fd == -1)
 	{
-		case search_tree_variant::b:
-			//break;
-		case search_tree_variant::b_plus:
-			//break;
-		case search_tree_variant::b_star:
-			//break;
-		case search_tree_variant::b_star_plus:
-			//break;
-		default:
+		throw std::ios::failure("Failed to open tmp file");
+	}
+	
+	long tmp_end = 0;
+	
+	try
+	{
+		pool.attach(tmp_fd);
+		
+		// records are rewritten in keys order, so rewritten index is filled page after page
 		{
-			long pos = 0;
-			auto iter = dynamic_cast<b_tree<tkey, tdata *> *>(_data)->begin_infix();
-			auto iter_end = dynamic_cast<b_tree<tkey, tdata *> *>(_data)->end_infix();
-			
-			std::fstream tmp_stream(tmp_path, std::ios::out | std::ios::trunc);
-			tmp_stream.close();
+			paged_index tmp_index(tmp_index_path, pool, true);
+			paged_index::bulk_loader loader(tmp_index);
 			
-			for (; iter != iter_end; ++iter)
-			{
-				tkey key = std::get<2>(*iter);
-				file_tdata *data = dynamic_cast<file_tdata *>(std::get<3>(*iter));
-				tvalue value = data->deserialize(data_path);
-				data->serialize(tmp_path, key, value, true);
-			}
-			tmp_stream.flush();
+			auto cursor = data_index.begin();
+			std::string key;
+			long file_pos;
 			
-			tmp_stream.open(tmp_path, std::ios::in | std::ios::binary);
-			if (!tmp_stream.is_open())
+			while (cursor.fetch(key, file_pos))
 			{
-				throw std::ios::failure("Failed to open tmp fail");
+				long const rewritten_file_pos = tmp_end;
+				
+				// mapped records are copied field by field, their names are not put to flyweight factory
+				if (get_instance()->_is_data_mapped)
+				{
+					file_record_view const record = file_tdata(file_pos).view(mapped_data(data_path));
+					file_tdata().serialize(writer_of(pool, tmp_fd), tmp_end, key, record.personal_id, record.name);
+				}
+				else
+				{
+					tvalue value = file_tdata(file_pos).deserialize(reader_of(pool, data_fd));
+					file_tdata().serialize(writer_of(pool, tmp_fd), tmp_end, key, value);
+				}
+				
+				loader.append(key, rewritten_file_pos);
 			}
 			
-			std::fstream data_stream(data_path, std::ios::out | std::ios::binary | std::ios::trunc);
-			if (!data_stream.is_open())
+			// rewritten records reach the file before index referring to them replaces the old one
+			pool.flush(tmp_fd);
+			if (fdatasync(tmp_fd) == -1)
 			{
-				throw std::ios::failure("Failed to open data file");
+				throw std::ios::failure("Failed to sync tmp file");
 			}
 			
-			(data_stream << tmp_stream.rdbuf()).flush();
-			std::remove(tmp_path.c_str());
+			loader.finish();
 		}
 	}
+	catch (...)
+	{
+		pool.detach(tmp_fd);
+		close(tmp_fd);
+		std::remove(tmp_path.c_str());
+		std::remove(tmp_index_path.c_str());
+		throw;
+	}
+	
+	// new data file paired with old index is unreadable, so replacement of both is logged and finished on recovery
+	std::string const record = make_replacement_record(path,
+		{{tmp_path, data_path}, {tmp_index_path, index_path(data_path)}});
+	write_ahead_log &log = *get_instance()->_log;
+	
+	try
+	{
+		log.append(record);
+		log.sync();
+		replace_files(record);
+		log.reset();
+	}
+	catch (...)
+	{
+		pool.detach(tmp_fd);
+		close(tmp_fd);
+		throw;
+	}
+	
+	// descriptors of replaced files are stale now, rewritten data file is adopted and index is reopened on demand
+	close_records_index();
+	close_data_file();
+	_data_fd = tmp_fd;
+	_data_file_end = tmp_end;
 }
 
 
 void db_storage::collection::clear()
 {
-	delete _data;
+	get_instance()->reclaim(_data, _records_cnt);
 	_data = nullptr;
+	
+	close_records_index();
+	close_data_file();
 };
 
 void db_storage::collection::copy_from(
@@ -781,19 +1401,31 @@ void db_storage::collection::copy_from(
 {
 	switch (_tree_variant = other._tree_variant)
 	{
-	case search_tree_variant::b:
-		//break;
+	case search_tree_variant::b_link:
+		_data = new b_link_tree<tkey, tdata *, tkey_comparer>(
+			*dynamic_cast<b_link_tree<tkey, tdata *, tkey_comparer> *>(other._data));
+		break;
 	case search_tree_variant::b_plus:
-		//break;
+		_data = new b_plus_tree<tkey, tdata *, tkey_comparer>(
+			*dynamic_cast<b_plus_tree<tkey, tdata *, tkey_comparer> *>(other._data));
+		break;
 	case search_tree_variant::b_star:
+		collection_b_tree_orders::visit<b_star_tree>(other._data, [this](auto *tree)
+		{
+			_data = new std::remove_pointer_t<decltype(tree)>(*tree);
+		});
+		break;
+	case search_tree_variant::b:
 		//break;
 	case search_tree_variant::b_star_plus:
 		//break;
 	default:
 		try
 		{
-			_data = new b_tree<tkey, tdata *>(
-				*dynamic_cast<b_tree<tkey, tdata *> *>(other._data));
+			collection_b_tree_orders::visit<b_tree>(other._data, [this](auto *tree)
+			{
+				_data = new std::remove_pointer_t<decltype(tree)>(*tree);
+			});
 		}
 		catch (std::bad_alloc const &)
 		{
@@ -801,6 +1433,16 @@ void db_storage::collection::copy_from(
 		}
 		break;
 	}
+	
+	_records_cnt = other._records_cnt;
+	_disposed_cnt = other._disposed_cnt;
+	
+	// copy opens data file and index on its own
+	_data_fd = -1;
+	_data_file_end = 0;
+	_data_map = nullptr;
+	_data_map_size = 0;
+	_records_index = nullptr;
 };
 
 void db_storage::collection::move_from(
@@ -808,19 +1450,31 @@ void db_storage::collection::move_from(
 {
 	switch (_tree_variant = other._tree_variant)
 	{
-	case search_tree_variant::b:
-		//break;
+	case search_tree_variant::b_link:
+		_data = new b_link_tree<tkey, tdata *, tkey_comparer>(
+			std::move(*dynamic_cast<b_link_tree<tkey, tdata *, tkey_comparer> *>(other._data)));
+		break;
 	case search_tree_variant::b_plus:
-		//break;
+		_data = new b_plus_tree<tkey, tdata *, tkey_comparer>(
+			std::move(*dynamic_cast<b_plus_tree<tkey, tdata *, tkey_comparer> *>(other._data)));
+		break;
 	case search_tree_variant::b_star:
+		collection_b_tree_orders::visit<b_star_tree>(other._data, [this](auto *tree)
+		{
+			_data = new std::remove_pointer_t<decltype(tree)>(std::move(*tree));
+		});
+		break;
+	case search_tree_variant::b:
 		//break;
 	case search_tree_variant::b_star_plus:
 		//break;
 	default:
 		try
 		{
-			_data = new b_tree<tkey, tdata *>(
-				std::move(*dynamic_cast<b_tree<tkey, tdata *> *>(other._data)));
+			collection_b_tree_orders::visit<b_tree>(other._data, [this](auto *tree)
+			{
+				_data = new std::remove_pointer_t<decltype(tree)>(std::move(*tree));
+			});
 		}
 		catch (std::bad_alloc const &)
 		{
@@ -830,18 +1484,233 @@ void db_storage::collection::move_from(
 		break;
 	}
 	
-	other._data = nullptr;
+	other._data = nullptr;
+	_records_cnt = other._records_cnt;
+	_disposed_cnt = other._disposed_cnt;
+	_data_fd = other._data_fd;
+	_data_file_end = other._data_file_end;
+	_data_map = other._data_map;
+	_data_map_size = other._data_map_size;
+	_records_index = other._records_index;
+	other._data_fd = -1;
+	other._data_map = nullptr;
+	other._data_map_size = 0;
+	other._records_index = nullptr;
+	
+	// TODO ALLOCATORS
+};
+
+tdata *db_storage::collection::create_data(
+	tvalue &&value,
+	long file_pos)
+{
+	tdata *data = nullptr;
+	
+	try
+	{
+		if (get_instance()->_mode == mode::file_system)
+		{
+			data = reinterpret_cast<file_tdata *>(allocate_with_guard(sizeof(file_tdata), 1));
+			allocator::construct(reinterpret_cast<file_tdata *>(data), file_pos);
+		}
+		else
+		{
+			data = reinterpret_cast<ram_tdata *>(allocate_with_guard(sizeof(ram_tdata), 1));
+			allocator::construct(reinterpret_cast<ram_tdata *>(data), std::move(value));
+		}
+	}
+	catch (std::bad_alloc const &)
+	{
+		deallocate_with_guard(data);
+		throw;
+		// TODO
+	}
+	
+	return data;
+}
+
+void db_storage::collection::collect_garbage(
+	std::string const &path)
+{
+	if (_disposed_cnt > 0.35 * _records_cnt)
+	{
+		consolidate(path);
+		_disposed_cnt = 0;
+	}
+}
+
+int db_storage::collection::data_file(
+	std::string const &path)
+{
+	if (_data_fd != -1)
+	{
+		return _data_fd;
+	}
+	
+	int const fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+	if (fd == -1)
+	{
+		throw std::ios::failure("Cannot open the file");
+	}
+	
+	try
+	{
+		get_instance()->_buffer_pool.attach(fd);
+	}
+	catch (...)
+	{
+		close(fd);
+		throw;
+	}
+	
+	_data_fd = fd;
+	_data_file_end = get_instance()->_buffer_pool.size(fd);
+	
+	return _data_fd;
+}
+
+void db_storage::collection::close_data_file() noexcept
+{
+	unmap_data_file();
+	
+	if (_data_fd != -1)
+	{
+		// every operation flushes data pages it modified, so none is lost here
+		get_instance()->_buffer_pool.detach(_data_fd);
+		close(_data_fd);
+		_data_fd = -1;
+	}
+}
+
+std::string_view db_storage::collection::mapped_data(
+	std::string const &path)
+{
+	int const fd = data_file(path);
+	
+	if (_data_map_size < static_cast<size_t>(_data_file_end))
+	{
+		// mapping grows geometrically, so remapping is rare while records are appended
+		size_t const page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+		size_t size = std::max(2 * _data_map_size, static_cast<size_t>(_data_file_end));
+		size = (size + page_size - 1) / page_size * page_size;
+		
+		void *mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+		if (mapped == MAP_FAILED)
+		{
+			throw std::ios::failure("Cannot map the file");
+		}
+		
+		unmap_data_file();
+		_data_map = static_cast<char const *>(mapped);
+		_data_map_size = size;
+	}
+	
+	// pages past file end are never touched, they would not be backed by file
+	return std::string_view(_data_map, static_cast<size_t>(_data_file_end));
+}
+
+void db_storage::collection::unmap_data_file() noexcept
+{
+	if (_data_map != nullptr)
+	{
+		munmap(const_cast<char *>(_data_map), _data_map_size);
+		_data_map = nullptr;
+		_data_map_size = 0;
+	}
+}
+
+paged_index &db_storage::collection::records_index(
+	std::string const &path)
+{
+	if (_records_index == nullptr)
+	{
+		_records_index = new paged_index(index_path(path), get_instance()->_buffer_pool, false, get_instance()->_log != nullptr);
+	}
+	
+	return *_records_index;
+}
+
+void db_storage::collection::close_records_index() noexcept
+{
+	delete _records_index;
+	_records_index = nullptr;
+}
+
+void db_storage::collection::insert_to_file(
+	tkey const &key,
+	tvalue const &value,
+	std::string const &path)
+{
+	paged_index &index = records_index(path);
+	
+	if (index.obtain(key->get_data()))
+	{
+		throw db_storage::insertion_of_existent_key_attempt_exception();
+	}
+	
+	// record is written before it is indexed, so index never refers to missing record
+	int const fd = data_file(path);
+	long const file_pos = _data_file_end;
+	
+	try
+	{
+		file_tdata().serialize(writer_of(get_instance()->_buffer_pool, fd), _data_file_end, key->get_data(), value);
+		get_instance()->_buffer_pool.flush(fd);
+	}
+	catch (std::ios::failure const &)
+	{
+		throw std::ios::failure("Failed to write data");
+	}
+	
+	index.insert(key->get_data(), file_pos);
 	
-	// TODO ALLOCATORS
-};
+	++_records_cnt;
+}
 
-void db_storage::collection::collect_garbage(
+void db_storage::collection::update_in_file(
+	tkey const &key,
+	tvalue const &value,
 	std::string const &path)
 {
-	if (_disposed_cnt > 0.35 * _records_cnt)
+	paged_index &index = records_index(path);
+	
+	if (!index.obtain(key->get_data()))
 	{
-		consolidate(path);
-		_disposed_cnt = 0;
+		throw db_storage::updating_of_nonexistent_key_attempt_exception();
+	}
+	
+	int const fd = data_file(path);
+	long const file_pos = _data_file_end;
+	
+	try
+	{
+		file_tdata().serialize(writer_of(get_instance()->_buffer_pool, fd), _data_file_end, key->get_data(), value);
+		get_instance()->_buffer_pool.flush(fd);
+	}
+	catch (std::ios::failure const &)
+	{
+		throw std::ios::failure("Failed to write data");
+	}
+	
+	index.update(key->get_data(), file_pos);
+}
+
+tvalue db_storage::collection::read_from_file(
+	long file_pos,
+	std::string const &path)
+{
+	try
+	{
+		if (get_instance()->_is_data_mapped)
+		{
+			return file_tdata(file_pos).deserialize(mapped_data(path));
+		}
+		
+		return file_tdata(file_pos).deserialize(reader_of(get_instance()->_buffer_pool, data_file(path)));
+	}
+	catch (std::ios::failure const &)
+	{
+		throw std::ios::failure("Failed to read data");
 	}
 }
 
@@ -979,6 +1848,19 @@ void db_storage::schema::consolidate(
 	}
 }
 
+void db_storage::schema::visit(
+	std::function<void(collection &, std::string const &)> const &visitor,
+	std::string const &path)
+{
+	auto iter = dynamic_cast<b_tree<std::string, collection> *>(_collections)->begin_infix();
+	auto iter_end = dynamic_cast<b_tree<std::string, collection> *>(_collections)->end_infix();
+	
+	for (; iter != iter_end; ++iter)
+	{
+		visitor(std::get<3>(*iter), extra_utility::make_path({path, std::get<2>(*iter)}));
+	}
+}
+
 db_storage::collection &db_storage::schema::obtain(
 	std::string const &collection_name)
 {
@@ -1198,6 +2080,19 @@ void db_storage::pool::consolidate(
 	}
 }
 
+void db_storage::pool::visit(
+	std::function<void(collection &, std::string const &)> const &visitor,
+	std::string const &path)
+{
+	auto iter = dynamic_cast<b_tree<std::string, schema> *>(_schemas)->begin_infix();
+	auto iter_end = dynamic_cast<b_tree<std::string, schema> *>(_schemas)->end_infix();
+	
+	for (; iter != iter_end; ++iter)
+	{
+		std::get<3>(*iter).visit(visitor, extra_utility::make_path({path, std::get<2>(*iter)}));
+	}
+}
+
 void db_storage::pool::clear()
 {
 	delete _schemas;
@@ -1277,7 +2172,14 @@ db_storage *db_storage::get_instance()
 db_storage::db_storage():
 	_id(0),
 	_mode(mode::uninitialized),
-	_pools(8)
+	_pools(8),
+	_reclamation_threshold(0),
+	_is_reclaimer_started(false),
+	_buffer_pool(1 << 24),
+	_is_data_mapped(false),
+	_log(nullptr),
+	_log_sync_policy(write_ahead_log::sync_policy::every_commit),
+	_log_sync_interval(10)
 { }
 
 #pragma endregion db storage instance getter and constructor implementation
@@ -1302,6 +2204,10 @@ db_storage *db_storage::setup(
 	if (_mode == mode::file_system)
 	{
 		mkdir("pools", 0777);
+		
+		_log = new write_ahead_log(extra_utility::make_path({"pools", std::to_string(_id) + ".wal"}));
+		_log->set_sync_policy(_log_sync_policy, _log_sync_interval);
+		recover_log();
 	}
 	
 	return this;
@@ -1397,6 +2303,8 @@ db_storage *db_storage::load_db(
 		}
     }
 	
+	replay_log();
+	
 	try
 	{
 		consolidate();
@@ -1452,7 +2360,8 @@ db_storage *db_storage::clear()
 				{
 					if (std::filesystem::is_directory(table_entry)) continue;
 					
-					if (table_entry.path().filename() == std::to_string(get_instance()->_id))
+					if (table_entry.path().filename() == std::to_string(get_instance()->_id) ||
+							table_entry.path().filename() == index_path(std::to_string(get_instance()->_id)))
 					{
 						remove(table_entry.path().c_str());
 					}
@@ -1461,9 +2370,70 @@ db_storage *db_storage::clear()
 		}
     }
 	
+	// logged operations refer to removed records
+	if (_log != nullptr)
+	{
+		_unreplayed_log_records.clear();
+		_log->reset();
+	}
+	
+	return this;
+}
+
+db_storage *db_storage::set_reclamation_threshold(
+	size_t records_cnt)
+{
+	std::lock_guard<std::mutex> lock(_reclamation_mutex);
+	_reclamation_threshold = records_cnt;
+	
+	return this;
+}
+
+db_storage *db_storage::set_buffer_pool_budget(
+	size_t bytes)
+{
+	// resizing writes all dirty pages back, so retained ones are to be logged before
+	checkpoint();
+	_buffer_pool.resize(bytes);
+	
+	return this;
+}
+
+buffer_pool::statistics db_storage::get_buffer_pool_statistics() const noexcept
+{
+	return _buffer_pool.get_statistics();
+}
+
+db_storage *db_storage::set_data_mapping(
+	bool is_data_mapped)
+{
+	_is_data_mapped = is_data_mapped;
+	
+	return this;
+}
+
+db_storage *db_storage::set_log_sync_policy(
+	write_ahead_log::sync_policy policy,
+	std::chrono::milliseconds sync_interval)
+{
+	_log_sync_policy = policy;
+	_log_sync_interval = sync_interval;
+	
+	if (_log != nullptr)
+	{
+		_log->set_sync_policy(policy, sync_interval);
+	}
+	
 	return this;
 }
 
+write_ahead_log::statistics db_storage::get_log_statistics()
+{
+	return _log != nullptr
+		? _log->get_statistics()
+		: write_ahead_log::statistics{};
+}
+
 db_storage *db_storage::add_pool(
 	std::string const &pool_name,
 	db_storage::search_tree_variant tree_variant,
@@ -1518,6 +2488,9 @@ db_storage *db_storage::add_pool(
 db_storage *db_storage::dispose_pool(
 	std::string const &pool_name)
 {
+	// log must not refer to removed files, they may be created anew
+	checkpoint();
+	
 	throw_if_uninutialized_at_perform()
 		.dispose(pool_name);
 	
@@ -1592,6 +2565,9 @@ db_storage *db_storage::dispose_schema(
 	std::string const &pool_name,
 	std::string const &schema_name)
 {
+	// log must not refer to removed files, they may be created anew
+	checkpoint();
+	
 	throw_if_uninutialized_at_perform()
 		.obtain(pool_name)
 		.dispose(schema_name);
@@ -1685,6 +2661,9 @@ db_storage *db_storage::dispose_collection(
 	std::string const &schema_name,
 	std::string const &collection_name)
 {
+	// log must not refer to removed files, they may be created anew
+	checkpoint();
+	
 	throw_if_uninutialized_at_perform()
 		.obtain(pool_name)
 		.obtain(schema_name)
@@ -1721,6 +2700,11 @@ db_storage *db_storage::add(
 		.obtain(collection_name)
 		.insert(key, value, path);
 	
+	if (_log != nullptr)
+	{
+		commit_to_log(make_log_record(log_record_kind::put, pool_name, schema_name, collection_name, key, &value));
+	}
+	
 	return this;
 }
 
@@ -1733,6 +2717,11 @@ db_storage *db_storage::add(
 {
 	std::string path = extra_utility::make_path({"pools", pool_name, schema_name, collection_name, std::to_string(_id)});
 	
+	// value is moved away by operation, so record is made before it
+	std::string const record = _log != nullptr
+		? make_log_record(log_record_kind::put, pool_name, schema_name, collection_name, key, &value)
+		: std::string();
+	
 	throw_if_uninutialized_at_perform()
 		.throw_if_invalid_path(path)
 		.obtain(pool_name)
@@ -1740,6 +2729,11 @@ db_storage *db_storage::add(
 		.obtain(collection_name)
 		.insert(key, std::move(value), path);
 	
+	if (_log != nullptr)
+	{
+		commit_to_log(record);
+	}
+	
 	return this;
 }
 
@@ -1759,6 +2753,11 @@ db_storage *db_storage::update(
 		.obtain(collection_name)
 		.update(key, value, path);
 	
+	if (_log != nullptr)
+	{
+		commit_to_log(make_log_record(log_record_kind::put, pool_name, schema_name, collection_name, key, &value));
+	}
+	
 	return this;
 }
 
@@ -1771,6 +2770,11 @@ db_storage *db_storage::update(
 {
 	std::string path = extra_utility::make_path({"pools", pool_name, schema_name, collection_name, std::to_string(_id)});
 	
+	// value is moved away by operation, so record is made before it
+	std::string const record = _log != nullptr
+		? make_log_record(log_record_kind::put, pool_name, schema_name, collection_name, key, &value)
+		: std::string();
+	
 	throw_if_uninutialized_at_perform()
 		.throw_if_invalid_path(path)
 		.obtain(pool_name)
@@ -1778,6 +2782,11 @@ db_storage *db_storage::update(
 		.obtain(collection_name)
 		.update(key, std::move(value), path);
 	
+	if (_log != nullptr)
+	{
+		commit_to_log(record);
+	}
+	
 	return this;
 }
 
@@ -1789,12 +2798,19 @@ tvalue db_storage::dispose(
 {
 	std::string path = extra_utility::make_path({"pools", pool_name, schema_name, collection_name, std::to_string(_id)});
 	
-	return throw_if_uninutialized_at_perform()
+	tvalue value = throw_if_uninutialized_at_perform()
 				.throw_if_invalid_path(path)
 				.obtain(pool_name)
 				.obtain(schema_name)
 				.obtain(collection_name)
 				.dispose(key, path);
+	
+	if (_log != nullptr)
+	{
+		commit_to_log(make_log_record(log_record_kind::disposal, pool_name, schema_name, collection_name, key));
+	}
+	
+	return value;
 }
 
 tvalue db_storage::obtain(
@@ -1832,6 +2848,26 @@ std::vector<std::pair<tkey, tvalue>> db_storage::obtain_between(
 			.obtain_between(lower_bound, upper_bound, lower_bound_inclusive, upper_bound_inclusive, path);
 }
 
+void db_storage::obtain_between(
+	std::string const &pool_name,
+	std::string const &schema_name,
+	std::string const &collection_name,
+	tkey const &lower_bound,
+	tkey const &upper_bound,
+	bool lower_bound_inclusive,
+	bool upper_bound_inclusive,
+	std::function<void(tkey const &, tvalue &&)> const &consumer)
+{
+	std::string path = extra_utility::make_path({"pools", pool_name, schema_name, collection_name, std::to_string(_id)});
+	
+	throw_if_uninutialized_at_perform()
+			.throw_if_invalid_path(path)
+			.obtain(pool_name)
+			.obtain(schema_name)
+			.obtain(collection_name)
+			.obtain_between(lower_bound, upper_bound, lower_bound_inclusive, upper_bound_inclusive, path, consumer);
+}
+
 std::pair<tkey, tvalue> db_storage::obtain_min(
 	std::string const &pool_name,
 	std::string const &schema_name,
@@ -1891,6 +2927,38 @@ db_storage *db_storage::consolidate()
 	return this;
 }
 
+db_storage *db_storage::checkpoint()
+{
+	if (_log == nullptr || _log->size() == 0)
+	{
+		return this;
+	}
+	
+	// pages torn by crash during write back are restored from images, which are synced with their checkpoint record
+	visit_collections([this](collection &target, std::string const &path)
+	{
+		target.log_index_pages(*_log, path);
+	});
+	
+	// records still replayed on startup are the last ones put before checkpoint record
+	std::string record(1, static_cast<char>(log_record_kind::checkpoint));
+	put_number(record, _unreplayed_log_records.size());
+	_log->append(record);
+	_log->sync();
+	
+	visit_collections([](collection &target, std::string const &)
+	{
+		target.write_back();
+	});
+	
+	if (_unreplayed_log_records.empty())
+	{
+		_log->reset();
+	}
+	
+	return this;
+}
+
 size_t db_storage::get_collection_records_cnt(
 	std::string const &pool_name,
 	std::string const &schema_name,
@@ -1910,6 +2978,155 @@ size_t db_storage::get_collection_records_cnt(
 
 #pragma region db storage utility data operations implementation
 
+void db_storage::visit_collections(
+	std::function<void(collection &, std::string const &)> const &visitor)
+{
+	auto iter = _pools.begin_infix();
+	auto iter_end = _pools.end_infix();
+	
+	for (; iter != iter_end; ++iter)
+	{
+		std::get<3>(*iter).visit(visitor, extra_utility::make_path({"pools", std::get<2>(*iter)}));
+	}
+}
+
+void db_storage::commit_to_log(
+	std::string const &record)
+{
+	_log->commit(_log->append(record));
+	
+	// retained index pages are not evicted, so they are written back before they fill buffer pool
+	if (_log->size() >= checkpoint_log_size ||
+			2 * _buffer_pool.get_dirty_frames_cnt() >= _buffer_pool.get_frames_cnt())
+	{
+		checkpoint();
+	}
+}
+
+void db_storage::recover_log()
+{
+	std::vector<std::string> records = _log->read();
+	std::vector<std::string const *> images;
+	
+	for (auto &record : records)
+	{
+		log_record_reader reader(record);
+		log_record_kind const kind = reader.kind();
+		
+		if (kind == log_record_kind::page_image)
+		{
+			images.push_back(&record);
+			continue;
+		}
+		
+		// log is emptied right after replacement, so record is found here only if crash came before
+		if (kind == log_record_kind::replacement)
+		{
+			replace_files(record);
+			continue;
+		}
+		
+		if (kind != log_record_kind::checkpoint)
+		{
+			_unreplayed_log_records.push_back(std::move(record));
+			continue;
+		}
+		
+		size_t const unreplayed_cnt = reader.number();
+		if (unreplayed_cnt > _unreplayed_log_records.size())
+		{
+			throw std::ios::failure("Invalid log record");
+		}
+		
+		_unreplayed_log_records.erase(
+			_unreplayed_log_records.begin(),
+			_unreplayed_log_records.end() - static_cast<std::ptrdiff_t>(unreplayed_cnt));
+		
+		// files of removed collections are not created anew
+		for (std::string const *image : images)
+		{
+			log_record_reader image_reader(*image);
+			image_reader.kind();
+			std::string const path(image_reader.field());
+			off_t const pos = static_cast<off_t>(image_reader.number());
+			std::string_view const bytes = image_reader.field();
+			
+			int const fd = open(path.c_str(), O_WRONLY | O_CLOEXEC);
+			if (fd == -1)
+			{
+				continue;
+			}
+			
+			bool const is_written = pwrite(fd, bytes.data(), bytes.size(), pos) == static_cast<ssize_t>(bytes.size()) &&
+				fdatasync(fd) != -1;
+			close(fd);
+			
+			if (!is_written)
+			{
+				throw std::ios::failure("Failed to recover index page");
+			}
+		}
+		
+		images.clear();
+	}
+	
+	// images past last checkpoint record were not written back to files, so they are dropped
+}
+
+void db_storage::replay_log()
+{
+	while (!_unreplayed_log_records.empty())
+	{
+		log_record_reader reader(_unreplayed_log_records.front());
+		log_record_kind const kind = reader.kind();
+		std::string const pool_name(reader.field());
+		std::string const schema_name(reader.field());
+		std::string const collection_name(reader.field());
+		tkey const key = flyweight_factory::get_instance()->get_flyweight_instance(std::string(reader.field()));
+		std::string const path = extra_utility::make_path({"pools", pool_name, schema_name, collection_name, std::to_string(_id)});
+		
+		try
+		{
+			collection &target = obtain(pool_name).obtain(schema_name).obtain(collection_name);
+			
+			if (kind == log_record_kind::put)
+			{
+				uint64_t const personal_id = reader.number();
+				tvalue const value(personal_id, std::string(reader.field()));
+				
+				try
+				{
+					target.insert(key, value, path);
+				}
+				catch (db_storage::insertion_of_existent_key_attempt_exception const &)
+				{
+					target.update(key, value, path);
+				}
+			}
+			else
+			{
+				try
+				{
+					target.dispose(key, path);
+				}
+				catch (db_storage::disposal_of_nonexistent_key_attempt_exception const &)
+				{ }
+			}
+		}
+		catch (db_storage::invalid_path_exception const &)
+		{
+			// operation on collection removed since it was logged
+		}
+		
+		_unreplayed_log_records.pop_front();
+		
+		if (2 * _buffer_pool.get_dirty_frames_cnt() >= _buffer_pool.get_frames_cnt())
+		{
+			checkpoint();
+		}
+	}
+}
+
 void db_storage::add(
 	std::string const &pool_name,
 	search_tree_variant tree_variant,
@@ -1962,54 +3179,74 @@ void db_storage::load_collection(
 {
 	std::string data_path = extra_utility::make_path({prefix, pool_name, schema_name, collection_name, std::to_string(get_instance()->_id)});
 	
-	std::ifstream data_stream(data_path, std::ios::binary);
-    if (!data_stream.is_open())
-    {
-        throw std::ios::failure("Failed to load collection");
-    }
+	collection &loaded = get_instance()->obtain(pool_name)
+		.obtain(schema_name)
+		.obtain(collection_name);
 	
-	long file_pos = 0;
+	// data file is scanned only if it has no index yet
+	if (access(index_path(data_path).c_str(), F_OK) != -1)
+	{
+		loaded.load_index(data_path);
+		return;
+	}
 	
-    while (data_stream.peek() != EOF)
-    {
-		char ch;
-		tkey login;
-		tvalue value;
-		size_t login_len, name_len;
-		
-		data_stream.read(reinterpret_cast<char *>(&login_len), sizeof(size_t));
-
-
+	loaded.load(loaded.scan(data_path), data_path);
+}
 
-		value.name->get_data().reserve(login_len);
-		for (size_t i = 0; i < login_len; ++i)
+void db_storage::reclaim(
+	search_tree<tkey, tdata *, tkey_comparer> *data,
+	size_t records_cnt) noexcept
+{
+	if (data == nullptr)
+	{
+		return;
+	}
+	
+	std::unique_lock<std::mutex> lock(_reclamation_mutex);
+	
+	if (_reclamation_threshold != 0 && records_cnt >= _reclamation_threshold)
+	{
+		try
 		{
-			data_stream.read(&ch, sizeof(char));
-			login->get_data().push_back(ch);
+			// reclaimer is started first, so data once queued is never deleted here
+			if (!_is_reclaimer_started)
+			{
+				std::thread(&db_storage::run_reclaimer, this).detach();
+				_is_reclaimer_started = true;
+			}
+			
+			_reclamation_queue.push(data);
+			lock.unlock();
+			_reclamation_condition.notify_one();
+			
+			return;
 		}
-		
-		data_stream.read(reinterpret_cast<char *>(&value.personal_id), sizeof(size_t));
-		data_stream.read(reinterpret_cast<char *>(&name_len), sizeof(size_t));
-		
-		value.name->get_data().reserve(name_len);
-		for (size_t i = 0; i < name_len; ++i)
+		catch (...)
 		{
-			data_stream.read(&ch, sizeof(char));
-			value.name->get_data().push_back(ch);
+			// thread could not be started or queue could not grow, data is deleted inline
 		}
+	}
+	
+	lock.unlock();
+	delete data;
+}
+
+void db_storage::run_reclaimer()
+{
+	std::unique_lock<std::mutex> lock(_reclamation_mutex);
+	
+	// storage instance is never destroyed, so reclaimer lives as long as the process
+	while (true)
+	{
+		_reclamation_condition.wait(lock, [this]() { return !_reclamation_queue.empty(); });
 		
-		get_instance()->obtain(pool_name)
-						.obtain(schema_name)
-						.obtain(collection_name)
-						.load(login, std::move(value), data_path, file_pos);
+		auto *data = _reclamation_queue.front();
+		_reclamation_queue.pop();
 		
-		file_pos = data_stream.tellg();
-    }
-	
-	if (data_stream.fail())
-    {
-        throw std::ios::failure("Failed to load collection");
-    }
+		lock.unlock();
+		delete data;
+		lock.lock();
+	}
 }
 
 #pragma endregion db storage utility data operations implementation
@@ -0,0 +1,839 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ios>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../include/paged_index.h"
+
+namespace
+{
+
+	// page starts with header followed by slots holding offsets of cells in keys order; cells are put from page end
+	// towards slots and consist of key size, key and 8 bytes payload: record position in leaf, id of child with keys
+	// not less than the key in inner page, whose child with smallest keys is kept in link
+	size_t constexpr kind_offset = 0;
+	size_t constexpr count_offset = 2;
+	size_t constexpr cells_begin_offset = 4;
+	size_t constexpr garbage_offset = 6;
+	// next leaf or child with smallest keys
+	size_t constexpr link_offset = 8;
+	size_t constexpr previous_offset = 12;
+	size_t constexpr header_size = 16;
+
+	uint16_t constexpr inner_kind = 0;
+	uint16_t constexpr leaf_kind = 1;
+
+	size_t constexpr magic_offset = 0;
+	size_t constexpr page_size_offset = 8;
+	size_t constexpr root_offset = 12;
+	size_t constexpr pages_cnt_offset = 16;
+	size_t constexpr records_cnt_offset = 24;
+
+	uint64_t constexpr magic = 0x31305844495F4750;
+
+	// bulk loaded pages are left partly free, so following insertions do not split them at once
+	size_t constexpr fill_limit = paged_index::page_size - paged_index::page_size / 8;
+
+	template<
+		typename t>
+	t load(
+		unsigned char const *bytes,
+		size_t offset)
+	{
+		t value;
+		std::memcpy(&value, bytes + offset, sizeof(t));
+		return value;
+	}
+
+	template<
+		typename t>
+	void store(
+		unsigned char *bytes,
+		size_t offset,
+		t value)
+	{
+		std::memcpy(bytes + offset, &value, sizeof(t));
+	}
+
+	void init_page(
+		unsigned char *page,
+		bool is_leaf)
+	{
+		std::memset(page, 0, paged_index::page_size);
+		store<uint16_t>(page, kind_offset, is_leaf ? leaf_kind : inner_kind);
+		store<uint16_t>(page, cells_begin_offset, paged_index::page_size);
+	}
+
+	bool is_leaf(
+		unsigned char const *page)
+	{
+		return load<uint16_t>(page, kind_offset) == leaf_kind;
+	}
+
+	size_t count(
+		unsigned char const *page)
+	{
+		return load<uint16_t>(page, count_offset);
+	}
+
+	size_t cell_size(
+		size_t key_size)
+	{
+		return sizeof(uint16_t) + key_size + sizeof(uint64_t);
+	}
+
+	size_t cell_offset(
+		unsigned char const *page,
+		size_t index)
+	{
+		return load<uint16_t>(page, header_size + index * sizeof(uint16_t));
+	}
+
+	std::string_view cell_key(
+		unsigned char const *page,
+		size_t index)
+	{
+		size_t const offset = cell_offset(page, index);
+
+		return { reinterpret_cast<char const *>(page + offset + sizeof(uint16_t)), load<uint16_t>(page, offset) };
+	}
+
+	uint64_t cell_payload(
+		unsigned char const *page,
+		size_t index)
+	{
+		size_t const offset = cell_offset(page, index);
+
+		return load<uint64_t>(page, offset + sizeof(uint16_t) + load<uint16_t>(page, offset));
+	}
+
+	void set_cell_payload(
+		unsigned char *page,
+		size_t index,
+		uint64_t payload)
+	{
+		size_t const offset = cell_offset(page, index);
+
+		store<uint64_t>(page, offset + sizeof(uint16_t) + load<uint16_t>(page, offset), payload);
+	}
+
+	// first slot with key not less than given one or, if is_upper, greater than it
+	size_t search(
+		unsigned char const *page,
+		std::string_view key,
+		bool is_upper)
+	{
+		size_t left = 0;
+		size_t right = count(page);
+
+		while (left < right)
+		{
+			size_t const middle = left + (right - left) / 2;
+			int const comparison = cell_key(page, middle).compare(key);
+
+			if (comparison < 0 || (is_upper && comparison == 0))
+			{
+				left = middle + 1;
+			}
+			else
+			{
+				right = middle;
+			}
+		}
+
+		return left;
+	}
+
+	bool is_key_at(
+		unsigned char const *page,
+		size_t index,
+		std::string_view key)
+	{
+		return index < count(page) && cell_key(page, index) == key;
+	}
+
+	size_t used_space(
+		unsigned char const *page)
+	{
+		return header_size + count(page) * sizeof(uint16_t) + paged_index::page_size
+			- load<uint16_t>(page, cells_begin_offset) - load<uint16_t>(page, garbage_offset);
+	}
+
+	// moves cells to page end, so space left by removed ones is usable again
+	void compact(
+		unsigned char *page)
+	{
+		unsigned char compacted[paged_index::page_size];
+		size_t const cells_count = count(page);
+		size_t cells_begin = paged_index::page_size;
+
+		for (size_t i = 0; i < cells_count; ++i)
+		{
+			size_t const size = cell_size(cell_key(page, i).size());
+			cells_begin -= size;
+			std::memcpy(compacted + cells_begin, page + cell_offset(page, i), size);
+			store<uint16_t>(page, header_size + i * sizeof(uint16_t), cells_begin);
+		}
+
+		std::memcpy(page + cells_begin, compacted + cells_begin, paged_index::page_size - cells_begin);
+		store<uint16_t>(page, cells_begin_offset, cells_begin);
+		store<uint16_t>(page, garbage_offset, 0);
+	}
+
+	// returns false if page has no room for cell
+	bool insert_cell(
+		unsigned char *page,
+		size_t index,
+		std::string_view key,
+		uint64_t payload)
+	{
+		size_t const cells_count = count(page);
+		size_t const size = cell_size(key.size());
+		size_t const slots_end = header_size + cells_count * sizeof(uint16_t);
+		size_t free_space = load<uint16_t>(page, cells_begin_offset) - slots_end;
+
+		if (free_space < size + sizeof(uint16_t))
+		{
+			if (free_space + load<uint16_t>(page, garbage_offset) < size + sizeof(uint16_t))
+			{
+				return false;
+			}
+
+			compact(page);
+		}
+
+		size_t const offset = load<uint16_t>(page, cells_begin_offset) - size;
+		store<uint16_t>(page, offset, key.size());
+		std::memcpy(page + offset + sizeof(uint16_t), key.data(), key.size());
+		store<uint64_t>(page, offset + sizeof(uint16_t) + key.size(), payload);
+
+		unsigned char *slot = page + header_size + index * sizeof(uint16_t);
+		std::memmove(slot + sizeof(uint16_t), slot, (cells_count - index) * sizeof(uint16_t));
+		store<uint16_t>(page, header_size + index * sizeof(uint16_t), offset);
+
+		store<uint16_t>(page, cells_begin_offset, offset);
+		store<uint16_t>(page, count_offset, cells_count + 1);
+
+		return true;
+	}
+
+	void remove_cell(
+		unsigned char *page,
+		size_t index)
+	{
+		size_t const cells_count = count(page);
+
+		store<uint16_t>(page, garbage_offset,
+			load<uint16_t>(page, garbage_offset) + cell_size(cell_key(page, index).size()));
+
+		unsigned char *slot = page + header_size + index * sizeof(uint16_t);
+		std::memmove(slot, slot + sizeof(uint16_t), (cells_count - index - 1) * sizeof(uint16_t));
+		store<uint16_t>(page, count_offset, cells_count - 1);
+	}
+
+	void check_key_size(
+		std::string_view key)
+	{
+		if (key.size() > paged_index::max_key_size)
+		{
+			throw std::length_error("key does not fit index page");
+		}
+	}
+
+}
+
+#pragma region paged index cursor implementation
+
+paged_index::cursor::cursor(
+	paged_index *index,
+	page_id leaf,
+	size_t slot) noexcept:
+		_index(index),
+		_leaf(leaf),
+		_slot(slot)
+{ }
+
+bool paged_index::cursor::fetch(
+	std::string &key,
+	long &file_pos)
+{
+	// leaves emptied by disposals are skipped
+	while (_leaf != 0)
+	{
+		buffer_pool::page_guard leaf = _index->fetch_page(_leaf);
+
+		if (_slot < count(leaf.data()))
+		{
+			key.assign(cell_key(leaf.data(), _slot));
+			file_pos = static_cast<long>(cell_payload(leaf.data(), _slot));
+			++_slot;
+
+			return true;
+		}
+
+		_leaf = load<uint32_t>(leaf.data(), link_offset);
+		_slot = 0;
+	}
+
+	return false;
+}
+
+#pragma endregion paged index cursor implementation
+
+#pragma region paged index bulk loader implementation
+
+paged_index::bulk_loader::bulk_loader(
+	paged_index &index):
+		_index(index),
+		_appended_cnt(0)
+{
+	if (_index._records_cnt != 0)
+	{
+		throw std::logic_error("only empty index can be bulk loaded");
+	}
+
+	// empty index consists of root leaf
+	_levels.push_back(_index._root);
+}
+
+void paged_index::bulk_loader::append(
+	std::string_view key,
+	long file_pos)
+{
+	check_key_size(key);
+
+	if (_appended_cnt != 0 && key <= _last_key)
+	{
+		throw std::invalid_argument("bulk loaded keys must ascend");
+	}
+
+	append_to_level(0, key, static_cast<uint64_t>(file_pos));
+
+	_last_key.assign(key);
+	++_appended_cnt;
+
+	// pages of retained index would not be evicted, so they are written back before they fill buffer pool
+	if (2 * _index._pool.get_dirty_frames_cnt() >= _index._pool.get_frames_cnt())
+	{
+		_index._pool.flush(_index._fd);
+	}
+}
+
+void paged_index::bulk_loader::finish()
+{
+	_index._root = _levels.back();
+	_index._records_cnt = _appended_cnt;
+	_index._is_meta_dirty = true;
+
+	// bulk loaded pages are not covered by write ahead log, so they are not retained
+	_index.write_back();
+}
+
+void paged_index::bulk_loader::append_to_level(
+	size_t level,
+	std::string_view key,
+	uint64_t payload)
+{
+	page_id const current_id = _levels[level];
+	page_id next_id;
+
+	{
+		buffer_pool::page_guard current = _index.fetch_page(current_id);
+
+		if (used_space(current.data()) + cell_size(key.size()) + sizeof(uint16_t) <= fill_limit)
+		{
+			insert_cell(current.data(), count(current.data()), key, payload);
+			current.mark_dirty();
+
+			return;
+		}
+
+		bool const is_leaf_level = level == 0;
+		buffer_pool::page_guard next = _index.create_page(is_leaf_level, next_id);
+
+		if (is_leaf_level)
+		{
+			store<uint32_t>(current.data(), link_offset, next_id);
+			store<uint32_t>(next.data(), previous_offset, current_id);
+			insert_cell(next.data(), 0, key, payload);
+			current.mark_dirty();
+		}
+		else
+		{
+			// key goes up, its child becomes the one with smallest keys
+			store<uint32_t>(next.data(), link_offset, static_cast<page_id>(payload));
+		}
+	}
+
+	_levels[level] = next_id;
+
+	if (level + 1 == _levels.size())
+	{
+		page_id root_id;
+		buffer_pool::page_guard root = _index.create_page(false, root_id);
+		store<uint32_t>(root.data(), link_offset, current_id);
+		_levels.push_back(root_id);
+	}
+
+	append_to_level(level + 1, key, next_id);
+}
+
+#pragma endregion paged index bulk loader implementation
+
+#pragma region paged index construction and destruction implementation
+
+paged_index::paged_index(
+	std::string const &path,
+	buffer_pool &pool,
+	bool is_truncated,
+	bool is_retained):
+		_pool(pool),
+		_fd(-1),
+		_root(0),
+		_pages_cnt(1),
+		_records_cnt(0),
+		_is_meta_dirty(false),
+		_is_retained(is_retained)
+{
+	_fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC | (is_truncated ? O_TRUNC : 0), 0666);
+	if (_fd == -1)
+	{
+		throw std::ios::failure("Cannot open the index file");
+	}
+
+	try
+	{
+		_pool.attach(_fd, _is_retained);
+
+		// new index is written at once, so empty file never stands for index
+		if (_pool.size(_fd) == 0)
+		{
+			create_page(true, _root);
+			write_back();
+		}
+		else
+		{
+			buffer_pool::page_guard meta = fetch_page(0);
+
+			if (load<uint64_t>(meta.data(), magic_offset) != magic ||
+					load<uint32_t>(meta.data(), page_size_offset) != page_size)
+			{
+				throw std::ios::failure("Invalid index file");
+			}
+
+			_root = load<uint32_t>(meta.data(), root_offset);
+			_pages_cnt = load<uint32_t>(meta.data(), pages_cnt_offset);
+			_records_cnt = load<uint64_t>(meta.data(), records_cnt_offset);
+		}
+	}
+	catch (...)
+	{
+		_pool.detach(_fd);
+		close(_fd);
+		throw;
+	}
+}
+
+paged_index::~paged_index() noexcept
+{
+	// pages of retained index left modified are dropped, they are to be written back before
+	_pool.detach(_fd);
+	close(_fd);
+}
+
+#pragma endregion paged index construction and destruction implementation
+
+#pragma region paged index operations implementation
+
+size_t paged_index::size() const noexcept
+{
+	return _records_cnt;
+}
+
+std::optional<long> paged_index::obtain(
+	std::string_view key)
+{
+	buffer_pool::page_guard leaf = fetch_page(find_leaf(key, nullptr));
+	size_t const index = search(leaf.data(), key, false);
+
+	std::optional<long> file_pos;
+	if (is_key_at(leaf.data(), index, key))
+	{
+		file_pos = static_cast<long>(cell_payload(leaf.data(), index));
+	}
+
+	return file_pos;
+}
+
+bool paged_index::insert(
+	std::string_view key,
+	long file_pos)
+{
+	check_key_size(key);
+
+	std::vector<page_id> path;
+	page_id const leaf_id = find_leaf(key, &path);
+	size_t index;
+	bool is_placed;
+
+	{
+		buffer_pool::page_guard leaf = fetch_page(leaf_id);
+		index = search(leaf.data(), key, false);
+
+		if (is_key_at(leaf.data(), index, key))
+		{
+			return false;
+		}
+
+		is_placed = insert_cell(leaf.data(), index, key, static_cast<uint64_t>(file_pos));
+		if (is_placed)
+		{
+			leaf.mark_dirty();
+		}
+	}
+
+	if (!is_placed)
+	{
+		insert_split(leaf_id, index, key, static_cast<uint64_t>(file_pos), path);
+	}
+
+	++_records_cnt;
+	_is_meta_dirty = true;
+
+	flush();
+	return true;
+}
+
+std::optional<long> paged_index::update(
+	std::string_view key,
+	long file_pos)
+{
+	std::optional<long> previous_file_pos;
+
+	{
+		buffer_pool::page_guard leaf = fetch_page(find_leaf(key, nullptr));
+		size_t const index = search(leaf.data(), key, false);
+
+		if (is_key_at(leaf.data(), index, key))
+		{
+			previous_file_pos = static_cast<long>(cell_payload(leaf.data(), index));
+			set_cell_payload(leaf.data(), index, static_cast<uint64_t>(file_pos));
+			leaf.mark_dirty();
+		}
+	}
+
+	flush();
+	return previous_file_pos;
+}
+
+std::optional<long> paged_index::dispose(
+	std::string_view key)
+{
+	std::optional<long> file_pos;
+
+	{
+		buffer_pool::page_guard leaf = fetch_page(find_leaf(key, nullptr));
+		size_t const index = search(leaf.data(), key, false);
+
+		if (is_key_at(leaf.data(), index, key))
+		{
+			file_pos = static_cast<long>(cell_payload(leaf.data(), index));
+			remove_cell(leaf.data(), index);
+			leaf.mark_dirty();
+
+			--_records_cnt;
+			_is_meta_dirty = true;
+		}
+	}
+
+	flush();
+	return file_pos;
+}
+
+paged_index::cursor paged_index::begin()
+{
+	page_id id = _root;
+
+	for (buffer_pool::page_guard current = fetch_page(id); !is_leaf(current.data()); current = fetch_page(id))
+	{
+		id = load<uint32_t>(current.data(), link_offset);
+	}
+
+	return cursor(this, id, 0);
+}
+
+paged_index::cursor paged_index::seek(
+	std::string_view key,
+	bool is_inclusive)
+{
+	page_id const leaf_id = find_leaf(key, nullptr);
+	size_t const slot = search(fetch_page(leaf_id).data(), key, !is_inclusive);
+
+	return cursor(this, leaf_id, slot);
+}
+
+bool paged_index::obtain_last(
+	std::string &key,
+	long &file_pos)
+{
+	page_id id = _root;
+
+	for (buffer_pool::page_guard current = fetch_page(id); !is_leaf(current.data()); current = fetch_page(id))
+	{
+		size_t const cells_count = count(current.data());
+
+		id = cells_count == 0
+			? load<uint32_t>(current.data(), link_offset)
+			: static_cast<page_id>(cell_payload(current.data(), cells_count - 1));
+	}
+
+	// leaves emptied by disposals are skipped
+	while (id != 0)
+	{
+		buffer_pool::page_guard leaf = fetch_page(id);
+		size_t const cells_count = count(leaf.data());
+
+		if (cells_count != 0)
+		{
+			key.assign(cell_key(leaf.data(), cells_count - 1));
+			file_pos = static_cast<long>(cell_payload(leaf.data(), cells_count - 1));
+
+			return true;
+		}
+
+		id = load<uint32_t>(leaf.data(), previous_offset);
+	}
+
+	return false;
+}
+
+void paged_index::visit_dirty(
+	std::function<void(off_t, unsigned char const *, size_t)> const &visitor)
+{
+	store_meta();
+	_pool.visit_dirty(_fd, visitor);
+}
+
+void paged_index::write_back()
+{
+	_pool.flush(_fd);
+	store_meta();
+	_pool.flush(_fd);
+
+	if (fdatasync(_fd) == -1)
+	{
+		throw std::ios::failure("Failed to sync the index file");
+	}
+}
+
+#pragma endregion paged index operations implementation
+
+#pragma region paged index utility functions implementation
+
+buffer_pool::page_guard paged_index::fetch_page(
+	page_id id)
+{
+	return _pool.pin(_fd, id);
+}
+
+buffer_pool::page_guard paged_index::create_page(
+	bool is_leaf,
+	page_id &id)
+{
+	// page past file end is not read from it
+	buffer_pool::page_guard created = _pool.pin(_fd, _pages_cnt);
+
+	id = _pages_cnt++;
+	init_page(created.data(), is_leaf);
+	created.mark_dirty();
+	_is_meta_dirty = true;
+
+	return created;
+}
+
+void paged_index::flush()
+{
+	if (_is_retained)
+	{
+		store_meta();
+		return;
+	}
+
+	_pool.flush(_fd);
+
+	if (_is_meta_dirty)
+	{
+		store_meta();
+		_pool.flush(_fd);
+	}
+}
+
+void paged_index::store_meta()
+{
+	if (!_is_meta_dirty)
+	{
+		return;
+	}
+
+	buffer_pool::page_guard meta = fetch_page(0);
+
+	std::memset(meta.data(), 0, page_size);
+	store<uint64_t>(meta.data(), magic_offset, magic);
+	store<uint32_t>(meta.data(), page_size_offset, page_size);
+	store<uint32_t>(meta.data(), root_offset, _root);
+	store<uint32_t>(meta.data(), pages_cnt_offset, _pages_cnt);
+	store<uint64_t>(meta.data(), records_cnt_offset, _records_cnt);
+	meta.mark_dirty();
+
+	_is_meta_dirty = false;
+}
+
+paged_index::page_id paged_index::find_leaf(
+	std::string_view key,
+	std::vector<page_id> *path)
+{
+	page_id id = _root;
+
+	for (buffer_pool::page_guard current = fetch_page(id); !is_leaf(current.data()); current = fetch_page(id))
+	{
+		if (path != nullptr)
+		{
+			path->push_back(id);
+		}
+
+		size_t const index = search(current.data(), key, true);
+
+		id = index == 0
+			? load<uint32_t>(current.data(), link_offset)
+			: static_cast<page_id>(cell_payload(current.data(), index - 1));
+	}
+
+	return id;
+}
+
+void paged_index::insert_split(
+	page_id id,
+	size_t index,
+	std::string_view key,
+	uint64_t payload,
+	std::vector<page_id> &path)
+{
+	std::vector<std::pair<std::string, uint64_t>> entries;
+	size_t middle = 0;
+	page_id right_id;
+
+	// pages are unpinned before parent is updated, so at most three of them are pinned at once
+	{
+		buffer_pool::page_guard left = fetch_page(id);
+		bool const is_leaf_split = is_leaf(left.data());
+		size_t const cells_count = count(left.data());
+
+		entries.reserve(cells_count + 1);
+		size_t entries_size = 0;
+
+		for (size_t i = 0; i <= cells_count; ++i)
+		{
+			if (i == index)
+			{
+				entries.emplace_back(key, payload);
+			}
+
+			if (i < cells_count)
+			{
+				entries.emplace_back(cell_key(left.data(), i), cell_payload(left.data(), i));
+			}
+		}
+
+		for (auto const &entry : entries)
+		{
+			entries_size += cell_size(entry.first.size()) + sizeof(uint16_t);
+		}
+
+		// pages are split by bytes, inner split also takes entry going up
+		for (size_t left_size = 0; left_size < entries_size / 2; ++middle)
+		{
+			left_size += cell_size(entries[middle].first.size()) + sizeof(uint16_t);
+		}
+		middle = std::clamp<size_t>(middle, 1, entries.size() - (is_leaf_split ? 1 : 2));
+
+		buffer_pool::page_guard right = create_page(is_leaf_split, right_id);
+		page_id const link = load<uint32_t>(left.data(), link_offset);
+		page_id const previous = load<uint32_t>(left.data(), previous_offset);
+
+		init_page(left.data(), is_leaf_split);
+
+		for (size_t i = 0; i < middle; ++i)
+		{
+			insert_cell(left.data(), i, entries[i].first, entries[i].second);
+		}
+
+		size_t const right_begin = is_leaf_split ? middle : middle + 1;
+		for (size_t i = right_begin; i < entries.size(); ++i)
+		{
+			insert_cell(right.data(), i - right_begin, entries[i].first, entries[i].second);
+		}
+
+		if (is_leaf_split)
+		{
+			store<uint32_t>(left.data(), link_offset, right_id);
+			store<uint32_t>(left.data(), previous_offset, previous);
+			store<uint32_t>(right.data(), link_offset, link);
+			store<uint32_t>(right.data(), previous_offset, id);
+
+			if (link != 0)
+			{
+				buffer_pool::page_guard next = fetch_page(link);
+				store<uint32_t>(next.data(), previous_offset, right_id);
+				next.mark_dirty();
+			}
+		}
+		else
+		{
+			store<uint32_t>(left.data(), link_offset, link);
+			store<uint32_t>(right.data(), link_offset, static_cast<page_id>(entries[middle].second));
+		}
+
+		left.mark_dirty();
+	}
+
+	insert_into_parent(path, id, entries[middle].first, right_id);
+}
+
+void paged_index::insert_into_parent(
+	std::vector<page_id> &path,
+	page_id left,
+	std::string_view separator,
+	page_id right)
+{
+	if (path.empty())
+	{
+		buffer_pool::page_guard root = create_page(false, _root);
+		store<uint32_t>(root.data(), link_offset, left);
+		insert_cell(root.data(), 0, separator, right);
+
+		return;
+	}
+
+	page_id const parent_id = path.back();
+	path.pop_back();
+
+	size_t index;
+
+	{
+		buffer_pool::page_guard parent = fetch_page(parent_id);
+		index = search(parent.data(), separator, true);
+
+		if (insert_cell(parent.data(), index, separator, right))
+		{
+			parent.mark_dirty();
+			return;
+		}
+	}
+
+	insert_split(parent_id, index, separator, right, path);
+}
+
+#pragma endregion paged index utility functions implementation
@@ -0,0 +1,380 @@
+#include <cerrno>
+#include <cstring>
+#include <ios>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../include/write_ahead_log.h"
+
+namespace
+{
+
+	// record frame starts with record size and checksum
+	size_t constexpr frame_header_size = 2 * sizeof(uint32_t);
+
+	void write_all(
+		int fd,
+		std::string const &bytes,
+		off_t pos)
+	{
+		for (size_t done = 0; done < bytes.size();)
+		{
+			ssize_t const result = pwrite(fd, bytes.data() + done, bytes.size() - done, pos + done);
+			if (result == -1)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+
+				throw std::ios::failure("Failed to write the log");
+			}
+
+			done += result;
+		}
+	}
+
+	std::string read_all(
+		int fd,
+		off_t size)
+	{
+		std::string bytes(size, '\0');
+
+		for (size_t done = 0; done < bytes.size();)
+		{
+			ssize_t const result = pread(fd, bytes.data() + done, bytes.size() - done, done);
+			if (result == 0)
+			{
+				bytes.resize(done);
+				break;
+			}
+
+			if (result == -1)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+
+				throw std::ios::failure("Failed to read the log");
+			}
+
+			done += result;
+		}
+
+		return bytes;
+	}
+
+}
+
+#pragma region write ahead log construction and destruction implementation
+
+write_ahead_log::write_ahead_log(
+	std::string const &path):
+		_fd(-1),
+		_file_size(0),
+		_appended_lsn(0),
+		_written_lsn(0),
+		_synced_lsn(0),
+		_reset_lsn(0),
+		_is_leader_active(false),
+		_policy(sync_policy::every_commit),
+		_sync_interval(10),
+		_is_stopped(false),
+		_statistics{}
+{
+	_fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+	if (_fd == -1)
+	{
+		throw std::ios::failure("Cannot open the log file");
+	}
+
+	try
+	{
+		off_t const file_size = lseek(_fd, 0, SEEK_END);
+		if (file_size == -1)
+		{
+			throw std::ios::failure("Cannot open the log file");
+		}
+
+		// records are appended past valid ones, so torn tail is cut off at once
+		size_t valid_size;
+		parse(read_all(_fd, file_size), valid_size);
+
+		if (static_cast<off_t>(valid_size) != file_size && ftruncate(_fd, valid_size) == -1)
+		{
+			throw std::ios::failure("Cannot open the log file");
+		}
+
+		_file_size = valid_size;
+		_appended_lsn = _written_lsn = _synced_lsn = valid_size;
+	}
+	catch (...)
+	{
+		close(_fd);
+		throw;
+	}
+}
+
+write_ahead_log::~write_ahead_log() noexcept
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_is_stopped = true;
+	}
+	_syncer_condition.notify_one();
+
+	if (_syncer.joinable())
+	{
+		_syncer.join();
+	}
+
+	try
+	{
+		sync();
+	}
+	catch (...)
+	{ }
+
+	close(_fd);
+}
+
+#pragma endregion write ahead log construction and destruction implementation
+
+#pragma region write ahead log operations implementation
+
+void write_ahead_log::set_sync_policy(
+	sync_policy policy,
+	std::chrono::milliseconds sync_interval)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		_policy = policy;
+		_sync_interval = sync_interval;
+
+		if (_policy == sync_policy::periodic && !_syncer.joinable())
+		{
+			_syncer = std::thread(&write_ahead_log::run_syncer, this);
+		}
+	}
+
+	_syncer_condition.notify_one();
+}
+
+uint64_t write_ahead_log::append(
+	std::string_view record)
+{
+	uint32_t const record_size = static_cast<uint32_t>(record.size());
+	uint32_t const record_checksum = checksum(record);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	_buffer.append(reinterpret_cast<char const *>(&record_size), sizeof(uint32_t));
+	_buffer.append(reinterpret_cast<char const *>(&record_checksum), sizeof(uint32_t));
+	_buffer.append(record);
+
+	_appended_lsn += frame_header_size + record.size();
+	++_statistics.records;
+
+	return _appended_lsn;
+}
+
+void write_ahead_log::commit(
+	uint64_t lsn)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+
+	switch (_policy)
+	{
+	case sync_policy::every_commit:
+		write_up_to(lock, lsn, true);
+		break;
+	case sync_policy::periodic:
+		if (_buffer.size() >= max_buffer_size)
+		{
+			write_up_to(lock, lsn, false);
+		}
+		break;
+	case sync_policy::never:
+		write_up_to(lock, lsn, false);
+		break;
+	}
+}
+
+void write_ahead_log::sync()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	write_up_to(lock, _appended_lsn, true);
+}
+
+void write_ahead_log::reset()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	_written_condition.wait(lock, [this]() { return !_is_leader_active; });
+
+	if (ftruncate(_fd, 0) == -1 || fdatasync(_fd) == -1)
+	{
+		throw std::ios::failure("Failed to reset the log");
+	}
+
+	_buffer.clear();
+	_file_size = 0;
+	_written_lsn = _synced_lsn = _reset_lsn = _appended_lsn;
+}
+
+std::vector<std::string> write_ahead_log::read()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	_written_condition.wait(lock, [this]() { return !_is_leader_active; });
+
+	size_t valid_size;
+	return parse(read_all(_fd, _file_size), valid_size);
+}
+
+size_t write_ahead_log::size()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _appended_lsn - _reset_lsn;
+}
+
+write_ahead_log::statistics write_ahead_log::get_statistics()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _statistics;
+}
+
+#pragma endregion write ahead log operations implementation
+
+#pragma region write ahead log utility functions implementation
+
+void write_ahead_log::write_up_to(
+	std::unique_lock<std::mutex> &lock,
+	uint64_t lsn,
+	bool is_synced)
+{
+	while ((is_synced ? _synced_lsn : _written_lsn) < lsn)
+	{
+		if (_is_leader_active)
+		{
+			_written_condition.wait(lock);
+			continue;
+		}
+
+		// records appended while leader writes go to the next batch
+		_is_leader_active = true;
+		std::string batch;
+		batch.swap(_buffer);
+		uint64_t const batch_end = _appended_lsn;
+		off_t const pos = _file_size;
+
+		lock.unlock();
+
+		try
+		{
+			write_all(_fd, batch, pos);
+
+			if (is_synced && fdatasync(_fd) == -1)
+			{
+				throw std::ios::failure("Failed to sync the log");
+			}
+		}
+		catch (...)
+		{
+			lock.lock();
+			_buffer.insert(0, batch);
+			_is_leader_active = false;
+			_written_condition.notify_all();
+			throw;
+		}
+
+		lock.lock();
+
+		_file_size += static_cast<off_t>(batch.size());
+		_written_lsn = batch_end;
+		if (is_synced)
+		{
+			_synced_lsn = batch_end;
+			++_statistics.syncs;
+		}
+		if (!batch.empty())
+		{
+			++_statistics.batches;
+		}
+
+		_is_leader_active = false;
+		_written_condition.notify_all();
+	}
+}
+
+void write_ahead_log::run_syncer()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+
+	while (!_is_stopped)
+	{
+		_syncer_condition.wait_for(lock, _sync_interval);
+
+		if (_policy != sync_policy::periodic || _synced_lsn >= _appended_lsn)
+		{
+			continue;
+		}
+
+		try
+		{
+			write_up_to(lock, _appended_lsn, true);
+		}
+		catch (std::ios::failure const &)
+		{
+			// records stay buffered and are written at next interval
+		}
+	}
+}
+
+std::vector<std::string> write_ahead_log::parse(
+	std::string_view bytes,
+	size_t &valid_size)
+{
+	std::vector<std::string> records;
+	size_t offset = 0;
+
+	while (bytes.size() - offset >= frame_header_size)
+	{
+		uint32_t record_size, record_checksum;
+		std::memcpy(&record_size, bytes.data() + offset, sizeof(uint32_t));
+		std::memcpy(&record_checksum, bytes.data() + offset + sizeof(uint32_t), sizeof(uint32_t));
+
+		if (bytes.size() - offset - frame_header_size < record_size)
+		{
+			break;
+		}
+
+		std::string_view const record = bytes.substr(offset + frame_header_size, record_size);
+		if (checksum(record) != record_checksum)
+		{
+			break;
+		}
+
+		records.emplace_back(record);
+		offset += frame_header_size + record_size;
+	}
+
+	valid_size = offset;
+	return records;
+}
+
+uint32_t write_ahead_log::checksum(
+	std::string_view bytes) noexcept
+{
+	// FNV-1a detects torn writes, log is not protected against deliberate changes
+	uint32_t hash = 2166136261u;
+
+	for (unsigned char byte : bytes)
+	{
+		hash = (hash ^ byte) * 16777619u;
+	}
+
+	return hash;
+}
+
+#pragma endregion write ahead log utility functions implementation
@@ -0,0 +1,262 @@
+#include <gtest/gtest.h>
+
+#include <buffer_pool.h>
+
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+
+	size_t constexpr frame_size = buffer_pool::frame_size;
+
+	// file of given pages count, every byte of page holds its number
+	class pool_file final
+	{
+
+	private:
+
+		std::string _path;
+		int _fd;
+
+	public:
+
+		explicit pool_file(
+			size_t pages_cnt):
+				_path((std::filesystem::temp_directory_path() /
+					("os_cw_buffer_pool_" + std::to_string(getpid()))).string()),
+				_fd(open(_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0666))
+		{
+			std::vector<unsigned char> page(frame_size);
+
+			for (size_t i = 0; i < pages_cnt; ++i)
+			{
+				std::memset(page.data(), static_cast<int>(i), frame_size);
+				pwrite(_fd, page.data(), frame_size, static_cast<off_t>(i * frame_size));
+			}
+		}
+
+		~pool_file()
+		{
+			close(_fd);
+			std::remove(_path.c_str());
+		}
+
+	public:
+
+		int fd() const noexcept
+		{
+			return _fd;
+		}
+
+		unsigned char byte_at(
+			off_t pos) const
+		{
+			unsigned char byte = 0;
+			pread(_fd, &byte, 1, pos);
+
+			return byte;
+		}
+
+	};
+
+	unsigned char byte_of(
+		buffer_pool &pool,
+		int fd,
+		uint64_t page_no)
+	{
+		return pool.pin(fd, page_no).data()[0];
+	}
+
+}
+
+TEST(buffer_pool, clock_evicts_frame_without_reference_bit)
+{
+	pool_file file(buffer_pool::min_frames_cnt + 2);
+	buffer_pool pool(0);
+	pool.attach(file.fd());
+
+	ASSERT_EQ(pool.get_frames_cnt(), buffer_pool::min_frames_cnt);
+
+	for (uint64_t i = 0; i < buffer_pool::min_frames_cnt; ++i)
+	{
+		EXPECT_EQ(byte_of(pool, file.fd(), i), i);
+	}
+
+	// every frame is referenced, so the hand clears all bits and comes back to the first frame
+	EXPECT_EQ(byte_of(pool, file.fd(), buffer_pool::min_frames_cnt), buffer_pool::min_frames_cnt);
+
+	// page 1 gets its bit again, so page 2 is the next victim
+	EXPECT_EQ(byte_of(pool, file.fd(), 1), 1);
+	EXPECT_EQ(byte_of(pool, file.fd(), buffer_pool::min_frames_cnt + 1), buffer_pool::min_frames_cnt + 1);
+
+	buffer_pool::statistics statistics = pool.get_statistics();
+	EXPECT_EQ(statistics.misses, buffer_pool::min_frames_cnt + 2);
+	EXPECT_EQ(statistics.hits, 1);
+	EXPECT_EQ(statistics.evictions, 2);
+	EXPECT_EQ(statistics.write_backs, 0);
+
+	EXPECT_EQ(byte_of(pool, file.fd(), 1), 1);
+	EXPECT_EQ(pool.get_statistics().hits, 2);
+
+	byte_of(pool, file.fd(), 0);
+	byte_of(pool, file.fd(), 2);
+	statistics = pool.get_statistics();
+	EXPECT_EQ(statistics.misses, buffer_pool::min_frames_cnt + 4);
+	EXPECT_EQ(statistics.evictions, 4);
+}
+
+TEST(buffer_pool, pinned_frames_are_not_evicted)
+{
+	pool_file file(buffer_pool::min_frames_cnt + 1);
+	buffer_pool pool(0);
+	pool.attach(file.fd());
+
+	std::vector<buffer_pool::page_guard> guards;
+	for (uint64_t i = 0; i < buffer_pool::min_frames_cnt; ++i)
+	{
+		guards.push_back(pool.pin(file.fd(), i));
+	}
+
+	EXPECT_THROW(pool.pin(file.fd(), buffer_pool::min_frames_cnt), std::runtime_error);
+
+	guards.pop_back();
+	EXPECT_EQ(byte_of(pool, file.fd(), buffer_pool::min_frames_cnt), buffer_pool::min_frames_cnt);
+	EXPECT_EQ(guards.front().data()[0], 0);
+}
+
+TEST(buffer_pool, only_dirty_range_is_written_back)
+{
+	pool_file file(2);
+	buffer_pool pool(0);
+	pool.attach(file.fd());
+
+	std::string const bytes(10, 'x');
+	pool.write(file.fd(), bytes.data(), bytes.size(), frame_size + 100);
+
+	EXPECT_EQ(pool.get_dirty_frames_cnt(), 1);
+	EXPECT_EQ(file.byte_at(frame_size + 100), 1);
+
+	// bytes of page changed on disk meanwhile are not overwritten by clean part of frame
+	unsigned char const outside = 'o';
+	pwrite(file.fd(), &outside, 1, frame_size + 2000);
+
+	pool.flush(file.fd());
+
+	EXPECT_EQ(pool.get_dirty_frames_cnt(), 0);
+	EXPECT_EQ(pool.get_statistics().write_backs, 1);
+	EXPECT_EQ(file.byte_at(frame_size + 100), 'x');
+	EXPECT_EQ(file.byte_at(frame_size + 109), 'x');
+	EXPECT_EQ(file.byte_at(frame_size + 110), 1);
+	EXPECT_EQ(file.byte_at(frame_size + 2000), 'o');
+}
+
+TEST(buffer_pool, evicted_dirty_frames_are_written_back)
+{
+	size_t constexpr pages_cnt = buffer_pool::min_frames_cnt + 4;
+	pool_file file(0);
+	buffer_pool pool(0);
+	pool.attach(file.fd());
+
+	for (size_t i = 0; i < pages_cnt; ++i)
+	{
+		unsigned char const byte = static_cast<unsigned char>('a' + i);
+		pool.write(file.fd(), &byte, 1, static_cast<off_t>(i * frame_size));
+	}
+
+	EXPECT_EQ(pool.size(file.fd()), static_cast<off_t>((pages_cnt - 1) * frame_size + 1));
+	EXPECT_EQ(pool.get_statistics().evictions, 4);
+	EXPECT_EQ(pool.get_statistics().write_backs, 4);
+	EXPECT_EQ(pool.get_dirty_frames_cnt(), buffer_pool::min_frames_cnt);
+
+	pool.flush(file.fd());
+
+	EXPECT_EQ(pool.get_statistics().write_backs, pages_cnt);
+	EXPECT_EQ(pool.get_dirty_frames_cnt(), 0);
+
+	for (size_t i = 0; i < pages_cnt; ++i)
+	{
+		EXPECT_EQ(file.byte_at(static_cast<off_t>(i * frame_size)), 'a' + i);
+	}
+}
+
+TEST(buffer_pool, dirty_frames_of_retained_file_are_not_evicted)
+{
+	pool_file file(buffer_pool::min_frames_cnt + 1);
+	buffer_pool pool(0);
+	pool.attach(file.fd(), true);
+
+	for (size_t i = 0; i < buffer_pool::min_frames_cnt; ++i)
+	{
+		unsigned char const byte = 'r';
+		pool.write(file.fd(), &byte, 1, static_cast<off_t>(i * frame_size + i));
+	}
+
+	EXPECT_EQ(pool.get_dirty_frames_cnt(), buffer_pool::min_frames_cnt);
+	EXPECT_THROW(pool.pin(file.fd(), buffer_pool::min_frames_cnt), std::runtime_error);
+	EXPECT_EQ(pool.get_statistics().write_backs, 0);
+	EXPECT_EQ(file.byte_at(0), 0);
+
+	size_t visited_cnt = 0;
+	pool.visit_dirty(file.fd(), [&visited_cnt](off_t pos, unsigned char const *bytes, size_t count)
+	{
+		EXPECT_EQ(pos % frame_size, pos / frame_size);
+		EXPECT_EQ(count, 1);
+		EXPECT_EQ(bytes[0], 'r');
+		++visited_cnt;
+	});
+	EXPECT_EQ(visited_cnt, buffer_pool::min_frames_cnt);
+
+	pool.flush(file.fd());
+
+	EXPECT_EQ(pool.get_dirty_frames_cnt(), 0);
+	EXPECT_EQ(file.byte_at(frame_size + 1), 'r');
+	EXPECT_EQ(byte_of(pool, file.fd(), buffer_pool::min_frames_cnt), buffer_pool::min_frames_cnt);
+	EXPECT_EQ(pool.get_statistics().evictions, 1);
+}
+
+TEST(buffer_pool, resize_writes_back_and_refuses_pinned_frames)
+{
+	pool_file file(1);
+	buffer_pool pool(0);
+	pool.attach(file.fd());
+
+	unsigned char const byte = 'z';
+	pool.write(file.fd(), &byte, 1, 0);
+
+	{
+		buffer_pool::page_guard guard = pool.pin(file.fd(), 0);
+		EXPECT_THROW(pool.resize(64 * frame_size), std::logic_error);
+	}
+
+	pool.resize(64 * frame_size);
+
+	EXPECT_EQ(pool.get_frames_cnt(), 64);
+	EXPECT_EQ(pool.get_dirty_frames_cnt(), 0);
+	EXPECT_EQ(file.byte_at(0), 'z');
+	EXPECT_EQ(byte_of(pool, file.fd(), 0), 'z');
+}
+
+TEST(buffer_pool, detach_drops_dirty_frames)
+{
+	pool_file file(1);
+	buffer_pool pool(0);
+	pool.attach(file.fd());
+
+	unsigned char const byte = 'd';
+	pool.write(file.fd(), &byte, 1, 0);
+	pool.detach(file.fd());
+
+	EXPECT_EQ(pool.get_dirty_frames_cnt(), 0);
+	EXPECT_EQ(file.byte_at(0), 0);
+
+	pool.attach(file.fd());
+	EXPECT_EQ(byte_of(pool, file.fd(), 0), 0);
+	pool.flush(file.fd());
+	EXPECT_EQ(pool.get_statistics().write_backs, 0);
+}
@@ -0,0 +1,373 @@
+#include <gtest/gtest.h>
+
+#include <db_storage.h>
+#include <flyweight.h>
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+
+	std::string const pool_name = "pool";
+	std::string const schema_name = "schema";
+	std::string const collection_name = "collection";
+
+	std::string const data_path = "pools/pool/schema/collection/1";
+	std::string const log_path = "pools/1.wal";
+
+	enum class operation_kind
+	{
+		addition,
+		update,
+		disposal
+	};
+
+	struct operation final
+	{
+		operation_kind kind;
+		size_t number;
+		uint64_t personal_id;
+		std::string name;
+	};
+
+	tkey key_of(
+		size_t number)
+	{
+		return flyweight_factory::get_instance()->get_flyweight_instance("login" + std::to_string(number));
+	}
+
+	// records are added, updated, disposed and added again, so replay meets every kind of key state
+	std::vector<operation> operations_of(
+		size_t records_cnt)
+	{
+		std::vector<operation> operations;
+
+		for (size_t i = 0; i < records_cnt; ++i)
+		{
+			operations.push_back({ operation_kind::addition, i, i, "name" + std::to_string(i) });
+		}
+
+		for (size_t i = 0; i < records_cnt; i += 3)
+		{
+			operations.push_back({ operation_kind::update, i, i * 10, "updated" + std::to_string(i) });
+		}
+
+		for (size_t i = 1; i < records_cnt; i += 2)
+		{
+			operations.push_back({ operation_kind::disposal, i, 0, "" });
+		}
+
+		for (size_t i = 1; i < records_cnt; i += 4)
+		{
+			operations.push_back({ operation_kind::addition, i, i + 1, "added again" + std::to_string(i) });
+		}
+
+		return operations;
+	}
+
+	std::map<size_t, operation> expected_records_of(
+		std::vector<operation> const &operations)
+	{
+		std::map<size_t, operation> records;
+
+		for (auto const &target : operations)
+		{
+			if (target.kind == operation_kind::disposal)
+			{
+				records.erase(target.number);
+				continue;
+			}
+
+			records[target.number] = target;
+		}
+
+		return records;
+	}
+
+	db_storage *set_up_collection()
+	{
+		auto const tree_variant = db_storage::search_tree_variant::b;
+
+		return db_storage::get_instance()
+			->setup(1, db_storage::mode::file_system)
+			->add_pool(pool_name, tree_variant, 4)
+			->add_schema(pool_name, schema_name, tree_variant, 4)
+			->add_collection(pool_name, schema_name, collection_name, tree_variant,
+				db_storage::allocator_variant::global_heap, allocator_with_fit_mode::fit_mode::first_fit, 8);
+	}
+
+	void perform(
+		db_storage *db,
+		std::vector<operation> const &operations)
+	{
+		for (auto const &target : operations)
+		{
+			switch (target.kind)
+			{
+			case operation_kind::addition:
+				db->add(pool_name, schema_name, collection_name, key_of(target.number), tvalue(target.personal_id, target.name));
+				break;
+			case operation_kind::update:
+				db->update(pool_name, schema_name, collection_name, key_of(target.number), tvalue(target.personal_id, target.name));
+				break;
+			case operation_kind::disposal:
+				db->dispose(pool_name, schema_name, collection_name, key_of(target.number));
+				break;
+			}
+		}
+	}
+
+	// returns false with message on the first record loaded collection does not hold as expected
+	bool holds(
+		std::map<size_t, operation> const &expected,
+		size_t numbers_cnt)
+	{
+		db_storage *db = db_storage::get_instance()
+			->setup(1, db_storage::mode::file_system)
+			->load_db("pools");
+
+		if (db->get_collection_records_cnt(pool_name, schema_name, collection_name) != expected.size())
+		{
+			std::cerr << "records count is " << db->get_collection_records_cnt(pool_name, schema_name, collection_name) <<
+				" instead of " << expected.size() << std::endl;
+			return false;
+		}
+
+		for (size_t i = 0; i < numbers_cnt; ++i)
+		{
+			auto found = expected.find(i);
+
+			try
+			{
+				tvalue const value = db->obtain(pool_name, schema_name, collection_name, key_of(i));
+
+				if (found == expected.end() || value.personal_id != found->second.personal_id ||
+						value.name->get_data() != found->second.name)
+				{
+					std::cerr << "record " << i << " is not expected to be such" << std::endl;
+					return false;
+				}
+			}
+			catch (db_storage::obtaining_of_nonexistent_key_attempt_exception const &)
+			{
+				if (found != expected.end())
+				{
+					std::cerr << "record " << i << " is lost" << std::endl;
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	// storage is a singleton set up once, so every run of it goes to its own process; exit without consolidation
+	// stands for crash
+	int run_in_child(
+		std::string const &directory_path,
+		std::function<bool()> const &body)
+	{
+		pid_t const pid = fork();
+		if (pid == 0)
+		{
+			int status = 1;
+
+			try
+			{
+				if (chdir(directory_path.c_str()) == 0 && body())
+				{
+					status = 0;
+				}
+			}
+			catch (std::exception const &error)
+			{
+				std::cerr << error.what() << std::endl;
+			}
+
+			_exit(status);
+		}
+
+		int status;
+		waitpid(pid, &status, 0);
+
+		return WIFEXITED(status)
+			? WEXITSTATUS(status)
+			: -1;
+	}
+
+	// data file descriptor is replaced with one of device, which cannot be synced
+	bool break_data_file_sync()
+	{
+		std::filesystem::path const target = std::filesystem::canonical(data_path);
+
+		for (auto const &entry : std::filesystem::directory_iterator("/proc/self/fd"))
+		{
+			std::error_code error;
+			if (std::filesystem::read_symlink(entry.path(), error) != target)
+			{
+				continue;
+			}
+
+			int const device_fd = open("/dev/null", O_RDWR | O_CLOEXEC);
+			return device_fd != -1 && dup2(device_fd, std::stoi(entry.path().filename().string())) != -1;
+		}
+
+		return false;
+	}
+
+	class db_storage_recovery_test:
+		public testing::Test
+	{
+
+	protected:
+
+		static size_t constexpr records_cnt = 500;
+
+		std::string const _directory_path = (std::filesystem::temp_directory_path() /
+			("os_cw_db_storage_recovery_" + std::to_string(getpid()))).string();
+
+		std::vector<operation> const _operations = operations_of(records_cnt);
+
+	protected:
+
+		void SetUp() override
+		{
+			std::filesystem::remove_all(_directory_path);
+			std::filesystem::create_directories(_directory_path);
+		}
+
+		void TearDown() override
+		{
+			std::filesystem::remove_all(_directory_path);
+		}
+
+	protected:
+
+		void expect_recovered(
+			std::map<size_t, operation> const &expected)
+		{
+			// second load meets files consolidated by the first one
+			EXPECT_EQ(run_in_child(_directory_path, [&expected]() { return holds(expected, records_cnt + 1); }), 0);
+			EXPECT_EQ(run_in_child(_directory_path, [&expected]() { return holds(expected, records_cnt + 1); }), 0);
+		}
+
+	};
+
+	class db_storage_sync_policy_test:
+		public db_storage_recovery_test,
+		public testing::WithParamInterface<write_ahead_log::sync_policy>
+	{ };
+
+}
+
+TEST_F(db_storage_recovery_test, replay_over_files_reflecting_operations_changes_nothing)
+{
+	ASSERT_EQ(run_in_child(_directory_path, [this]()
+	{
+		db_storage *db = set_up_collection();
+		perform(db, _operations);
+
+		// log emptied by checkpoint is brought back, as if crash came before it was emptied
+		std::filesystem::copy_file(log_path, "log.copy");
+		db->checkpoint();
+		std::filesystem::copy_file("log.copy", log_path, std::filesystem::copy_options::overwrite_existing);
+
+		return std::filesystem::file_size(log_path) != 0;
+	}), 0);
+
+	expect_recovered(expected_records_of(_operations));
+}
+
+TEST_F(db_storage_recovery_test, crash_between_checkpoint_record_and_write_back_is_redone)
+{
+	ASSERT_EQ(run_in_child(_directory_path, [this]()
+	{
+		db_storage *db = set_up_collection();
+		perform(db, _operations);
+
+		if (!break_data_file_sync())
+		{
+			return false;
+		}
+
+		try
+		{
+			db->checkpoint();
+			return false;
+		}
+		catch (std::ios::failure const &)
+		{ }
+
+		// index pages are torn as if crash came in the middle of their write back
+		int const fd = open((data_path + ".index").c_str(), O_WRONLY | O_CLOEXEC);
+		std::string const zeroes(buffer_pool::frame_size, '\0');
+
+		return fd != -1 && pwrite(fd, zeroes.data(), zeroes.size(), 0) == static_cast<ssize_t>(zeroes.size());
+	}), 0);
+
+	expect_recovered(expected_records_of(_operations));
+}
+
+TEST_F(db_storage_recovery_test, torn_last_record_loses_only_its_operation)
+{
+	ASSERT_EQ(run_in_child(_directory_path, [this]()
+	{
+		db_storage *db = set_up_collection();
+		perform(db, _operations);
+		perform(db, {{ operation_kind::addition, records_cnt, 0, "torn" }});
+
+		std::filesystem::resize_file(log_path, std::filesystem::file_size(log_path) - 1);
+
+		return true;
+	}), 0);
+
+	expect_recovered(expected_records_of(_operations));
+}
+
+TEST_P(db_storage_sync_policy_test, committed_operations_survive_crash)
+{
+	write_ahead_log::sync_policy const policy = GetParam();
+
+	ASSERT_EQ(run_in_child(_directory_path, [this, policy]()
+	{
+		db_storage::get_instance()->set_log_sync_policy(policy, std::chrono::milliseconds(5));
+		db_storage *db = set_up_collection();
+		perform(db, _operations);
+
+		// periodically synced records are lost if crash comes before the syncer runs
+		if (policy == write_ahead_log::sync_policy::periodic)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		}
+
+		write_ahead_log::statistics const statistics = db->get_log_statistics();
+		if (statistics.records != _operations.size())
+		{
+			return false;
+		}
+
+		return policy == write_ahead_log::sync_policy::every_commit
+			? statistics.syncs == statistics.records
+			: statistics.syncs < statistics.records;
+	}), 0);
+
+	expect_recovered(expected_records_of(_operations));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+	policies,
+	db_storage_sync_policy_test,
+	testing::Values(
+		write_ahead_log::sync_policy::every_commit,
+		write_ahead_log::sync_policy::periodic,
+		write_ahead_log::sync_policy::never));
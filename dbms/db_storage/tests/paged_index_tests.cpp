@@ -0,0 +1,286 @@
+#include <gtest/gtest.h>
+
+#include <paged_index.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <ios>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+
+	std::string index_path()
+	{
+		return (std::filesystem::temp_directory_path() / ("os_cw_paged_index_" + std::to_string(getpid()))).string();
+	}
+
+	// keys of varying length, so pages split at different counts of entries
+	std::string key_of(
+		size_t number)
+	{
+		return "key" + std::to_string(number) + std::string(number % 97, '#');
+	}
+
+	void expect_same(
+		paged_index &index,
+		std::map<std::string, long> const &expected)
+	{
+		ASSERT_EQ(index.size(), expected.size());
+
+		auto cursor = index.begin();
+		std::string key;
+		long file_pos;
+
+		for (auto const &[expected_key, expected_file_pos] : expected)
+		{
+			ASSERT_TRUE(cursor.fetch(key, file_pos));
+			ASSERT_EQ(key, expected_key);
+			ASSERT_EQ(file_pos, expected_file_pos);
+		}
+		EXPECT_FALSE(cursor.fetch(key, file_pos));
+
+		if (expected.empty())
+		{
+			EXPECT_FALSE(index.obtain_last(key, file_pos));
+			return;
+		}
+
+		ASSERT_TRUE(index.obtain_last(key, file_pos));
+		EXPECT_EQ(key, expected.rbegin()->first);
+		EXPECT_EQ(file_pos, expected.rbegin()->second);
+	}
+
+	void expect_seek(
+		paged_index &index,
+		std::map<std::string, long> const &expected,
+		std::string const &key,
+		bool is_inclusive)
+	{
+		auto found = is_inclusive
+			? expected.lower_bound(key)
+			: expected.upper_bound(key);
+		auto cursor = index.seek(key, is_inclusive);
+		std::string fetched_key;
+		long file_pos;
+
+		if (found == expected.end())
+		{
+			EXPECT_FALSE(cursor.fetch(fetched_key, file_pos)) << key;
+			return;
+		}
+
+		ASSERT_TRUE(cursor.fetch(fetched_key, file_pos)) << key;
+		EXPECT_EQ(fetched_key, found->first);
+		EXPECT_EQ(file_pos, found->second);
+	}
+
+	class paged_index_test:
+		public testing::Test
+	{
+
+	protected:
+
+		std::string const _path = index_path();
+
+	protected:
+
+		void TearDown() override
+		{
+			std::remove(_path.c_str());
+		}
+
+	};
+
+}
+
+TEST_F(paged_index_test, random_operations_match_map)
+{
+	std::map<std::string, long> expected;
+	std::mt19937 random(2024);
+	buffer_pool pool(0);
+
+	{
+		paged_index index(_path, pool, true);
+
+		for (long i = 0; i < 30000; ++i)
+		{
+			std::string const key = key_of(random() % 5000);
+
+			switch (random() % 4)
+			{
+			case 0:
+			case 1:
+				ASSERT_EQ(index.insert(key, i), expected.emplace(key, i).second);
+				break;
+			case 2:
+			{
+				auto found = expected.find(key);
+				std::optional<long> previous = index.update(key, i);
+
+				ASSERT_EQ(previous.has_value(), found != expected.end());
+				if (found != expected.end())
+				{
+					ASSERT_EQ(*previous, found->second);
+					found->second = i;
+				}
+				break;
+			}
+			default:
+			{
+				auto found = expected.find(key);
+				std::optional<long> disposed = index.dispose(key);
+
+				ASSERT_EQ(disposed.has_value(), found != expected.end());
+				if (found != expected.end())
+				{
+					ASSERT_EQ(*disposed, found->second);
+					expected.erase(found);
+				}
+				break;
+			}
+			}
+		}
+
+		for (size_t i = 0; i < 5000; i += 7)
+		{
+			std::optional<long> file_pos = index.obtain(key_of(i));
+			auto found = expected.find(key_of(i));
+
+			ASSERT_EQ(file_pos.has_value(), found != expected.end());
+			if (file_pos)
+			{
+				EXPECT_EQ(*file_pos, found->second);
+			}
+
+			expect_seek(index, expected, key_of(i), true);
+			expect_seek(index, expected, key_of(i), false);
+		}
+		expect_seek(index, expected, "", true);
+		expect_seek(index, expected, "zzz", true);
+
+		expect_same(index, expected);
+		EXPECT_GT(pool.get_statistics().evictions, 0);
+	}
+
+	// every operation of index that is not retained reaches the file
+	buffer_pool reopened_pool(0);
+	paged_index reopened(_path, reopened_pool);
+	expect_same(reopened, expected);
+}
+
+TEST_F(paged_index_test, retained_index_survives_reopening_once_written_back)
+{
+	std::map<std::string, long> expected;
+	buffer_pool pool(1 << 22);
+
+	{
+		paged_index index(_path, pool, true, true);
+		size_t const initial_write_backs = pool.get_statistics().write_backs;
+
+		for (long i = 0; i < 3000; ++i)
+		{
+			index.insert(key_of(i), i);
+			expected.emplace(key_of(i), i);
+		}
+
+		size_t dirty_bytes = 0;
+		index.visit_dirty([&dirty_bytes](off_t, unsigned char const *, size_t count) { dirty_bytes += count; });
+		EXPECT_GT(dirty_bytes, 0);
+		EXPECT_EQ(pool.get_statistics().write_backs, initial_write_backs);
+
+		index.write_back();
+		EXPECT_EQ(pool.get_dirty_frames_cnt(), 0);
+	}
+
+	buffer_pool reopened_pool(0);
+	paged_index reopened(_path, reopened_pool);
+	expect_same(reopened, expected);
+}
+
+TEST_F(paged_index_test, bulk_loaded_index_skips_emptied_leaves)
+{
+	std::map<std::string, long> expected;
+	buffer_pool pool(0);
+	paged_index index(_path, pool, true);
+
+	{
+		paged_index::bulk_loader loader(index);
+
+		for (long i = 0; i < 10000; ++i)
+		{
+			std::string const key = "key" + std::to_string(100000 + i);
+			loader.append(key, i);
+			expected.emplace(key, i);
+		}
+
+		EXPECT_THROW(loader.append("key0", 0), std::invalid_argument);
+		loader.finish();
+	}
+
+	EXPECT_THROW(paged_index::bulk_loader loader(index), std::logic_error);
+	expect_same(index, expected);
+
+	// whole leaves are emptied, cursor steps over them to the next one holding entries
+	for (long i = 1000; i < 5000; ++i)
+	{
+		std::string const key = "key" + std::to_string(100000 + i);
+		ASSERT_EQ(index.dispose(key), i);
+		expected.erase(key);
+	}
+
+	expect_seek(index, expected, "key101500", true);
+	expect_seek(index, expected, "key100999", false);
+	expect_same(index, expected);
+
+	EXPECT_TRUE(index.insert("key103000", -1));
+	expected.emplace("key103000", -1);
+	expect_same(index, expected);
+}
+
+TEST_F(paged_index_test, oversized_key_is_rejected)
+{
+	buffer_pool pool(0);
+	paged_index index(_path, pool, true);
+
+	EXPECT_THROW(index.insert(std::string(paged_index::max_key_size + 1, 'k'), 0), std::length_error);
+	EXPECT_TRUE(index.insert(std::string(paged_index::max_key_size, 'k'), 0));
+}
+
+TEST_F(paged_index_test, invalid_meta_page_is_rejected)
+{
+	buffer_pool pool(0);
+
+	{
+		paged_index index(_path, pool, true);
+		index.insert("key", 1);
+	}
+
+	int const fd = open(_path.c_str(), O_RDWR | O_CLOEXEC);
+	ASSERT_NE(fd, -1);
+
+	// magic takes the first 8 bytes of meta page, page size the next 4
+	uint64_t magic;
+	ASSERT_EQ(pread(fd, &magic, sizeof(magic), 0), static_cast<ssize_t>(sizeof(magic)));
+
+	uint64_t const wrong_magic = magic ^ 1;
+	pwrite(fd, &wrong_magic, sizeof(wrong_magic), 0);
+	EXPECT_THROW(paged_index index(_path, pool), std::ios::failure);
+
+	pwrite(fd, &magic, sizeof(magic), 0);
+	uint32_t const wrong_page_size = paged_index::page_size / 2;
+	pwrite(fd, &wrong_page_size, sizeof(wrong_page_size), sizeof(magic));
+	EXPECT_THROW(paged_index index(_path, pool), std::ios::failure);
+
+	uint32_t const page_size = paged_index::page_size;
+	pwrite(fd, &page_size, sizeof(page_size), sizeof(magic));
+	close(fd);
+
+	paged_index index(_path, pool);
+	EXPECT_EQ(index.obtain("key"), 1);
+}
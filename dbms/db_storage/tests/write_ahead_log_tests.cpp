@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+
+#include <write_ahead_log.h>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+namespace
+{
+
+	// record frame starts with record size and checksum
+	size_t constexpr frame_header_size = 8;
+
+	class write_ahead_log_test:
+		public testing::Test
+	{
+
+	protected:
+
+		std::string const _path = (std::filesystem::temp_directory_path() /
+			("os_cw_write_ahead_log_" + std::to_string(getpid()))).string();
+
+	protected:
+
+		void SetUp() override
+		{
+			std::remove(_path.c_str());
+		}
+
+		void TearDown() override
+		{
+			std::remove(_path.c_str());
+		}
+
+	};
+
+}
+
+TEST_F(write_ahead_log_test, torn_last_record_is_cut_off)
+{
+	{
+		write_ahead_log log(_path);
+		log.commit(log.append("first"));
+		log.commit(log.append("second"));
+		log.commit(log.append("third"));
+	}
+
+	size_t const valid_size = 3 * frame_header_size + std::string("firstsecondthird").size();
+	ASSERT_EQ(std::filesystem::file_size(_path), valid_size);
+
+	// crash in the middle of the last record write leaves part of it
+	std::filesystem::resize_file(_path, valid_size - 2);
+
+	{
+		write_ahead_log log(_path);
+
+		EXPECT_EQ(log.read(), (std::vector<std::string>{ "first", "second" }));
+		EXPECT_EQ(std::filesystem::file_size(_path), valid_size - std::string("third").size() - frame_header_size);
+
+		log.commit(log.append("fourth"));
+		EXPECT_EQ(log.read(), (std::vector<std::string>{ "first", "second", "fourth" }));
+	}
+
+	// record of full size with bytes not written yet fails its checksum
+	{
+		FILE *file = std::fopen(_path.c_str(), "r+b");
+		ASSERT_NE(file, nullptr);
+		std::fseek(file, -1, SEEK_END);
+		std::fputc('?', file);
+		std::fclose(file);
+	}
+
+	write_ahead_log log(_path);
+	EXPECT_EQ(log.read(), (std::vector<std::string>{ "first", "second" }));
+}
+
+TEST_F(write_ahead_log_test, reset_drops_records)
+{
+	write_ahead_log log(_path);
+	log.commit(log.append("record"));
+
+	EXPECT_EQ(log.size(), frame_header_size + std::string("record").size());
+
+	log.reset();
+
+	EXPECT_EQ(log.size(), 0);
+	EXPECT_TRUE(log.read().empty());
+	EXPECT_EQ(std::filesystem::file_size(_path), 0);
+
+	log.commit(log.append("next"));
+	EXPECT_EQ(log.read(), std::vector<std::string>{ "next" });
+}
+
+TEST_F(write_ahead_log_test, every_commit_policy_syncs_before_return)
+{
+	write_ahead_log log(_path);
+
+	log.commit(log.append("record"));
+
+	write_ahead_log::statistics const statistics = log.get_statistics();
+	EXPECT_EQ(statistics.records, 1);
+	EXPECT_EQ(statistics.batches, 1);
+	EXPECT_EQ(statistics.syncs, 1);
+	EXPECT_EQ(log.read(), std::vector<std::string>{ "record" });
+}
+
+TEST_F(write_ahead_log_test, concurrent_commits_share_syncs)
+{
+	size_t constexpr writers_cnt = 8;
+	size_t constexpr records_cnt = 200;
+	write_ahead_log log(_path);
+	std::vector<std::thread> writers;
+
+	for (size_t writer = 0; writer < writers_cnt; ++writer)
+	{
+		writers.emplace_back([&log, writer]()
+		{
+			for (size_t i = 0; i < records_cnt; ++i)
+			{
+				log.commit(log.append(std::to_string(writer) + ':' + std::to_string(i)));
+			}
+		});
+	}
+
+	for (auto &writer : writers)
+	{
+		writer.join();
+	}
+
+	write_ahead_log::statistics const statistics = log.get_statistics();
+	EXPECT_EQ(statistics.records, writers_cnt * records_cnt);
+	EXPECT_LE(statistics.batches, statistics.records);
+	EXPECT_EQ(statistics.syncs, statistics.batches);
+
+	// records of every writer are kept in order they were appended
+	std::vector<size_t> next(writers_cnt, 0);
+	std::vector<std::string> const records = log.read();
+	ASSERT_EQ(records.size(), writers_cnt * records_cnt);
+
+	for (auto const &record : records)
+	{
+		size_t const separator = record.find(':');
+		size_t const writer = std::stoul(record.substr(0, separator));
+
+		ASSERT_LT(writer, writers_cnt);
+		EXPECT_EQ(std::stoul(record.substr(separator + 1)), next[writer]++);
+	}
+}
+
+TEST_F(write_ahead_log_test, periodic_policy_syncs_in_background)
+{
+	write_ahead_log log(_path);
+	log.set_sync_policy(write_ahead_log::sync_policy::periodic, std::chrono::hours(1));
+
+	log.commit(log.append("buffered"));
+
+	EXPECT_TRUE(log.read().empty());
+	EXPECT_EQ(log.get_statistics().syncs, 0);
+
+	log.sync();
+	EXPECT_EQ(log.read(), std::vector<std::string>{ "buffered" });
+	EXPECT_EQ(log.get_statistics().syncs, 1);
+
+	log.set_sync_policy(write_ahead_log::sync_policy::periodic, std::chrono::milliseconds(5));
+	log.commit(log.append("synced"));
+
+	auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (log.get_statistics().syncs < 2 && std::chrono::steady_clock::now() < deadline)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	EXPECT_GE(log.get_statistics().syncs, 2);
+	EXPECT_EQ(log.read(), (std::vector<std::string>{ "buffered", "synced" }));
+}
+
+TEST_F(write_ahead_log_test, periodic_policy_writes_full_buffer_on_commit)
+{
+	write_ahead_log log(_path);
+	log.set_sync_policy(write_ahead_log::sync_policy::periodic, std::chrono::hours(1));
+
+	std::string const record(1 << 16, 'r');
+	size_t records_cnt = 0;
+
+	for (size_t appended = 0; appended < (1 << 20); appended += record.size())
+	{
+		log.commit(log.append(record));
+		++records_cnt;
+	}
+
+	EXPECT_EQ(log.read().size(), records_cnt);
+	EXPECT_EQ(log.get_statistics().syncs, 0);
+}
+
+TEST_F(write_ahead_log_test, never_policy_writes_without_sync)
+{
+	write_ahead_log log(_path);
+	log.set_sync_policy(write_ahead_log::sync_policy::never, std::chrono::milliseconds(10));
+
+	log.commit(log.append("first"));
+	log.commit(log.append("second"));
+
+	write_ahead_log::statistics const statistics = log.get_statistics();
+	EXPECT_EQ(statistics.batches, 2);
+	EXPECT_EQ(statistics.syncs, 0);
+	EXPECT_EQ(log.read(), (std::vector<std::string>{ "first", "second" }));
+}
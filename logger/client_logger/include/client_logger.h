@@ -23,6 +23,9 @@ private:
     std::string _format_string;
     std::map<std::string, std::pair<std::ostream *, std::set<logger::severity>>> _streams;
 
+    // bit per severity logged by any stream
+    unsigned _enabled_severities;
+
 private:
 
     client_logger(
@@ -51,7 +54,15 @@ public:
         std::string const &message,
         logger::severity severity) const noexcept override;
 
+    [[nodiscard]] bool is_enabled_for(
+        logger::severity severity) const noexcept override;
+
 private:
+
+    static unsigned severity_bit(
+        logger::severity severity) noexcept;
+
+    void refresh_enabled_severities() noexcept;
     
     void decrement_stream_users(std::string const &file_path) const noexcept;
 
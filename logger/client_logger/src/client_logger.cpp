@@ -54,12 +54,15 @@ client_logger::client_logger(
         _streams[file_path] = std::make_pair(_all_streams[file_path].first, severities);
         _all_streams[file_path].second++;
     }
+    
+    refresh_enabled_severities();
 }
 
 client_logger::client_logger(
     client_logger const &other):
     _format_string(other._format_string),
-    _streams(other._streams)
+    _streams(other._streams),
+    _enabled_severities(other._enabled_severities)
 {
     for (auto record : _streams)
     {
@@ -82,6 +85,7 @@ client_logger &client_logger::operator=(
     
     _format_string = other._format_string;
     _streams = other._streams;
+    _enabled_severities = other._enabled_severities;
     
     for (auto record : _streams)
     {
@@ -94,8 +98,11 @@ client_logger &client_logger::operator=(
 client_logger::client_logger(
     client_logger &&other) noexcept:
     _format_string(std::move(other._format_string)),
-    _streams(std::move(other._streams))
-{ }
+    _streams(std::move(other._streams)),
+    _enabled_severities(other._enabled_severities)
+{
+    other._enabled_severities = 0;
+}
 
 client_logger &client_logger::operator=(
     client_logger &&other) noexcept
@@ -112,6 +119,8 @@ client_logger &client_logger::operator=(
     
     _format_string = std::move(other._format_string);
     _streams = std::move(other._streams);
+    _enabled_severities = other._enabled_severities;
+    other._enabled_severities = 0;
     
     return *this;
 }
@@ -178,6 +187,31 @@ logger const *client_logger::log(
     return this;
 }
 
+bool client_logger::is_enabled_for(
+    logger::severity severity) const noexcept
+{
+    return (_enabled_severities & severity_bit(severity)) != 0;
+}
+
+unsigned client_logger::severity_bit(
+    logger::severity severity) noexcept
+{
+    return 1u << static_cast<unsigned>(severity);
+}
+
+void client_logger::refresh_enabled_severities() noexcept
+{
+    _enabled_severities = 0;
+    
+    for (auto const &record : _streams)
+    {
+        for (auto severity : record.second.second)
+        {
+            _enabled_severities |= severity_bit(severity);
+        }
+    }
+}
+
 void client_logger::decrement_stream_users(std::string const &file_path) const noexcept
 {
     if (file_path.size() == 0)
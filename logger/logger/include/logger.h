@@ -28,6 +28,10 @@ public:
         std::string const &message,
         logger::severity severity) const noexcept = 0;
 
+    // false if records of severity are dropped anyway, so their messages need not be formatted
+    [[nodiscard]] virtual bool is_enabled_for(
+        logger::severity severity) const noexcept;
+
 public:
 
     logger const *trace(
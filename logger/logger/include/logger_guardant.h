@@ -3,15 +3,28 @@
 
 #include "logger.h"
 
+#include <type_traits>
+#include <utility>
+
 class logger_guardant
 {
 
+private:
+
+    // message factory is a callable returning the message, invoked only if the record will be emitted
+    template<
+        typename tmessage_factory>
+    using enable_if_message_factory = std::enable_if_t<std::is_invocable_r_v<std::string, tmessage_factory>, int>;
+
 public:
 
     virtual ~logger_guardant() noexcept = default;
 
 public:
 
+    [[nodiscard]] bool is_enabled_with_guard(
+        logger::severity severity) const;
+
     logger_guardant const *log_with_guard(
         std::string const &message,
         logger::severity severity) const;
@@ -34,10 +47,125 @@ public:
     logger_guardant const *critical_with_guard(
         std::string const &message) const;
 
+public:
+
+    template<
+        typename tmessage_factory,
+        enable_if_message_factory<tmessage_factory> = 0>
+    logger_guardant const *log_with_guard(
+        tmessage_factory &&message_factory,
+        logger::severity severity) const;
+
+    template<
+        typename tmessage_factory,
+        enable_if_message_factory<tmessage_factory> = 0>
+    logger_guardant const *trace_with_guard(
+        tmessage_factory &&message_factory) const;
+
+    template<
+        typename tmessage_factory,
+        enable_if_message_factory<tmessage_factory> = 0>
+    logger_guardant const *debug_with_guard(
+        tmessage_factory &&message_factory) const;
+
+    template<
+        typename tmessage_factory,
+        enable_if_message_factory<tmessage_factory> = 0>
+    logger_guardant const *information_with_guard(
+        tmessage_factory &&message_factory) const;
+
+    template<
+        typename tmessage_factory,
+        enable_if_message_factory<tmessage_factory> = 0>
+    logger_guardant const *warning_with_guard(
+        tmessage_factory &&message_factory) const;
+
+    template<
+        typename tmessage_factory,
+        enable_if_message_factory<tmessage_factory> = 0>
+    logger_guardant const *error_with_guard(
+        tmessage_factory &&message_factory) const;
+
+    template<
+        typename tmessage_factory,
+        enable_if_message_factory<tmessage_factory> = 0>
+    logger_guardant const *critical_with_guard(
+        tmessage_factory &&message_factory) const;
+
 protected:
 
     inline virtual logger *get_logger() const = 0;
 
 };
 
+template<
+    typename tmessage_factory,
+    logger_guardant::enable_if_message_factory<tmessage_factory>>
+logger_guardant const *logger_guardant::log_with_guard(
+    tmessage_factory &&message_factory,
+    logger::severity severity) const
+{
+    logger *got_logger = get_logger();
+    if (got_logger != nullptr && got_logger->is_enabled_for(severity))
+    {
+        got_logger->log(std::forward<tmessage_factory>(message_factory)(), severity);
+    }
+
+    return this;
+}
+
+template<
+    typename tmessage_factory,
+    logger_guardant::enable_if_message_factory<tmessage_factory>>
+logger_guardant const *logger_guardant::trace_with_guard(
+    tmessage_factory &&message_factory) const
+{
+    return log_with_guard(std::forward<tmessage_factory>(message_factory), logger::severity::trace);
+}
+
+template<
+    typename tmessage_factory,
+    logger_guardant::enable_if_message_factory<tmessage_factory>>
+logger_guardant const *logger_guardant::debug_with_guard(
+    tmessage_factory &&message_factory) const
+{
+    return log_with_guard(std::forward<tmessage_factory>(message_factory), logger::severity::debug);
+}
+
+template<
+    typename tmessage_factory,
+    logger_guardant::enable_if_message_factory<tmessage_factory>>
+logger_guardant const *logger_guardant::information_with_guard(
+    tmessage_factory &&message_factory) const
+{
+    return log_with_guard(std::forward<tmessage_factory>(message_factory), logger::severity::information);
+}
+
+template<
+    typename tmessage_factory,
+    logger_guardant::enable_if_message_factory<tmessage_factory>>
+logger_guardant const *logger_guardant::warning_with_guard(
+    tmessage_factory &&message_factory) const
+{
+    return log_with_guard(std::forward<tmessage_factory>(message_factory), logger::severity::warning);
+}
+
+template<
+    typename tmessage_factory,
+    logger_guardant::enable_if_message_factory<tmessage_factory>>
+logger_guardant const *logger_guardant::error_with_guard(
+    tmessage_factory &&message_factory) const
+{
+    return log_with_guard(std::forward<tmessage_factory>(message_factory), logger::severity::error);
+}
+
+template<
+    typename tmessage_factory,
+    logger_guardant::enable_if_message_factory<tmessage_factory>>
+logger_guardant const *logger_guardant::critical_with_guard(
+    tmessage_factory &&message_factory) const
+{
+    return log_with_guard(std::forward<tmessage_factory>(message_factory), logger::severity::critical);
+}
+
 #endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_LOGGER_GUARDANT_H
\ No newline at end of file
@@ -1,11 +1,19 @@
 #include "../include/logger_guardant.h"
 
+bool logger_guardant::is_enabled_with_guard(
+    logger::severity severity) const
+{
+    logger *got_logger = get_logger();
+    
+    return got_logger != nullptr && got_logger->is_enabled_for(severity);
+}
+
 logger_guardant const *logger_guardant::log_with_guard(
     std::string const &message,
     logger::severity severity) const
 {
     logger *got_logger = get_logger();
-    if (got_logger != nullptr)
+    if (got_logger != nullptr && got_logger->is_enabled_for(severity))
     {
         got_logger->log(message, severity);
     }
@@ -78,6 +78,9 @@ public:
         const std::string &message,
         logger::severity severity) const noexcept override;
 
+    [[nodiscard]] bool is_enabled_for(
+        logger::severity severity) const noexcept override;
+
 };
 
 #endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_SERVER_LOGGER_H
\ No newline at end of file
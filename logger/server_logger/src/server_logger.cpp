@@ -20,6 +20,20 @@ server_logger::server_logger(std::map<std::string, std::set<severity>> const &lo
 	// }
 }
 
+bool server_logger::is_enabled_for(
+    logger::severity severity) const noexcept
+{
+    for (auto const &record : _configuration)
+    {
+        if (record.second.count(severity))
+        {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
 logger const *server_logger::log(
     const std::string &text,
     logger::severity severity) const noexcept